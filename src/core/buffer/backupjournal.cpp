@@ -0,0 +1,148 @@
+#include "backupjournal.h"
+
+#include <QFile>
+#include <QStringList>
+
+#include <utils/fileutils.h>
+#include "exception.h"
+
+using namespace vnotex;
+
+// Records:
+// B <length>\n<base content>\n
+// D <position> <removed length> <inserted length>\n<inserted text>\n
+// Positions and lengths are in QChar.
+const QString BackupJournal::c_journalMark = QStringLiteral("vnotex_backup_journal");
+
+// Compact the journal only when deltas exceed this size at least.
+static const qint64 c_minCompactionBytes = 64 * 1024;
+
+BackupJournal::BackupJournal(const QString &p_filePath, const QString &p_head)
+    : m_filePath(p_filePath),
+      m_head(p_head)
+{
+}
+
+const QString &BackupJournal::getFilePath() const
+{
+    return m_filePath;
+}
+
+void BackupJournal::write(const QString &p_content)
+{
+    if (m_baseBytes == -1 || m_deltaBytes > qMax(c_minCompactionBytes, m_baseBytes)) {
+        writeBase(p_content);
+    } else {
+        appendDelta(p_content);
+    }
+}
+
+void BackupJournal::writeBase(const QString &p_content)
+{
+    const auto base = QString("B %1\n").arg(p_content.size()) + p_content + QLatin1Char('\n');
+    const auto data = (m_head + c_journalMark + QLatin1Char('\n') + base).toUtf8();
+
+    FileUtils::writeFileAtomically(m_filePath, data);
+
+    m_content = p_content;
+    m_baseBytes = data.size();
+    m_deltaBytes = 0;
+}
+
+void BackupJournal::appendDelta(const QString &p_content)
+{
+    const int oldSize = m_content.size();
+    const int newSize = p_content.size();
+    const int minSize = qMin(oldSize, newSize);
+
+    int prefix = 0;
+    while (prefix < minSize && m_content[prefix] == p_content[prefix]) {
+        ++prefix;
+    }
+    // Do not split a surrogate pair.
+    if (prefix > 0 && m_content[prefix - 1].isHighSurrogate()) {
+        --prefix;
+    }
+
+    int suffix = 0;
+    while (suffix < minSize - prefix
+           && m_content[oldSize - 1 - suffix] == p_content[newSize - 1 - suffix]) {
+        ++suffix;
+    }
+    if (suffix > 0 && p_content[newSize - suffix].isLowSurrogate()) {
+        --suffix;
+    }
+
+    const int removed = oldSize - prefix - suffix;
+    const int inserted = newSize - prefix - suffix;
+    if (removed == 0 && inserted == 0) {
+        return;
+    }
+
+    const auto record = QString("D %1 %2 %3\n").arg(QString::number(prefix),
+                                                     QString::number(removed),
+                                                     QString::number(inserted))
+                        + p_content.mid(prefix, inserted)
+                        + QLatin1Char('\n');
+    const auto data = record.toUtf8();
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)
+        || file.write(data) != data.size()) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to append to backup file: %1").arg(m_filePath));
+    }
+    file.close();
+
+    m_content = p_content;
+    m_deltaBytes += data.size();
+}
+
+bool BackupJournal::isJournal(const QString &p_data)
+{
+    return p_data.startsWith(c_journalMark + QLatin1Char('\n'));
+}
+
+QString BackupJournal::replay(const QString &p_data)
+{
+    Q_ASSERT(isJournal(p_data));
+
+    QString content;
+    int idx = c_journalMark.size() + 1;
+    while (idx < p_data.size()) {
+        const int eol = p_data.indexOf(QLatin1Char('\n'), idx);
+        if (eol == -1) {
+            break;
+        }
+
+        const auto fields = p_data.mid(idx, eol - idx).split(QLatin1Char(' '));
+        idx = eol + 1;
+
+        if (fields[0] == QStringLiteral("B") && fields.size() == 2) {
+            const int len = fields[1].toInt();
+            if (len < 0 || idx + len > p_data.size()) {
+                break;
+            }
+
+            content = p_data.mid(idx, len);
+            idx += len + 1;
+        } else if (fields[0] == QStringLiteral("D") && fields.size() == 4) {
+            const int pos = fields[1].toInt();
+            const int removed = fields[2].toInt();
+            const int len = fields[3].toInt();
+            if (pos < 0 || removed < 0 || len < 0
+                || pos + removed > content.size()
+                || idx + len > p_data.size()) {
+                break;
+            }
+
+            content.replace(pos, removed, p_data.constData() + idx, len);
+            idx += len + 1;
+        } else {
+            // Truncated or corrupted record.
+            break;
+        }
+    }
+
+    return content;
+}
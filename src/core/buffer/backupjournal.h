@@ -0,0 +1,52 @@
+#ifndef BACKUPJOURNAL_H
+#define BACKUPJOURNAL_H
+
+#include <QString>
+
+namespace vnotex
+{
+    // Append-only backup file of a buffer.
+    // It contains a base content followed by edit deltas against it, so each
+    // write costs O(edit) I/O instead of rewriting the whole content.
+    // The file will be compacted into a new base when the deltas grow too large.
+    class BackupJournal
+    {
+    public:
+        // @p_head: head of the backup file to identify the buffer.
+        BackupJournal(const QString &p_filePath, const QString &p_head);
+
+        const QString &getFilePath() const;
+
+        // Record @p_content as the latest content.
+        void write(const QString &p_content);
+
+        // Whether @p_data, which is the content of the backup file after head, is a journal.
+        static bool isJournal(const QString &p_data);
+
+        // Replay journal @p_data to get the latest content.
+        // A truncated tail record due to crash will be ignored.
+        static QString replay(const QString &p_data);
+
+    private:
+        void writeBase(const QString &p_content);
+
+        void appendDelta(const QString &p_content);
+
+        QString m_filePath;
+
+        QString m_head;
+
+        // The content recorded by the journal.
+        QString m_content;
+
+        // Bytes of the base record. -1 if no base is written.
+        qint64 m_baseBytes = -1;
+
+        // Bytes of all the delta records.
+        qint64 m_deltaBytes = 0;
+
+        static const QString c_journalMark;
+    };
+} // ns vnotex
+
+#endif // BACKUPJOURNAL_H
@@ -1,6 +1,8 @@
 #include "buffer.h"
 
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QFileInfo>
 
 #include <notebook/node.h>
 #include <utils/fileutils.h>
@@ -9,12 +11,19 @@
 
 #include <core/configmgr.h>
 #include <core/editorconfig.h>
+#include <core/filewatcher.h>
 
 #include "bufferprovider.h"
+#include "backupjournal.h"
 #include "exception.h"
 
 using namespace vnotex;
 
+// Bounds of the content delta log.
+static const int c_maxContentDeltaCount = 256;
+
+static const int c_maxContentDeltasSize = 1024 * 1024;
+
 static vnotex::ID generateBufferID()
 {
     static vnotex::ID id = 0;
@@ -34,13 +43,21 @@ Buffer::Buffer(const BufferParameters &p_parameters,
     connect(m_autoSaveTimer, &QTimer::timeout,
             this, &Buffer::autoSave);
 
+    m_backgroundSaveWatcher = new QFutureWatcher<BufferSaveWorker::Result>(this);
+    connect(m_backgroundSaveWatcher, &QFutureWatcher<BufferSaveWorker::Result>::finished,
+            this, &Buffer::handleBackgroundSaveFinished);
+
     readContent();
 
     checkBackupFileOfPreviousSession();
+
+    watchContentFile();
 }
 
 Buffer::~Buffer()
 {
+    unwatchContentFile();
+
     Q_ASSERT(m_attachedViewWindowCount == 0);
     Q_ASSERT(!m_viewWindowToSync);
     Q_ASSERT(!isModified());
@@ -118,13 +135,25 @@ ID Buffer::getID() const
 const QString &Buffer::getContent() const
 {
     const_cast<Buffer *>(this)->syncContent();
-    return m_content;
+    if (!m_contentTextValid) {
+        m_contentText = m_content.toString();
+        m_contentTextValid = true;
+    }
+    return m_contentText;
+}
+
+void Buffer::setContentInternal(const QString &p_content)
+{
+    m_content = BufferContent(p_content);
+    m_contentText = p_content;
+    m_contentTextValid = true;
 }
 
 void Buffer::setContent(const QString &p_content, int &p_revision)
 {
     m_viewWindowToSync = nullptr;
-    m_content = p_content;
+    clearContentDeltas();
+    setContentInternal(p_content);
     p_revision = ++m_revision;
     setModified(true);
     m_autoSaveTimer->start();
@@ -142,6 +171,92 @@ void Buffer::invalidateContent(const ViewWindow *p_win,
     emit contentsChanged();
 }
 
+void Buffer::invalidateContent(const ViewWindow *p_win,
+                               const QVector<ContentEdit> &p_edits,
+                               int p_length,
+                               const std::function<void(int)> &p_setRevision)
+{
+    if (!m_contentDeltas.isEmpty() && m_contentDeltas.last().m_revision != m_revision) {
+        // Revisions in between are not logged.
+        clearContentDeltas();
+    }
+
+    ContentDelta delta;
+    delta.m_revision = m_revision + 1;
+    delta.m_edits = p_edits;
+    delta.m_length = p_length;
+
+    int size = 0;
+    for (const auto &edit : p_edits) {
+        size += edit.m_insertedText.size();
+    }
+
+    if (size > c_maxContentDeltasSize) {
+        // Cheaper to reload.
+        clearContentDeltas();
+    } else {
+        m_contentDeltas.push_back(delta);
+        m_contentDeltasSize += size;
+        while (m_contentDeltas.size() > c_maxContentDeltaCount
+               || m_contentDeltasSize > c_maxContentDeltasSize) {
+            for (const auto &edit : m_contentDeltas.first().m_edits) {
+                m_contentDeltasSize -= edit.m_insertedText.size();
+            }
+            m_contentDeltas.removeFirst();
+        }
+    }
+
+    // Apply the edits to the content directly instead of fetching the whole
+    // content from @p_win later.
+    Q_ASSERT(!m_viewWindowToSync || m_viewWindowToSync == p_win);
+    if (m_viewWindowToSync || !applyContentEdits(p_edits, p_length)) {
+        invalidateContent(p_win, p_setRevision);
+        return;
+    }
+
+    ++m_revision;
+    p_setRevision(m_revision);
+    m_autoSaveTimer->start();
+    emit contentsChanged();
+}
+
+bool Buffer::applyContentEdits(const QVector<ContentEdit> &p_edits, int p_length)
+{
+    m_contentTextValid = false;
+    for (const auto &edit : p_edits) {
+        if (!m_content.replace(edit.m_position, edit.m_removedCount, edit.m_insertedText)) {
+            return false;
+        }
+    }
+    return m_content.size() == p_length;
+}
+
+bool Buffer::getContentDeltas(int p_fromRevision, QVector<ContentDelta> &p_deltas) const
+{
+    p_deltas.clear();
+    if (p_fromRevision == m_revision) {
+        return true;
+    }
+
+    if (p_fromRevision > m_revision
+        || m_contentDeltas.isEmpty()
+        || m_contentDeltas.last().m_revision != m_revision
+        || m_contentDeltas.first().m_revision > p_fromRevision + 1) {
+        return false;
+    }
+
+    const int idx = m_contentDeltas.size() - (m_revision - p_fromRevision);
+    Q_ASSERT(m_contentDeltas[idx].m_revision == p_fromRevision + 1);
+    p_deltas = m_contentDeltas.mid(idx);
+    return true;
+}
+
+void Buffer::clearContentDeltas()
+{
+    m_contentDeltas.clear();
+    m_contentDeltasSize = 0;
+}
+
 int Buffer::getRevision() const
 {
     return m_revision;
@@ -158,7 +273,7 @@ void Buffer::syncContent()
 {
     if (m_viewWindowToSync) {
         // Need to sync content.
-        m_content = m_viewWindowToSync->getLatestContent();
+        setContentInternal(m_viewWindowToSync->getLatestContent());
         m_viewWindowToSync = nullptr;
     }
 }
@@ -183,6 +298,11 @@ bool Buffer::isReadOnly() const
     return m_readOnly;
 }
 
+bool Buffer::isLargeFile() const
+{
+    return m_largeFile;
+}
+
 Buffer::OperationCode Buffer::save(bool p_force)
 {
     Q_ASSERT(!m_readOnly);
@@ -190,6 +310,9 @@ Buffer::OperationCode Buffer::save(bool p_force)
         return OperationCode::Failed;
     }
 
+    // Keep writes in order.
+    waitForBackgroundSave();
+
     if (m_modified
         || p_force
         || m_state & (StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside)) {
@@ -210,7 +333,10 @@ Buffer::OperationCode Buffer::save(bool p_force)
         }
 
         try {
-            m_provider->write(m_content);
+            QElapsedTimer timer;
+            timer.start();
+            m_provider->write(getContent());
+            BufferSaveWorker::recordLatency(timer.elapsed());
         } catch (Exception &p_e) {
             qWarning() << "failed to write the buffer content" << getPath() << p_e.what();
             return OperationCode::Failed;
@@ -218,12 +344,16 @@ Buffer::OperationCode Buffer::save(bool p_force)
 
         setModified(false);
         m_state &= ~(StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside);
+
+        emit saved();
     }
     return OperationCode::Success;
 }
 
 Buffer::OperationCode Buffer::reload()
 {
+    waitForBackgroundSave();
+
     // Check if file is missing.
     if (!checkFileExistsOnDisk()) {
         qWarning() << "failed to save buffer due to file missing on disk" << getPath();
@@ -232,9 +362,13 @@ Buffer::OperationCode Buffer::reload()
 
     if (m_modified
         || m_state & (StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside)) {
+        const bool wasLargeFile = m_largeFile;
         readContent();
 
         emit modified(m_modified);
+        if (m_largeFile != wasLargeFile) {
+            emit largeFileChanged();
+        }
         emit contentsChanged();
     }
     return OperationCode::Success;
@@ -242,11 +376,18 @@ Buffer::OperationCode Buffer::reload()
 
 void Buffer::readContent()
 {
-    m_content = m_provider->read();
+    const qint64 largeFileSize = ConfigMgr::getInst().getEditorConfig().getLargeFileSize() * 1024LL * 1024;
+    m_largeFile = QFileInfo(getContentPath()).size() >= largeFileSize;
+    if (m_largeFile) {
+        qInfo() << "open buffer in large file mode" << getContentPath();
+    }
+
+    setContentInternal(m_provider->read());
     ++m_revision;
 
     // Reset state.
     m_viewWindowToSync = nullptr;
+    clearContentDeltas();
     m_modified = false;
 }
 
@@ -255,11 +396,13 @@ void Buffer::discard()
     Q_ASSERT(!(m_state & StateFlag::Discarded));
     Q_ASSERT(m_attachedViewWindowCount == 1);
     m_autoSaveTimer->stop();
-    m_content.clear();
+    waitForBackgroundSave();
+    setContentInternal(QString());
     m_state |= StateFlag::Discarded;
     ++m_revision;
 
     m_viewWindowToSync = nullptr;
+    clearContentDeltas();
     m_modified = false;
 }
 
@@ -267,9 +410,11 @@ void Buffer::close()
 {
     // Delete the backup file if exists.
     m_autoSaveTimer->stop();
+    waitForBackgroundSave();
     if (!m_backupFilePath.isEmpty()) {
         FileUtils::removeFile(m_backupFilePath);
         m_backupFilePath.clear();
+        m_backupJournal.reset();
     }
 }
 
@@ -318,9 +463,7 @@ void Buffer::autoSave()
         return;
 
     case EditorConfig::AutoSavePolicy::AutoSave:
-        if (save(false) != OperationCode::Success) {
-            qWarning() << "AutoSave failed to save buffer, retry later";
-        }
+        saveInBackground();
         break;
 
     case EditorConfig::AutoSavePolicy::BackupFile:
@@ -333,6 +476,73 @@ void Buffer::autoSave()
     }
 }
 
+void Buffer::saveInBackground()
+{
+    if (!m_modified) {
+        return;
+    }
+
+    if (m_backgroundSaveRevision != -1) {
+        // Coalesce changes into next save.
+        m_autoSaveTimer->start();
+        return;
+    }
+
+    // Content must be fetched from the view window in GUI thread.
+    syncContent();
+
+    if (!checkFileExistsOnDisk()) {
+        qWarning() << "AutoSave failed to save buffer due to file missing on disk" << getPath();
+        return;
+    }
+
+    if (checkFileChangedOutside()) {
+        qWarning() << "AutoSave failed to save buffer due to file changed from outside" << getPath();
+        return;
+    }
+
+    m_backgroundSaveRevision = m_revision;
+    m_backgroundSaveWatcher->setFuture(BufferSaveWorker::write(m_provider, m_content));
+}
+
+void Buffer::handleBackgroundSaveFinished()
+{
+    if (m_backgroundSaveRevision == -1) {
+        // Already handled by waitForBackgroundSave().
+        return;
+    }
+
+    const int revision = m_backgroundSaveRevision;
+    m_backgroundSaveRevision = -1;
+
+    const auto result = m_backgroundSaveWatcher->result();
+    BufferSaveWorker::recordLatency(result.m_elapsedMs);
+    if (!result.m_succeeded) {
+        qWarning() << "AutoSave failed to save buffer, retry later" << getPath() << result.m_errorMessage;
+        return;
+    }
+
+    m_provider->handleContentFileWritten();
+
+    // Content may be changed during the save and the next save will cover it.
+    if (revision == m_revision) {
+        setModified(false);
+        m_state &= ~(StateFlag::FileMissingOnDisk | StateFlag::FileChangedOutside);
+
+        emit saved();
+    }
+}
+
+void Buffer::waitForBackgroundSave()
+{
+    if (m_backgroundSaveRevision == -1) {
+        return;
+    }
+
+    m_backgroundSaveWatcher->waitForFinished();
+    handleBackgroundSaveFinished();
+}
+
 void Buffer::writeBackupFile()
 {
     if (m_backupFilePath.isEmpty()) {
@@ -345,12 +555,14 @@ void Buffer::writeBackupFile()
         QDir backupDir(backupDirPath);
         backupDir.mkpath(backupDirPath);
         m_backupFilePath = backupDir.filePath(backupFileName);
+        m_backupJournal.reset(new BackupJournal(m_backupFilePath, generateBackupFileHead()));
     }
 
     Q_ASSERT(m_backupFilePathOfPreviousSession.isEmpty());
 
     // Just use FileUtils instead of notebook backend.
-    FileUtils::writeFile(m_backupFilePath, generateBackupFileHead() + getContent());
+    // Only the delta since last write will be appended.
+    m_backupJournal->write(getContent());
 }
 
 QString Buffer::generateBackupFileHead() const
@@ -416,6 +628,14 @@ const QString &Buffer::getBackupFileOfPreviousSession() const
 
 QString Buffer::readBackupFile(const QString &p_filePath)
 {
+    // Journal is written in binary mode to keep positions exact.
+    auto data = QString::fromUtf8(FileUtils::readFile(p_filePath));
+    data = data.mid(data.indexOf(QLatin1Char('|')) + 1);
+    if (BackupJournal::isJournal(data)) {
+        return BackupJournal::replay(data);
+    }
+
+    // Backup file containing the whole content in text mode.
     auto content = FileUtils::readTextFile(p_filePath);
     return content.mid(content.indexOf(QLatin1Char('|')) + 1);
 }
@@ -433,8 +653,10 @@ void Buffer::recoverFromBackupFileOfPreviousSession()
 {
     Q_ASSERT(!m_backupFilePathOfPreviousSession.isEmpty());
 
-    m_content = readBackupFile(m_backupFilePathOfPreviousSession);
-    m_provider->write(m_content);
+    waitForBackgroundSave();
+
+    setContentInternal(readBackupFile(m_backupFilePathOfPreviousSession));
+    m_provider->write(m_contentText);
     ++m_revision;
 
     FileUtils::removeFile(m_backupFilePathOfPreviousSession);
@@ -443,6 +665,7 @@ void Buffer::recoverFromBackupFileOfPreviousSession()
 
     // Reset state.
     m_viewWindowToSync = nullptr;
+    clearContentDeltas();
     m_modified = false;
 
     emit modified(m_modified);
@@ -562,3 +785,47 @@ Buffer::StateFlags Buffer::state() const
 {
     return m_state;
 }
+
+void Buffer::watchContentFile()
+{
+    auto &watcher = FileWatcher::getInst();
+    const auto filePath = QDir::cleanPath(getContentPath());
+    if (!watcher.watch(filePath)) {
+        return;
+    }
+
+    m_watchedFilePath = filePath;
+    connect(&watcher, &FileWatcher::fileChanged,
+            this, &Buffer::handleFileChanged);
+}
+
+void Buffer::unwatchContentFile()
+{
+    if (m_watchedFilePath.isEmpty()) {
+        return;
+    }
+
+    auto &watcher = FileWatcher::getInst();
+    disconnect(&watcher, &FileWatcher::fileChanged,
+               this, &Buffer::handleFileChanged);
+    watcher.unwatch(m_watchedFilePath);
+    m_watchedFilePath.clear();
+}
+
+bool Buffer::isFileWatched() const
+{
+    // Content file may be moved along with its node.
+    return !m_watchedFilePath.isEmpty() && m_watchedFilePath == QDir::cleanPath(getContentPath());
+}
+
+void Buffer::handleFileChanged(const QString &p_filePath)
+{
+    if (p_filePath != m_watchedFilePath || m_backgroundSaveRevision != -1) {
+        return;
+    }
+
+    // Our own saves are filtered out by the last modified time.
+    if (checkFileExistsOnDisk()) {
+        checkFileChangedOutside();
+    }
+}
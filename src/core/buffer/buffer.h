@@ -3,11 +3,17 @@
 
 #include <QObject>
 #include <QSharedPointer>
+#include <QScopedPointer>
+#include <QFutureWatcher>
+#include <QVector>
 
 #include <functional>
 
 #include <global.h>
 
+#include "buffersaveworker.h"
+#include "buffercontent.h"
+
 class QWidget;
 class QTimer;
 
@@ -18,6 +24,7 @@ namespace vnotex
     class ViewWindow;
     struct FileOpenParameters;
     class BufferProvider;
+    class BackupJournal;
 
     struct BufferParameters
     {
@@ -51,6 +58,27 @@ namespace vnotex
         };
         Q_DECLARE_FLAGS(StateFlags, StateFlag);
 
+        // Replace @m_removedCount characters at @m_position with @m_insertedText.
+        struct ContentEdit
+        {
+            int m_position = 0;
+
+            int m_removedCount = 0;
+
+            QString m_insertedText;
+        };
+
+        // Edits turning the content of revision @m_revision - 1 into @m_revision.
+        struct ContentDelta
+        {
+            int m_revision = 0;
+
+            QVector<ContentEdit> m_edits;
+
+            // Content length after the edits, used to verify the result.
+            int m_length = 0;
+        };
+
         Buffer(const BufferParameters &p_parameters,
                QObject *p_parent = nullptr);
 
@@ -100,6 +128,18 @@ namespace vnotex
         void invalidateContent(const ViewWindow *p_win,
                                const std::function<void(int)> &p_setRevision);
 
+        // Invalidate the content of buffer with the edits made by @p_win, which will
+        // be logged to let other windows catch up without reloading the whole content.
+        // @p_length: content length after the edits.
+        void invalidateContent(const ViewWindow *p_win,
+                               const QVector<ContentEdit> &p_edits,
+                               int p_length,
+                               const std::function<void(int)> &p_setRevision);
+
+        // Get the deltas from revision @p_fromRevision to current revision.
+        // Return false if some of them are not logged.
+        bool getContentDeltas(int p_fromRevision, QVector<ContentDelta> &p_deltas) const;
+
         // Sync content with @p_win if @p_win is the window needed to sync.
         void syncContent(const ViewWindow *p_win);
 
@@ -110,6 +150,10 @@ namespace vnotex
 
         bool isReadOnly() const;
 
+        // Whether the content file is so large that whole-document features, like
+        // in-place preview and outline, should be disabled.
+        bool isLargeFile() const;
+
         // Save buffer content to file.
         OperationCode save(bool p_force);
 
@@ -139,6 +183,10 @@ namespace vnotex
         // Whether this buffer's provider is a child of @p_node or an attachment of @p_node.
         bool isChildOf(const Node *p_node) const;
 
+        // Wait for the background save in flight if there is one.
+        // Should be called before any other access to the file, such as moving it.
+        void waitForBackgroundSave();
+
         Node *getNode() const;
 
         bool isAttachmentSupported() const;
@@ -169,6 +217,10 @@ namespace vnotex
 
         StateFlags state() const;
 
+        // Whether changes of the content file are reported by FileWatcher so that
+        // periodical checks could be skipped.
+        bool isFileWatched() const;
+
         static QString readBackupFile(const QString &p_filePath);
 
     signals:
@@ -182,6 +234,12 @@ namespace vnotex
 
         void attachmentChanged();
 
+        // Emitted after the content is written to disk.
+        void saved();
+
+        // Emitted when isLargeFile() changes on reload.
+        void largeFileChanged();
+
     protected:
         virtual ViewWindow *createViewWindowInternal(const QSharedPointer<FileOpenParameters> &p_paras, QWidget *p_parent) = 0;
 
@@ -193,8 +251,21 @@ namespace vnotex
     private:
         void syncContent();
 
+        void watchContentFile();
+
+        void unwatchContentFile();
+
+        void handleFileChanged(const QString &p_filePath);
+
         void readContent();
 
+        void clearContentDeltas();
+
+        void setContentInternal(const QString &p_content);
+
+        // Return false if the edits could not be applied to m_content.
+        bool applyContentEdits(const QVector<ContentEdit> &p_edits, int p_length);
+
         // Get the path of the image folder.
         QString getImageFolderPath() const;
 
@@ -205,6 +276,11 @@ namespace vnotex
 
         void checkBackupFileOfPreviousSession();
 
+        // Save content in the I/O worker thread. Used by AutoSave.
+        void saveInBackground();
+
+        void handleBackgroundSaveFinished();
+
         bool isBackupFileOfBuffer(const QString &p_file) const;
 
         // Will be assigned uniquely once created.
@@ -215,24 +291,49 @@ namespace vnotex
 
         // If the buffer is modified, m_content reflect the latest changes instead
         // of the file content.
-        QString m_content;
+        BufferContent m_content;
+
+        // m_content in one string, materialized on demand by getContent().
+        mutable QString m_contentText;
+
+        mutable bool m_contentTextValid = true;
 
         bool m_readOnly = false;
 
+        bool m_largeFile = false;
+
         bool m_modified = false;
 
         int m_attachedViewWindowCount = 0;
 
         const ViewWindow *m_viewWindowToSync = nullptr;
 
+        // Log of the latest contiguous deltas ending at m_revision.
+        QVector<ContentDelta> m_contentDeltas;
+
+        // Inserted characters in m_contentDeltas.
+        int m_contentDeltasSize = 0;
+
         // Managed by QObject.
         QTimer *m_autoSaveTimer = nullptr;
 
         QString m_backupFilePath;
 
+        // Journal of the backup file at m_backupFilePath.
+        QScopedPointer<BackupJournal> m_backupJournal;
+
         QString m_backupFilePathOfPreviousSession;
 
         StateFlags m_state = StateFlag::Normal;
+
+        // Managed by QObject.
+        QFutureWatcher<BufferSaveWorker::Result> *m_backgroundSaveWatcher = nullptr;
+
+        // Revision of the content being saved in background. -1 if there is none.
+        int m_backgroundSaveRevision = -1;
+
+        // Content file watched by FileWatcher. Empty if not watched.
+        QString m_watchedFilePath;
     };
 } // ns vnotex
 
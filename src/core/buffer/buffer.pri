@@ -1,6 +1,9 @@
 SOURCES += \
+    $$PWD/backupjournal.cpp \
     $$PWD/buffer.cpp \
+    $$PWD/buffercontent.cpp \
     $$PWD/bufferprovider.cpp \
+    $$PWD/buffersaveworker.cpp \
     $$PWD/filebufferprovider.cpp \
     $$PWD/markdownbuffer.cpp \
     $$PWD/markdownbufferfactory.cpp \
@@ -10,8 +13,11 @@ SOURCES += \
     $$PWD/textbufferfactory.cpp
 
 HEADERS += \
+    $$PWD/backupjournal.h \
     $$PWD/bufferprovider.h \
     $$PWD/buffer.h \
+    $$PWD/buffercontent.h \
+    $$PWD/buffersaveworker.h \
     $$PWD/filebufferprovider.h \
     $$PWD/ibufferfactory.h \
     $$PWD/markdownbuffer.h \
@@ -0,0 +1,101 @@
+#include "buffercontent.h"
+
+using namespace vnotex;
+
+// Size in characters of the chunks split from an edited chunk.
+static const int c_chunkSize = 64 * 1024;
+
+BufferContent::BufferContent(const QString &p_text)
+    : m_size(p_text.size())
+{
+    // Keep the text as one chunk without copying until it is edited.
+    if (!p_text.isEmpty()) {
+        m_chunks.push_back(p_text);
+    }
+}
+
+int BufferContent::size() const
+{
+    return m_size;
+}
+
+bool BufferContent::isEmpty() const
+{
+    return m_size == 0;
+}
+
+int BufferContent::locate(int p_position, int &p_offset) const
+{
+    int pos = p_position;
+    for (int i = 0; i < m_chunks.size(); ++i) {
+        if (pos <= m_chunks[i].size()) {
+            p_offset = pos;
+            return i;
+        }
+        pos -= m_chunks[i].size();
+    }
+
+    p_offset = 0;
+    return m_chunks.size();
+}
+
+bool BufferContent::replace(int p_position, int p_removedCount, const QString &p_text)
+{
+    if (p_position < 0 || p_removedCount < 0 || p_position + p_removedCount > m_size) {
+        return false;
+    }
+
+    if (p_removedCount == 0 && p_text.isEmpty()) {
+        return true;
+    }
+
+    int startOffset = 0;
+    const int startIdx = locate(p_position, startOffset);
+    int endOffset = 0;
+    int endIdx = locate(p_position + p_removedCount, endOffset);
+
+    QString text;
+    if (startIdx == m_chunks.size()) {
+        // Empty content.
+        Q_ASSERT(m_chunks.isEmpty());
+        text = p_text;
+        endIdx = startIdx - 1;
+    } else {
+        text = m_chunks[startIdx].left(startOffset) + p_text + m_chunks[endIdx].mid(endOffset);
+    }
+
+    // Merge with next chunk if both are small to avoid fragments.
+    if (endIdx + 1 < m_chunks.size() && text.size() + m_chunks[endIdx + 1].size() <= c_chunkSize) {
+        ++endIdx;
+        text += m_chunks[endIdx];
+    }
+
+    QVector<QString> pieces;
+    for (int pos = 0; pos < text.size(); pos += c_chunkSize) {
+        pieces.push_back(text.mid(pos, c_chunkSize));
+    }
+
+    if (startIdx < m_chunks.size()) {
+        m_chunks.remove(startIdx, endIdx - startIdx + 1);
+    }
+    for (int i = 0; i < pieces.size(); ++i) {
+        m_chunks.insert(startIdx + i, pieces[i]);
+    }
+
+    m_size += p_text.size() - p_removedCount;
+    return true;
+}
+
+QString BufferContent::toString() const
+{
+    if (m_chunks.size() == 1) {
+        return m_chunks.first();
+    }
+
+    QString text;
+    text.reserve(m_size);
+    for (const auto &chunk : m_chunks) {
+        text += chunk;
+    }
+    return text;
+}
@@ -0,0 +1,41 @@
+#ifndef BUFFERCONTENT_H
+#define BUFFERCONTENT_H
+
+#include <QString>
+#include <QVector>
+
+namespace vnotex
+{
+    // Text of a buffer stored in chunks.
+    // Copies share the chunks implicitly so a snapshot is cheap, and an edit only
+    // detaches the chunks it touches instead of the whole text.
+    class BufferContent
+    {
+    public:
+        BufferContent() = default;
+
+        explicit BufferContent(const QString &p_text);
+
+        int size() const;
+
+        bool isEmpty() const;
+
+        // Replace @p_removedCount characters at @p_position with @p_text.
+        // Return false if the range is out of bound.
+        bool replace(int p_position, int p_removedCount, const QString &p_text);
+
+        // Materialize the whole text. It is free if there is only one chunk.
+        QString toString() const;
+
+    private:
+        // Get the chunk containing @p_position and the offset within it.
+        // Position at the end of a chunk belongs to that chunk.
+        int locate(int p_position, int &p_offset) const;
+
+        QVector<QString> m_chunks;
+
+        int m_size = 0;
+    };
+} // ns vnotex
+
+#endif // BUFFERCONTENT_H
@@ -4,6 +4,22 @@
 
 using namespace vnotex;
 
+void BufferProvider::write(const QString &p_content)
+{
+    writeContent(p_content);
+    updateLastModified();
+}
+
+void BufferProvider::handleContentFileWritten()
+{
+    updateLastModified();
+}
+
+void BufferProvider::updateLastModified()
+{
+    m_lastModified = getLastModifiedFromFile();
+}
+
 bool BufferProvider::checkFileExistsOnDisk() const
 {
     return QFileInfo::exists(getContentPath());
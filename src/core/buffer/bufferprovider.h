@@ -36,7 +36,22 @@ namespace vnotex
 
         virtual QString getResourcePath() const = 0;
 
-        virtual void write(const QString &p_content) = 0;
+        // Write @p_content to file and update the last modified time.
+        void write(const QString &p_content);
+
+        // Write @p_content to file without touching the last modified time.
+        virtual void writeContent(const QString &p_content) = 0;
+
+        // Write @p_content to the content file without touching any state of the
+        // provider or the notebook.
+        // It may be called in a worker thread.
+        virtual void writeContentFile(const QString &p_content) = 0;
+
+        // Called in GUI thread after writeContentFile() finished to update the states.
+        virtual void handleContentFileWritten();
+
+        // Sync the last modified time with file after writeContent().
+        void updateLastModified();
 
         virtual QString read() const = 0;
 
@@ -0,0 +1,79 @@
+#include "buffersaveworker.h"
+
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <QDebug>
+
+#include "bufferprovider.h"
+#include "exception.h"
+
+using namespace vnotex;
+
+// Upper bounds in milliseconds of the latency histogram buckets.
+static const qint64 c_latencyBuckets[] = {1, 4, 16, 64, 256, 1024, 4096};
+
+static const int c_latencyBucketCount = sizeof(c_latencyBuckets) / sizeof(c_latencyBuckets[0]);
+
+// Dump the histogram to log every such saves.
+static const int c_latencyLogInterval = 100;
+
+// Saves taking longer than this will be logged immediately.
+static const qint64 c_slowSaveMs = 500;
+
+QThreadPool *BufferSaveWorker::getThreadPool()
+{
+    static QThreadPool pool;
+    // One thread to keep writes in order.
+    pool.setMaxThreadCount(1);
+    return &pool;
+}
+
+QFuture<BufferSaveWorker::Result> BufferSaveWorker::write(const QSharedPointer<BufferProvider> &p_provider,
+                                                          const BufferContent &p_content)
+{
+    return QtConcurrent::run(getThreadPool(), [p_provider, p_content]() {
+        Result result;
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            // Materialize the content in the I/O thread.
+            p_provider->writeContentFile(p_content.toString());
+            result.m_succeeded = true;
+        } catch (Exception &p_e) {
+            result.m_errorMessage = p_e.what();
+        }
+        result.m_elapsedMs = timer.elapsed();
+        return result;
+    });
+}
+
+void BufferSaveWorker::recordLatency(qint64 p_elapsedMs)
+{
+    // The last one holds saves beyond all the bounds.
+    static int buckets[c_latencyBucketCount + 1] = {0};
+    static int count = 0;
+    static qint64 maxMs = 0;
+
+    int idx = 0;
+    while (idx < c_latencyBucketCount && p_elapsedMs >= c_latencyBuckets[idx]) {
+        ++idx;
+    }
+    ++buckets[idx];
+    ++count;
+    maxMs = qMax(maxMs, p_elapsedMs);
+
+    if (p_elapsedMs >= c_slowSaveMs) {
+        qWarning() << "slow buffer save" << p_elapsedMs << "ms";
+    }
+
+    if (count % c_latencyLogInterval == 0) {
+        QString str;
+        for (int i = 0; i < c_latencyBucketCount; ++i) {
+            str += QString("<%1ms:%2 ").arg(QString::number(c_latencyBuckets[i]), QString::number(buckets[i]));
+        }
+        str += QString(">=%1ms:%2").arg(QString::number(c_latencyBuckets[c_latencyBucketCount - 1]),
+                                        QString::number(buckets[c_latencyBucketCount]));
+        qInfo() << "buffer save latency histogram of" << count << "saves (max" << maxMs << "ms):" << str;
+    }
+}
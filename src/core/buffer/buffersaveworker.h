@@ -0,0 +1,49 @@
+#ifndef BUFFERSAVEWORKER_H
+#define BUFFERSAVEWORKER_H
+
+#include <QFuture>
+#include <QSharedPointer>
+#include <QString>
+
+#include "buffercontent.h"
+
+class QThreadPool;
+
+namespace vnotex
+{
+    class BufferProvider;
+
+    // Write buffer contents in a dedicated I/O thread instead of the GUI thread.
+    // Writes are executed in the order of submission.
+    class BufferSaveWorker
+    {
+    public:
+        struct Result
+        {
+            bool m_succeeded = false;
+
+            QString m_errorMessage;
+
+            // Time cost of the write in milliseconds.
+            qint64 m_elapsedMs = 0;
+        };
+
+        BufferSaveWorker() = delete;
+
+        // Only the content file is written in the worker thread. Caller should call
+        // BufferProvider::handleContentFileWritten() in GUI thread once it finished.
+        // @p_content: immutable snapshot of the content to write.
+        static QFuture<Result> write(const QSharedPointer<BufferProvider> &p_provider,
+                                     const BufferContent &p_content);
+
+        // Record the time cost of one save into the latency histogram, which
+        // will be dumped to log periodically.
+        // Should be called in GUI thread.
+        static void recordLatency(qint64 p_elapsedMs);
+
+    private:
+        static QThreadPool *getThreadPool();
+    };
+} // ns vnotex
+
+#endif // BUFFERSAVEWORKER_H
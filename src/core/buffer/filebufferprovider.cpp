@@ -56,10 +56,20 @@ QString FileBufferProvider::getResourcePath() const
     return m_file->getResourcePath();
 }
 
-void FileBufferProvider::write(const QString &p_content)
+void FileBufferProvider::writeContent(const QString &p_content)
 {
     m_file->write(p_content);
-    m_lastModified = getLastModifiedFromFile();
+}
+
+void FileBufferProvider::writeContentFile(const QString &p_content)
+{
+    m_file->writeContentFile(p_content);
+}
+
+void FileBufferProvider::handleContentFileWritten()
+{
+    m_file->handleContentFileWritten();
+    BufferProvider::handleContentFileWritten();
 }
 
 QString FileBufferProvider::read() const
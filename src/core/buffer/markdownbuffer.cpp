@@ -3,6 +3,7 @@
 #include <QDir>
 
 #include <widgets/markdownviewwindow.h>
+#include <widgets/textviewwindow.h>
 #include <notebook/node.h>
 #include <utils/pathutils.h>
 #include <buffer/bufferprovider.h>
@@ -18,6 +19,12 @@ MarkdownBuffer::MarkdownBuffer(const BufferParameters &p_parameters,
 
 ViewWindow *MarkdownBuffer::createViewWindowInternal(const QSharedPointer<FileOpenParameters> &p_paras, QWidget *p_parent)
 {
+    if (isLargeFile()) {
+        // Rendering and Markdown highlighting parse the whole file on each change.
+        // Edit it as plain text instead.
+        return new TextViewWindow(p_parent);
+    }
+
     return new MarkdownViewWindow(p_paras, p_parent);
 }
 
@@ -34,6 +41,11 @@ QString MarkdownBuffer::insertImage(const QImage &p_image, const QString &p_imag
 void MarkdownBuffer::fetchInitialImages()
 {
     Q_ASSERT(m_initialImages.isEmpty());
+    if (isLargeFile()) {
+        // Skip the scan. Only images inserted in this session will be tracked.
+        return;
+    }
+
     m_initialImages = vte::MarkdownUtils::fetchImagesFromMarkdownText(getContent(),
                                                                       getResourcePath(),
                                                                       vte::MarkdownLink::TypeFlag::LocalRelativeInternal);
@@ -53,6 +65,10 @@ QSet<QString> MarkdownBuffer::clearObsoleteImages()
     QSet<QString> obsoleteImages;
 
     Q_ASSERT(!isModified());
+    if (m_initialImages.isEmpty() && m_insertedImages.isEmpty()) {
+        return obsoleteImages;
+    }
+
     const bool discarded = state() & StateFlag::Discarded;
     const auto latestImages =
         vte::MarkdownUtils::fetchImagesFromMarkdownText(!discarded ? getContent() : m_provider->read(),
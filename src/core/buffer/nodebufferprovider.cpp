@@ -51,10 +51,20 @@ QString NodeBufferProvider::getResourcePath() const
     return m_nodeFile->getResourcePath();
 }
 
-void NodeBufferProvider::write(const QString &p_content)
+void NodeBufferProvider::writeContent(const QString &p_content)
 {
     m_nodeFile->write(p_content);
-    m_lastModified = getLastModifiedFromFile();
+}
+
+void NodeBufferProvider::writeContentFile(const QString &p_content)
+{
+    m_nodeFile->writeContentFile(p_content);
+}
+
+void NodeBufferProvider::handleContentFileWritten()
+{
+    m_nodeFile->handleContentFileWritten();
+    BufferProvider::handleContentFileWritten();
 }
 
 QString NodeBufferProvider::read() const
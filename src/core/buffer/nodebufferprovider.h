@@ -31,7 +31,11 @@ namespace vnotex
 
         QString getResourcePath() const Q_DECL_OVERRIDE;
 
-        void write(const QString &p_content) Q_DECL_OVERRIDE;
+        void writeContent(const QString &p_content) Q_DECL_OVERRIDE;
+
+        void writeContentFile(const QString &p_content) Q_DECL_OVERRIDE;
+
+        void handleContentFileWritten() Q_DECL_OVERRIDE;
 
         QString read() const Q_DECL_OVERRIDE;
 
@@ -11,6 +11,7 @@
 #include <buffer/nodebufferprovider.h>
 #include <buffer/filebufferprovider.h>
 #include <utils/widgetutils.h>
+#include <utils/pathutils.h>
 #include "notebookmgr.h"
 #include "vnotex.h"
 #include "externalfile.h"
@@ -137,13 +138,9 @@ void BufferMgr::open(const QString &p_filePath, const QSharedPointer<FileOpenPar
 
 Buffer *BufferMgr::findBuffer(const Node *p_node) const
 {
-    auto it = std::find_if(m_buffers.constBegin(),
-                           m_buffers.constEnd(),
-                           [p_node](const Buffer *p_buffer) {
-                               return p_buffer->match(p_node);
-                           });
-    if (it != m_buffers.constEnd()) {
-        return *it;
+    auto buffer = m_nodeBuffers.value(p_node, nullptr);
+    if (buffer && buffer->match(p_node)) {
+        return buffer;
     }
 
     return nullptr;
@@ -151,13 +148,9 @@ Buffer *BufferMgr::findBuffer(const Node *p_node) const
 
 Buffer *BufferMgr::findBuffer(const QString &p_filePath) const
 {
-    auto it = std::find_if(m_buffers.constBegin(),
-                           m_buffers.constEnd(),
-                           [p_filePath](const Buffer *p_buffer) {
-                               return p_buffer->match(p_filePath);
-                           });
-    if (it != m_buffers.constEnd()) {
-        return *it;
+    auto buffer = m_pathBuffers.value(PathUtils::normalizePath(p_filePath), nullptr);
+    if (buffer && buffer->match(p_filePath)) {
+        return buffer;
     }
 
     return nullptr;
@@ -166,25 +159,52 @@ Buffer *BufferMgr::findBuffer(const QString &p_filePath) const
 void BufferMgr::addBuffer(Buffer *p_buffer)
 {
     m_buffers.push_back(p_buffer);
-    connect(p_buffer, &Buffer::attachedViewWindowEmpty,
+
+    const auto pathKey = PathUtils::normalizePath(p_buffer->getPath());
+    m_pathBuffers.insert(pathKey, p_buffer);
+
+    const Node *node = nullptr;
+    if (p_buffer->getProviderType() == Buffer::ProviderType::Internal) {
+        node = p_buffer->getNode();
+        m_nodeBuffers.insert(node, p_buffer);
+    }
+
+    connect(p_buffer, &Buffer::saved,
             this, [this, p_buffer]() {
+                emit bufferSaved(p_buffer);
+            });
+
+    connect(p_buffer, &Buffer::attachedViewWindowEmpty,
+            this, [this, p_buffer, pathKey, node]() {
                 qDebug() << "delete buffer without attached view window"
                          << p_buffer->getName();
                 m_buffers.removeAll(p_buffer);
+                if (m_pathBuffers.value(pathKey, nullptr) == p_buffer) {
+                    m_pathBuffers.remove(pathKey);
+                }
+                if (node && m_nodeBuffers.value(node, nullptr) == p_buffer) {
+                    m_nodeBuffers.remove(node);
+                }
                 p_buffer->close();
                 p_buffer->deleteLater();
             });
 }
 
-QSharedPointer<Node> BufferMgr::loadNodeByPath(const QString &p_path)
+void BufferMgr::waitForBackgroundSaves(Node *p_node)
 {
-    const auto &notebooks = VNoteX::getInst().getNotebookMgr().getNotebooks();
-    for (const auto &nb : notebooks) {
-        auto node = nb->loadNodeByPath(p_path);
-        if (node) {
-            return node;
+    for (auto buffer : m_buffers) {
+        if (buffer->match(p_node) || buffer->isChildOf(p_node)) {
+            buffer->waitForBackgroundSave();
         }
     }
+}
 
-    return nullptr;
+QSharedPointer<Node> BufferMgr::loadNodeByPath(const QString &p_path)
+{
+    auto notebook = VNoteX::getInst().getNotebookMgr().findNotebookContainingPath(p_path);
+    if (!notebook) {
+        return nullptr;
+    }
+
+    return notebook->loadNodeByPath(p_path);
 }
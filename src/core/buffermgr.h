@@ -5,6 +5,7 @@
 #include <QScopedPointer>
 #include <QSharedPointer>
 #include <QVector>
+#include <QHash>
 
 #include "namebasedserver.h"
 
@@ -30,9 +31,15 @@ namespace vnotex
 
         void open(const QString &p_filePath, const QSharedPointer<FileOpenParameters> &p_paras);
 
+        // Wait for the background saves of buffers of @p_node and its children
+        // before it is renamed, moved or removed.
+        void waitForBackgroundSaves(Node *p_node);
+
     signals:
         void bufferRequested(Buffer *p_buffer, const QSharedPointer<FileOpenParameters> &p_paras);
 
+        void bufferSaved(Buffer *p_buffer);
+
     private:
         void initBufferServer();
 
@@ -49,6 +56,12 @@ namespace vnotex
 
         // Managed by QObject.
         QVector<Buffer *> m_buffers;
+
+        // Normalized file path -> buffer.
+        QHash<QString, Buffer *> m_pathBuffers;
+
+        // Node -> buffer of node.
+        QHash<const Node *, Buffer *> m_nodeBuffers;
     };
 } // ns vnotex
 
@@ -332,6 +332,13 @@ QString ConfigMgr::getUserDocsFolder() const
     return folderPath;
 }
 
+QString ConfigMgr::getUserCacheFolder() const
+{
+    auto folderPath = PathUtils::concatenateFilePath(m_userConfigFolderPath, QStringLiteral("cache"));
+    QDir().mkpath(folderPath);
+    return folderPath;
+}
+
 QString ConfigMgr::getAppSyntaxHighlightingFolder() const
 {
     return PathUtils::concatenateFilePath(m_appConfigFolderPath,
@@ -85,6 +85,9 @@ namespace vnotex
 
         QString getUserSyntaxHighlightingFolder() const;
 
+        // Folder for data that could be regenerated, such as rendered previews.
+        QString getUserCacheFolder() const;
+
         // If @p_filePath is absolute, just return it.
         // Otherwise, first try to find it in user folder, then in app folder.
         QString getUserOrAppFile(const QString &p_filePath) const;
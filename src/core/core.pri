@@ -10,6 +10,8 @@ include($$PWD/notebook/notebook.pri)
 
 include($$PWD/buffer/buffer.pri)
 
+include($$PWD/search/search.pri)
+
 SOURCES += \
     $$PWD/buffermgr.cpp \
     $$PWD/configmgr.cpp \
@@ -17,9 +19,12 @@ SOURCES += \
     $$PWD/editorconfig.cpp \
     $$PWD/externalfile.cpp \
     $$PWD/file.cpp \
+    $$PWD/filewatcher.cpp \
     $$PWD/htmltemplatehelper.cpp \
+    $$PWD/localgraphrenderer.cpp \
     $$PWD/logger.cpp \
     $$PWD/mainconfig.cpp \
+    $$PWD/previewdiskcache.cpp \
     $$PWD/markdowneditorconfig.cpp \
     $$PWD/singleinstanceguard.cpp \
     $$PWD/texteditorconfig.cpp \
@@ -41,11 +46,14 @@ HEADERS += \
     $$PWD/externalfile.h \
     $$PWD/file.h \
     $$PWD/filelocator.h \
+    $$PWD/filewatcher.h \
     $$PWD/fileopenparameters.h \
     $$PWD/htmltemplatehelper.h \
+    $$PWD/localgraphrenderer.h \
     $$PWD/logger.h \
     $$PWD/mainconfig.h \
     $$PWD/markdowneditorconfig.h \
+    $$PWD/previewdiskcache.h \
     $$PWD/singleinstanceguard.h \
     $$PWD/iconfig.h \
     $$PWD/texteditorconfig.h \
@@ -56,6 +56,13 @@ void EditorConfig::loadCore(const QJsonObject &p_app, const QJsonObject &p_user)
 
     m_backupFileExtension = READSTR(QStringLiteral("backup_file_extension"));
 
+    {
+        m_largeFileSize = READINT(QStringLiteral("large_file_size"));
+        if (m_largeFileSize <= 0) {
+            m_largeFileSize = 32;
+        }
+    }
+
     loadShortcuts(appObj, userObj);
 }
 
@@ -66,6 +73,7 @@ QJsonObject EditorConfig::saveCore() const
     obj[QStringLiteral("auto_save_policy")] = autoSavePolicyToString(m_autoSavePolicy);
     obj[QStringLiteral("backup_file_directory")] = m_backupFileDirectory;
     obj[QStringLiteral("backup_file_extension")] = m_backupFileExtension;
+    obj[QStringLiteral("large_file_size")] = m_largeFileSize;
     obj[QStringLiteral("shortcuts")] = saveShortcuts();
     return obj;
 }
@@ -188,3 +196,8 @@ const QString &EditorConfig::getBackupFileExtension() const
 {
     return m_backupFileExtension;
 }
+
+int EditorConfig::getLargeFileSize() const
+{
+    return m_largeFileSize;
+}
@@ -85,6 +85,8 @@ namespace vnotex
 
         const QString &getBackupFileExtension() const;
 
+        int getLargeFileSize() const;
+
         const QString &getShortcut(Shortcut p_shortcut) const;
 
     private:
@@ -112,6 +114,9 @@ namespace vnotex
         // Backup file extension.
         QString m_backupFileExtension;
 
+        // In MB. Files larger than this will be opened in large file mode.
+        int m_largeFileSize = 32;
+
         // Will be shared with MarkdownEditorConfig.
         QSharedPointer<TextEditorConfig> m_textEditorConfig;
 
@@ -17,7 +17,16 @@ QString ExternalFile::read() const
 
 void ExternalFile::write(const QString &p_content)
 {
-    FileUtils::writeFile(getContentPath(), p_content);
+    writeContentFile(p_content);
+}
+
+void ExternalFile::writeContentFile(const QString &p_content)
+{
+    FileUtils::writeFileAtomically(getContentPath(), p_content);
+}
+
+void ExternalFile::handleContentFileWritten()
+{
 }
 
 QString ExternalFile::getName() const
@@ -41,6 +41,13 @@ namespace vnotex
 
         virtual void write(const QString &p_content) = 0;
 
+        // Write @p_content to the content file only, leaving other states untouched.
+        // It may be called in a worker thread, during which the file should not be moved.
+        virtual void writeContentFile(const QString &p_content) = 0;
+
+        // Update states in GUI thread after writeContentFile().
+        virtual void handleContentFileWritten() = 0;
+
         virtual QString getName() const = 0;
 
         virtual QString getFilePath() const = 0;
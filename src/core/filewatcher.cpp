@@ -0,0 +1,152 @@
+#include "filewatcher.h"
+
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QDir>
+#include <QTimer>
+#include <QDebug>
+
+#include <utils/pathutils.h>
+
+using namespace vnotex;
+
+// Interval in milliseconds to wait for changes to settle down.
+static const int c_debounceInterval = 300;
+
+// Max number of watched files. inotify watches are limited per user and shared
+// with other applications.
+static const int c_maxWatchCount = 2048;
+
+FileWatcher &FileWatcher::getInst()
+{
+    static FileWatcher watcher;
+    return watcher;
+}
+
+FileWatcher::FileWatcher(QObject *p_parent)
+    : QObject(p_parent)
+{
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &FileWatcher::handleFileChanged);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &FileWatcher::handleDirectoryChanged);
+
+    m_debounceTimer = new QTimer(this);
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(c_debounceInterval);
+    connect(m_debounceTimer, &QTimer::timeout,
+            this, &FileWatcher::emitPendingChanges);
+}
+
+bool FileWatcher::watch(const QString &p_filePath)
+{
+    const auto filePath = QDir::cleanPath(p_filePath);
+    auto it = m_refCounts.find(filePath);
+    if (it != m_refCounts.end()) {
+        ++it.value();
+        return true;
+    }
+
+    if (m_refCounts.size() >= c_maxWatchCount) {
+        return false;
+    }
+
+    if (QFileInfo::exists(filePath)) {
+        if (!m_watcher->addPath(filePath)) {
+            qWarning() << "failed to watch file" << filePath;
+            return false;
+        }
+    } else {
+        watchMissingFile(filePath);
+    }
+
+    m_refCounts.insert(filePath, 1);
+    return true;
+}
+
+void FileWatcher::unwatch(const QString &p_filePath)
+{
+    const auto filePath = QDir::cleanPath(p_filePath);
+    auto it = m_refCounts.find(filePath);
+    if (it == m_refCounts.end()) {
+        return;
+    }
+
+    if (--it.value() > 0) {
+        return;
+    }
+
+    m_refCounts.erase(it);
+    m_pendingFiles.remove(filePath);
+    m_watcher->removePath(filePath);
+    unwatchMissingFile(filePath);
+}
+
+void FileWatcher::handleFileChanged(const QString &p_filePath)
+{
+    if (!m_refCounts.contains(p_filePath)) {
+        return;
+    }
+
+    // The watch is dropped once the file is removed or replaced, such as by an atomic save.
+    if (!m_watcher->files().contains(p_filePath)) {
+        if (!QFileInfo::exists(p_filePath) || !m_watcher->addPath(p_filePath)) {
+            watchMissingFile(p_filePath);
+        }
+    }
+
+    m_pendingFiles.insert(p_filePath);
+    m_debounceTimer->start();
+}
+
+void FileWatcher::handleDirectoryChanged(const QString &p_dirPath)
+{
+    auto it = m_missingFiles.find(p_dirPath);
+    if (it == m_missingFiles.end()) {
+        return;
+    }
+
+    const auto files = it.value();
+    for (const auto &file : files) {
+        if (QFileInfo::exists(file) && m_watcher->addPath(file)) {
+            unwatchMissingFile(file);
+            m_pendingFiles.insert(file);
+            m_debounceTimer->start();
+        }
+    }
+}
+
+void FileWatcher::watchMissingFile(const QString &p_filePath)
+{
+    const auto dirPath = PathUtils::parentDirPath(p_filePath);
+    auto &files = m_missingFiles[dirPath];
+    if (files.isEmpty() && QFileInfo::exists(dirPath)) {
+        m_watcher->addPath(dirPath);
+    }
+    files.insert(p_filePath);
+}
+
+void FileWatcher::unwatchMissingFile(const QString &p_filePath)
+{
+    const auto dirPath = PathUtils::parentDirPath(p_filePath);
+    auto it = m_missingFiles.find(dirPath);
+    if (it == m_missingFiles.end()) {
+        return;
+    }
+
+    it.value().remove(p_filePath);
+    if (it.value().isEmpty()) {
+        m_missingFiles.erase(it);
+        m_watcher->removePath(dirPath);
+    }
+}
+
+void FileWatcher::emitPendingChanges()
+{
+    const auto files = m_pendingFiles;
+    m_pendingFiles.clear();
+    for (const auto &file : files) {
+        emit fileChanged(file);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef FILEWATCHER_H
+#define FILEWATCHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+
+class QFileSystemWatcher;
+class QTimer;
+
+namespace vnotex
+{
+    // Watcher of files shared by buffers and notebooks.
+    // Watches are reference counted and notifications are debounced.
+    class FileWatcher : public QObject
+    {
+        Q_OBJECT
+    public:
+        static FileWatcher &getInst();
+
+        // Return false if @p_filePath could not be watched, such as when there are
+        // too many watches, in which case the caller should check it by itself.
+        bool watch(const QString &p_filePath);
+
+        void unwatch(const QString &p_filePath);
+
+    signals:
+        // Emitted once changes of @p_filePath settle down, including removal and re-creation.
+        void fileChanged(const QString &p_filePath);
+
+    private:
+        explicit FileWatcher(QObject *p_parent = nullptr);
+
+        void handleFileChanged(const QString &p_filePath);
+
+        void handleDirectoryChanged(const QString &p_dirPath);
+
+        // Watch the parent folder of missing file @p_filePath to catch its re-creation.
+        void watchMissingFile(const QString &p_filePath);
+
+        void unwatchMissingFile(const QString &p_filePath);
+
+        void emitPendingChanges();
+
+        QFileSystemWatcher *m_watcher = nullptr;
+
+        // File path -> number of watches.
+        QHash<QString, int> m_refCounts;
+
+        // Folder path -> missing files within it.
+        QHash<QString, QSet<QString>> m_missingFiles;
+
+        QSet<QString> m_pendingFiles;
+
+        QTimer *m_debounceTimer = nullptr;
+    };
+} // ns vnotex
+
+#endif // FILEWATCHER_H
@@ -0,0 +1,421 @@
+#include "localgraphrenderer.h"
+
+#include <QProcess>
+#include <QTimer>
+#include <QThread>
+#include <QFileInfo>
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QDebug>
+
+#include "configmgr.h"
+#include "editorconfig.h"
+#include "markdowneditorconfig.h"
+
+using namespace vnotex;
+
+// PlantUML processes. Each one holds a JVM so keep it small.
+static const int c_maxPlantUmlWorkerCount = 2;
+
+// Graphs written to one PlantUML process at a time.
+static const int c_maxBatchSize = 8;
+
+static const int c_maxGraphvizProcessCount = qBound(1, QThread::idealThreadCount() / 2, 4);
+
+// Kill the process if there is no output within this time in milliseconds.
+static const int c_timeout = 30 * 1000;
+
+// Size limit of the memory cache in KB.
+static const int c_maxCacheCost = 32 * 1024;
+
+LocalGraphRenderer &LocalGraphRenderer::getInst()
+{
+    static LocalGraphRenderer inst;
+    return inst;
+}
+
+LocalGraphRenderer::LocalGraphRenderer(QObject *p_parent)
+    : QObject(p_parent),
+      m_cache(c_maxCacheCost)
+{
+    m_delimiter = "VX_GRAPH_END_" + QByteArray::number(QRandomGenerator::global()->generate64(), 16);
+}
+
+LocalGraphRenderer::~LocalGraphRenderer()
+{
+    close();
+}
+
+bool LocalGraphRenderer::backendOfLang(const QString &p_lang, Backend &p_backend)
+{
+    if (p_lang == QStringLiteral("plantuml") || p_lang == QStringLiteral("puml")) {
+        p_backend = Backend::PlantUml;
+        return true;
+    } else if (p_lang == QStringLiteral("graphviz") || p_lang == QStringLiteral("dot")) {
+        p_backend = Backend::Graphviz;
+        return true;
+    }
+
+    return false;
+}
+
+QString LocalGraphRenderer::generateKey(Backend p_backend, const QString &p_format, const QString &p_text)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(p_text.toUtf8());
+    return QString("%1_%2_%3").arg(QString::number(static_cast<int>(p_backend)),
+                                   p_format,
+                                   QString::fromLatin1(hash.result().toHex()));
+}
+
+bool LocalGraphRenderer::normalizePlantUmlInput(const QString &p_text, QByteArray &p_input)
+{
+    static const QRegularExpression startRegExp(QStringLiteral("^@start(\\w+)"));
+
+    auto lines = p_text.trimmed().split(QLatin1Char('\n'));
+    QString startLine = QStringLiteral("@startuml");
+    QString type = QStringLiteral("uml");
+    const auto match = startRegExp.match(lines.first());
+    if (match.hasMatch()) {
+        startLine = lines.takeFirst().trimmed();
+        type = match.captured(1);
+    }
+
+    const auto endLine = QStringLiteral("@end") + type;
+    if (!lines.isEmpty() && lines.last().trimmed() == endLine) {
+        lines.removeLast();
+    }
+
+    // Stray start or end lines would split the graph or leave it unterminated,
+    // in which case the process waits for more input forever.
+    for (const auto &line : lines) {
+        const auto trimmedLine = line.trimmed();
+        if (trimmedLine.startsWith(QStringLiteral("@start")) || trimmedLine.startsWith(QStringLiteral("@end"))) {
+            return false;
+        }
+    }
+
+    lines.prepend(startLine);
+    lines.append(endLine);
+    p_input = lines.join(QLatin1Char('\n')).toUtf8() + '\n';
+    return true;
+}
+
+void LocalGraphRenderer::render(Backend p_backend,
+                                const QString &p_format,
+                                const QString &p_text,
+                                QObject *p_context,
+                                const ResultCallback &p_callback)
+{
+    updateConfig();
+
+    const auto key = generateKey(p_backend, p_format, p_text);
+    auto cachedData = m_cache.object(key);
+    if (cachedData) {
+        p_callback(p_format, *cachedData);
+        return;
+    }
+
+    auto &waiters = m_waiters[key];
+    waiters.push_back(Waiter{p_context, p_callback});
+    if (waiters.size() > 1) {
+        // Wait for the same graph being rendered.
+        return;
+    }
+
+    Request req;
+    req.m_key = key;
+    req.m_backend = p_backend;
+    req.m_format = p_format;
+    if (p_backend == Backend::PlantUml) {
+        if (!normalizePlantUmlInput(p_text, req.m_input)) {
+            qWarning() << "skip PlantUML graph with multiple start or end lines";
+            finishRequest(key, p_format, QByteArray());
+            return;
+        }
+    } else {
+        req.m_input = p_text.toUtf8();
+    }
+
+    m_pendingRequests.push_back(req);
+    dispatch();
+}
+
+void LocalGraphRenderer::dispatch()
+{
+    QVector<Request> requests;
+    requests.swap(m_pendingRequests);
+
+    // Keep the ones not started in order.
+    for (const auto &req : requests) {
+        const bool started = req.m_backend == Backend::PlantUml ? startPlantUml(req) : startGraphviz(req);
+        if (!started) {
+            m_pendingRequests.push_back(req);
+        }
+    }
+}
+
+bool LocalGraphRenderer::startPlantUml(const Request &p_request)
+{
+    if (m_plantUmlJar.isEmpty() || !QFileInfo::exists(m_plantUmlJar)) {
+        qWarning() << "PlantUML jar is not available" << m_plantUmlJar;
+        finishRequest(p_request.m_key, p_request.m_format, QByteArray());
+        return true;
+    }
+
+    PlantUmlWorker *candidate = nullptr;
+    PlantUmlWorker *idleWorker = nullptr;
+    for (const auto &worker : m_plantUmlWorkers) {
+        if (worker->m_format != p_request.m_format) {
+            if (worker->m_requests.isEmpty()) {
+                idleWorker = worker.data();
+            }
+            continue;
+        }
+
+        if (worker->m_requests.size() < c_maxBatchSize
+            && (!candidate || worker->m_requests.size() < candidate->m_requests.size())) {
+            candidate = worker.data();
+        }
+    }
+
+    if (!candidate || !candidate->m_requests.isEmpty()) {
+        // Prefer a new process to queueing behind a busy one.
+        if (m_plantUmlWorkers.size() >= c_maxPlantUmlWorkerCount && !candidate && idleWorker) {
+            // Make room for this format.
+            removePlantUmlWorker(idleWorker);
+        }
+
+        if (m_plantUmlWorkers.size() < c_maxPlantUmlWorkerCount) {
+            candidate = createPlantUmlWorker(p_request.m_format);
+        }
+    }
+
+    if (!candidate) {
+        return false;
+    }
+
+    candidate->m_requests.push_back(p_request);
+    candidate->m_process->write(p_request.m_input);
+    candidate->m_timer->start();
+    return true;
+}
+
+LocalGraphRenderer::PlantUmlWorker *LocalGraphRenderer::createPlantUmlWorker(const QString &p_format)
+{
+    auto worker = QSharedPointer<PlantUmlWorker>::create();
+    m_plantUmlWorkers.push_back(worker);
+
+    auto wk = worker.data();
+    wk->m_format = p_format;
+    wk->m_process = new QProcess(this);
+    wk->m_process->setStandardErrorFile(QProcess::nullDevice());
+
+    wk->m_timer = new QTimer(wk->m_process);
+    wk->m_timer->setSingleShot(true);
+    wk->m_timer->setInterval(c_timeout);
+    connect(wk->m_timer, &QTimer::timeout,
+            wk->m_process, &QProcess::kill);
+
+    connect(wk->m_process, &QProcess::readyReadStandardOutput,
+            this, [this, wk]() {
+                handlePlantUmlOutput(wk);
+            });
+    connect(wk->m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, [this, wk]() {
+                handlePlantUmlFinished(wk);
+            });
+    connect(wk->m_process, &QProcess::errorOccurred,
+            this, [this, wk](QProcess::ProcessError p_error) {
+                if (p_error == QProcess::FailedToStart) {
+                    handlePlantUmlFinished(wk);
+                }
+            });
+
+    const QStringList args {
+        QStringLiteral("-Djava.awt.headless=true"),
+        QStringLiteral("-jar"),
+        m_plantUmlJar,
+        QStringLiteral("-pipe"),
+        QStringLiteral("-t") + p_format,
+        QStringLiteral("-charset"),
+        QStringLiteral("UTF-8"),
+        QStringLiteral("-pipedelimitor"),
+        QString::fromLatin1(m_delimiter)
+    };
+    wk->m_process->start(m_javaExecutable, args);
+    return wk;
+}
+
+void LocalGraphRenderer::handlePlantUmlOutput(PlantUmlWorker *p_worker)
+{
+    p_worker->m_output += p_worker->m_process->readAllStandardOutput();
+    p_worker->m_timer->start();
+
+    QVector<QPair<Request, QByteArray>> results;
+    while (!p_worker->m_requests.isEmpty()) {
+        const int idx = p_worker->m_output.indexOf(m_delimiter);
+        if (idx == -1) {
+            break;
+        }
+
+        auto data = p_worker->m_output.left(idx);
+        if (p_worker->m_format == QStringLiteral("svg")) {
+            data = data.trimmed();
+        }
+
+        // Skip the delimiter line.
+        int end = idx + m_delimiter.size();
+        while (end < p_worker->m_output.size()
+               && (p_worker->m_output[end] == '\r' || p_worker->m_output[end] == '\n')) {
+            ++end;
+        }
+        p_worker->m_output.remove(0, end);
+
+        results.push_back(qMakePair(p_worker->m_requests.takeFirst(), data));
+    }
+
+    if (p_worker->m_requests.isEmpty()) {
+        p_worker->m_timer->stop();
+    }
+
+    if (results.isEmpty()) {
+        return;
+    }
+
+    // @p_worker may be gone after calling back.
+    for (const auto &result : results) {
+        finishRequest(result.first.m_key, result.first.m_format, result.second);
+    }
+
+    dispatch();
+}
+
+void LocalGraphRenderer::handlePlantUmlFinished(PlantUmlWorker *p_worker)
+{
+    qWarning() << "PlantUML process exited with" << p_worker->m_requests.size() << "requests"
+               << p_worker->m_process->errorString();
+
+    const auto requests = p_worker->m_requests;
+    removePlantUmlWorker(p_worker);
+
+    for (const auto &req : requests) {
+        finishRequest(req.m_key, req.m_format, QByteArray());
+    }
+
+    dispatch();
+}
+
+void LocalGraphRenderer::removePlantUmlWorker(PlantUmlWorker *p_worker)
+{
+    for (int i = 0; i < m_plantUmlWorkers.size(); ++i) {
+        if (m_plantUmlWorkers[i].data() != p_worker) {
+            continue;
+        }
+
+        auto process = p_worker->m_process;
+        disconnect(process, nullptr, this, nullptr);
+        process->kill();
+        process->deleteLater();
+
+        m_plantUmlWorkers.remove(i);
+        return;
+    }
+}
+
+bool LocalGraphRenderer::startGraphviz(const Request &p_request)
+{
+    if (m_runningGraphvizCount >= c_maxGraphvizProcessCount) {
+        return false;
+    }
+
+    ++m_runningGraphvizCount;
+
+    auto process = new QProcess(this);
+    QTimer::singleShot(c_timeout, process, &QProcess::kill);
+
+    auto finish = [this, process, p_request](bool p_succeeded) {
+        disconnect(process, nullptr, this, nullptr);
+        process->deleteLater();
+        --m_runningGraphvizCount;
+
+        QByteArray data;
+        if (p_succeeded) {
+            data = process->readAllStandardOutput();
+        } else {
+            qWarning() << "failed to render Graphviz" << process->errorString() << process->readAllStandardError();
+        }
+
+        finishRequest(p_request.m_key, p_request.m_format, data);
+        dispatch();
+    };
+
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, [finish](int p_exitCode, QProcess::ExitStatus p_exitStatus) {
+                finish(p_exitStatus == QProcess::NormalExit && p_exitCode == 0);
+            });
+    connect(process, &QProcess::errorOccurred,
+            this, [finish](QProcess::ProcessError p_error) {
+                if (p_error == QProcess::FailedToStart) {
+                    finish(false);
+                }
+            });
+
+    process->start(m_graphvizExecutable, {QStringLiteral("-T") + p_request.m_format});
+    process->write(p_request.m_input);
+    process->closeWriteChannel();
+    return true;
+}
+
+void LocalGraphRenderer::finishRequest(const QString &p_key, const QString &p_format, const QByteArray &p_data)
+{
+    if (!p_data.isEmpty()) {
+        m_cache.insert(p_key, new QByteArray(p_data), qMax(1, p_data.size() / 1024));
+    }
+
+    const auto waiters = m_waiters.take(p_key);
+    for (const auto &waiter : waiters) {
+        if (waiter.m_context) {
+            waiter.m_callback(p_format, p_data);
+        }
+    }
+}
+
+void LocalGraphRenderer::updateConfig()
+{
+    const auto &markdownEditorConfig = ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig();
+    const auto &jar = markdownEditorConfig.getPlantUmlJar();
+    const auto &java = markdownEditorConfig.getJavaExecutable();
+    const auto &graphviz = markdownEditorConfig.getGraphvizExecutable();
+    if (jar == m_plantUmlJar && java == m_javaExecutable && graphviz == m_graphvizExecutable) {
+        return;
+    }
+
+    m_plantUmlJar = jar;
+    m_javaExecutable = java;
+    m_graphvizExecutable = graphviz;
+    m_cache.clear();
+
+    // Restart the PlantUML processes with new programs.
+    while (!m_plantUmlWorkers.isEmpty()) {
+        auto worker = m_plantUmlWorkers.last();
+        m_pendingRequests = worker->m_requests + m_pendingRequests;
+        removePlantUmlWorker(worker.data());
+    }
+}
+
+void LocalGraphRenderer::close()
+{
+    m_pendingRequests.clear();
+    m_waiters.clear();
+    m_plantUmlWorkers.clear();
+    m_runningGraphvizCount = 0;
+
+    const auto processes = findChildren<QProcess *>();
+    for (auto process : processes) {
+        disconnect(process, nullptr, this, nullptr);
+        process->kill();
+        delete process;
+    }
+}
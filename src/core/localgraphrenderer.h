@@ -0,0 +1,146 @@
+#ifndef LOCALGRAPHRENDERER_H
+#define LOCALGRAPHRENDERER_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QVector>
+#include <QSharedPointer>
+#include <QPointer>
+
+#include <functional>
+
+class QProcess;
+class QTimer;
+
+namespace vnotex
+{
+    // Render PlantUML and Graphviz graphs with local programs instead of the
+    // web side, shared by all viewers.
+    // PlantUML runs in long-lived JVMs in pipe mode, each fed with a batch of
+    // graphs at a time. Graphviz is run once per graph with limited concurrency.
+    // Identical requests are merged and results are cached in memory.
+    class LocalGraphRenderer : public QObject
+    {
+        Q_OBJECT
+    public:
+        enum class Backend
+        {
+            PlantUml,
+            Graphviz
+        };
+
+        // Empty @p_data on failure.
+        typedef std::function<void(const QString &p_format, const QByteArray &p_data)> ResultCallback;
+
+        static LocalGraphRenderer &getInst();
+
+        // Return the backend of @p_lang. Return false if not supported.
+        static bool backendOfLang(const QString &p_lang, Backend &p_backend);
+
+        // Render @p_text as @p_format, such as svg or png.
+        // @p_callback will not be called if @p_context is destroyed.
+        void render(Backend p_backend,
+                    const QString &p_format,
+                    const QString &p_text,
+                    QObject *p_context,
+                    const ResultCallback &p_callback);
+
+        // Kill all the processes. Called on quit.
+        void close();
+
+    private:
+        struct Request
+        {
+            QString m_key;
+
+            Backend m_backend = Backend::PlantUml;
+
+            QString m_format;
+
+            QByteArray m_input;
+        };
+
+        struct Waiter
+        {
+            QPointer<QObject> m_context;
+
+            ResultCallback m_callback;
+        };
+
+        // A long-lived PlantUML process.
+        struct PlantUmlWorker
+        {
+            QProcess *m_process = nullptr;
+
+            QString m_format;
+
+            // Requests written to the process in order.
+            QVector<Request> m_requests;
+
+            QByteArray m_output;
+
+            // Kill the process if it hangs.
+            QTimer *m_timer = nullptr;
+        };
+
+        explicit LocalGraphRenderer(QObject *p_parent = nullptr);
+
+        ~LocalGraphRenderer();
+
+        static QString generateKey(Backend p_backend, const QString &p_format, const QString &p_text);
+
+        // Make @p_text one diagram enclosed by a start line and its matching end line,
+        // which pipe mode relies on to split graphs.
+        // Return false if @p_text contains other start or end lines, which would
+        // break the pipe.
+        static bool normalizePlantUmlInput(const QString &p_text, QByteArray &p_input);
+
+        void dispatch();
+
+        // Return false if no process is available for @p_request for now.
+        bool startPlantUml(const Request &p_request);
+
+        bool startGraphviz(const Request &p_request);
+
+        PlantUmlWorker *createPlantUmlWorker(const QString &p_format);
+
+        void handlePlantUmlOutput(PlantUmlWorker *p_worker);
+
+        // Fail all requests of @p_worker and remove it.
+        void handlePlantUmlFinished(PlantUmlWorker *p_worker);
+
+        // Remove @p_worker and kill the process. Its requests are not touched.
+        void removePlantUmlWorker(PlantUmlWorker *p_worker);
+
+        // Cache it and call the waiters of @p_key.
+        void finishRequest(const QString &p_key, const QString &p_format, const QByteArray &p_data);
+
+        // Check the programs against current config.
+        void updateConfig();
+
+        QString m_plantUmlJar;
+
+        QString m_javaExecutable;
+
+        QString m_graphvizExecutable;
+
+        // Requests waiting for a free process in request order.
+        QVector<Request> m_pendingRequests;
+
+        // Key -> waiters of requests pending or being rendered.
+        QHash<QString, QVector<Waiter>> m_waiters;
+
+        QVector<QSharedPointer<PlantUmlWorker>> m_plantUmlWorkers;
+
+        int m_runningGraphvizCount = 0;
+
+        // Key -> rendered data. Cost is the size in KB.
+        QCache<QString, QByteArray> m_cache;
+
+        // Delimiter written by PlantUML after each graph.
+        QByteArray m_delimiter;
+    };
+} // ns vnotex
+
+#endif // LOCALGRAPHRENDERER_H
@@ -30,6 +30,9 @@ void MarkdownEditorConfig::init(const QJsonObject &p_app, const QJsonObject &p_u
 
     m_webPlantUml = READBOOL(QStringLiteral("web_plantuml"));
     m_webGraphviz = READBOOL(QStringLiteral("web_graphviz"));
+    m_plantUmlJar = READSTR(QStringLiteral("plantuml_jar"));
+    m_javaExecutable = READSTR(QStringLiteral("java_executable"));
+    m_graphvizExecutable = READSTR(QStringLiteral("graphviz_executable"));
 
     m_prependDotInRelativeLink = READBOOL(QStringLiteral("prepend_dot_in_relative_link"));
     m_confirmBeforeClearObsoleteImages = READBOOL(QStringLiteral("confirm_before_clear_obsolete_images"));
@@ -60,6 +63,9 @@ QJsonObject MarkdownEditorConfig::toJson() const
     obj[QStringLiteral("viewer_resource")] = saveViewerResource();
     obj[QStringLiteral("web_plantuml")] = m_webPlantUml;
     obj[QStringLiteral("web_graphviz")] = m_webGraphviz;
+    obj[QStringLiteral("plantuml_jar")] = m_plantUmlJar;
+    obj[QStringLiteral("java_executable")] = m_javaExecutable;
+    obj[QStringLiteral("graphviz_executable")] = m_graphvizExecutable;
     obj[QStringLiteral("prepend_dot_in_relative_link")] = m_prependDotInRelativeLink;
     obj[QStringLiteral("confirm_before_clear_obsolete_images")] = m_confirmBeforeClearObsoleteImages;
     obj[QStringLiteral("insert_file_name_as_title")] = m_insertFileNameAsTitle;
@@ -137,6 +143,21 @@ bool MarkdownEditorConfig::getWebGraphviz() const
     return m_webGraphviz;
 }
 
+const QString &MarkdownEditorConfig::getPlantUmlJar() const
+{
+    return m_plantUmlJar;
+}
+
+const QString &MarkdownEditorConfig::getJavaExecutable() const
+{
+    return m_javaExecutable;
+}
+
+const QString &MarkdownEditorConfig::getGraphvizExecutable() const
+{
+    return m_graphvizExecutable;
+}
+
 bool MarkdownEditorConfig::getPrependDotInRelativeLink() const
 {
     return m_prependDotInRelativeLink;
@@ -52,6 +52,12 @@ namespace vnotex
 
         bool getWebGraphviz() const;
 
+        const QString &getPlantUmlJar() const;
+
+        const QString &getJavaExecutable() const;
+
+        const QString &getGraphvizExecutable() const;
+
         bool getPrependDotInRelativeLink() const;
 
         bool getConfirmBeforeClearObsoleteImages() const;
@@ -116,6 +122,13 @@ namespace vnotex
 
         bool m_webGraphviz = true;
 
+        // Programs to render PlantUML and Graphviz locally.
+        QString m_plantUmlJar;
+
+        QString m_javaExecutable;
+
+        QString m_graphvizExecutable;
+
         // Whether prepend a dot in front of the relative link, like images.
         bool m_prependDotInRelativeLink = false;
 
@@ -90,9 +90,11 @@ void Node::updateName(const QString &p_name)
         return;
     }
 
+    const auto oldPath = fetchPath();
     getConfigMgr()->renameNode(this, p_name);
     Q_ASSERT(m_name == p_name);
 
+    emit m_notebook->nodeRenamed(this, oldPath);
     emit m_notebook->nodeUpdated(this);
 }
 
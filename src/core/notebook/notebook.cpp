@@ -44,6 +44,11 @@ Notebook::Notebook(const NotebookParameters &p_paras,
         m_attachmentFolder = c_defaultAttachmentFolder;
     }
     m_configMgr->setNotebook(this);
+
+    connect(this, &Notebook::nodeRenamed,
+            this, [this](Node *p_node, const QString &p_oldPath) {
+                renameNodeInIndex(p_node, p_oldPath);
+            });
 }
 
 Notebook::~Notebook()
@@ -177,7 +182,10 @@ QSharedPointer<Node> Notebook::getRecycleBinNode() const
 
 QSharedPointer<Node> Notebook::newNode(Node *p_parent, Node::Flags p_flags, const QString &p_name)
 {
-    return m_configMgr->newNode(p_parent, p_flags, p_name);
+    auto node = m_configMgr->newNode(p_parent, p_flags, p_name);
+    addNodeToIndex(node);
+    emit nodeAdded(node.data());
+    return node;
 }
 
 const QDateTime &Notebook::getCreatedTimeUtc() const
@@ -192,6 +200,7 @@ QSharedPointer<Node> Notebook::loadNodeByPath(const QString &p_path)
     }
 
     QString relativePath;
+    QString absolutePath;
     QFileInfo fi(p_path);
     if (fi.isAbsolute()) {
         if (!fi.exists()) {
@@ -199,11 +208,102 @@ QSharedPointer<Node> Notebook::loadNodeByPath(const QString &p_path)
         }
 
         relativePath = PathUtils::relativePath(m_rootFolderPath, p_path);
+        absolutePath = p_path;
     } else {
         relativePath = p_path;
+        absolutePath = PathUtils::concatenateFilePath(getRootFolderAbsolutePath(), p_path);
+    }
+
+    const auto key = PathUtils::normalizePath(absolutePath);
+    auto node = findNodeInIndex(key);
+    if (!node) {
+        node = m_configMgr->loadNodeByPath(m_root, relativePath);
+        if (node) {
+            addNodeToIndex(node);
+        }
+    }
+
+    return node;
+}
+
+QSharedPointer<Node> Notebook::findNodeInIndex(const QString &p_key) const
+{
+    auto it = m_nodeIndex.find(p_key);
+    if (it == m_nodeIndex.end()) {
+        return nullptr;
+    }
+
+    auto node = it.value().toStrongRef();
+    if (!node) {
+        m_nodeIndex.erase(it);
     }
 
-    return m_configMgr->loadNodeByPath(m_root, relativePath);
+    return node;
+}
+
+void Notebook::addNodeToIndex(const QSharedPointer<Node> &p_node) const
+{
+    if (p_node) {
+        m_nodeIndex.insert(PathUtils::normalizePath(p_node->fetchAbsolutePath()), p_node);
+    }
+}
+
+void Notebook::removeNodeFromIndex(const Node *p_node) const
+{
+    if (m_nodeIndex.isEmpty()) {
+        return;
+    }
+
+    const auto key = PathUtils::normalizePath(p_node->fetchAbsolutePath());
+    m_nodeIndex.remove(key);
+    if (!p_node->isContainer()) {
+        return;
+    }
+
+    const auto prefix = key + QLatin1Char('/');
+    for (auto it = m_nodeIndex.begin(); it != m_nodeIndex.end();) {
+        if (it.key().startsWith(prefix)) {
+            it = m_nodeIndex.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void Notebook::renameNodeInIndex(const Node *p_node, const QString &p_oldPath) const
+{
+    if (m_nodeIndex.isEmpty()) {
+        return;
+    }
+
+    const auto oldKey = PathUtils::normalizePath(PathUtils::concatenateFilePath(getRootFolderAbsolutePath(), p_oldPath));
+    const auto newKey = PathUtils::normalizePath(p_node->fetchAbsolutePath());
+    auto it = m_nodeIndex.find(oldKey);
+    if (it != m_nodeIndex.end()) {
+        const auto node = it.value();
+        m_nodeIndex.erase(it);
+        m_nodeIndex.insert(newKey, node);
+    }
+
+    if (!p_node->isContainer()) {
+        return;
+    }
+
+    // Re-key the descendants.
+    const auto oldPrefix = oldKey + QLatin1Char('/');
+    QVector<QPair<QString, QWeakPointer<Node>>> children;
+    for (auto it = m_nodeIndex.begin(); it != m_nodeIndex.end();) {
+        if (it.key().startsWith(oldPrefix)) {
+            children.push_back(qMakePair(newKey + it.key().mid(oldKey.size()), it.value()));
+            it = m_nodeIndex.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const auto &child : children) {
+        m_nodeIndex.insert(child.first, child.second);
+    }
 }
 
 QSharedPointer<Node> Notebook::copyNodeAsChildOf(const QSharedPointer<Node> &p_src, Node *p_dest, bool p_move)
@@ -222,13 +322,19 @@ QSharedPointer<Node> Notebook::copyNodeAsChildOf(const QSharedPointer<Node> &p_s
         return p_src;
     }
 
-    return m_configMgr->copyNodeAsChildOf(p_src, p_dest, p_move);
+    auto node = m_configMgr->copyNodeAsChildOf(p_src, p_dest, p_move);
+    addNodeToIndex(node);
+    emit nodeAdded(node.data());
+    return node;
 }
 
 void Notebook::removeNode(const QSharedPointer<Node> &p_node, bool p_force, bool p_configOnly)
 {
     Q_ASSERT(p_node->getNotebook() == this);
+    removeNodeFromIndex(p_node.data());
+    const auto path = p_node->fetchPath();
     m_configMgr->removeNode(p_node, p_force, p_configOnly);
+    emit nodeRemoved(path);
 }
 
 void Notebook::removeNode(const Node *p_node, bool p_force, bool p_configOnly)
@@ -336,7 +442,10 @@ QSharedPointer<Node> Notebook::addAsNode(Node *p_parent,
                                          const QString &p_name,
                                          const NodeParameters &p_paras)
 {
-    return m_configMgr->addAsNode(p_parent, p_flags, p_name, p_paras);
+    auto node = m_configMgr->addAsNode(p_parent, p_flags, p_name, p_paras);
+    addNodeToIndex(node);
+    emit nodeAdded(node.data());
+    return node;
 }
 
 bool Notebook::isBuiltInFile(const Node *p_node, const QString &p_name) const
@@ -353,5 +462,8 @@ QSharedPointer<Node> Notebook::copyAsNode(Node *p_parent,
                                           Node::Flags p_flags,
                                           const QString &p_path)
 {
-    return m_configMgr->copyAsNode(p_parent, p_flags, p_path);
+    auto node = m_configMgr->copyAsNode(p_parent, p_flags, p_path);
+    addNodeToIndex(node);
+    emit nodeAdded(node.data());
+    return node;
 }
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QIcon>
 #include <QSharedPointer>
+#include <QHash>
 
 #include "notebookparameters.h"
 #include "../global.h"
@@ -136,9 +137,30 @@ namespace vnotex
 
         void nodeUpdated(const Node *p_node);
 
+        // Emitted after @p_node is added, copied or moved into this notebook.
+        void nodeAdded(Node *p_node);
+
+        // Emitted after the node of relative path @p_path is removed.
+        void nodeRemoved(const QString &p_path);
+
+        // Emitted after @p_node is renamed from relative path @p_oldPath.
+        void nodeRenamed(Node *p_node, const QString &p_oldPath);
+
     private:
         QSharedPointer<Node> getOrCreateRecycleBinDateNode();
 
+        // Return the node of @p_key in index after validation.
+        QSharedPointer<Node> findNodeInIndex(const QString &p_key) const;
+
+        void addNodeToIndex(const QSharedPointer<Node> &p_node) const;
+
+        // Remove @p_node and all its descendants from index.
+        void removeNodeFromIndex(const Node *p_node) const;
+
+        // Update the keys of @p_node and all its descendants after @p_node is renamed
+        // from relative path @p_oldPath.
+        void renameNodeInIndex(const Node *p_node, const QString &p_oldPath) const;
+
         // ID of this notebook.
         // Will be assigned uniquely once loaded.
         ID m_id;
@@ -175,6 +197,10 @@ namespace vnotex
         QSharedPointer<INotebookConfigMgr> m_configMgr;
 
         QSharedPointer<Node> m_root;
+
+        // Normalized absolute path -> loaded node, for fast lookup by path.
+        // Kept updated on node add, remove, rename and move.
+        mutable QHash<QString, QWeakPointer<Node>> m_nodeIndex;
     };
 } // ns vnotex
 
@@ -23,9 +23,18 @@ QString VXNodeFile::read() const
 }
 
 void VXNodeFile::write(const QString &p_content)
+{
+    writeContentFile(p_content);
+    handleContentFileWritten();
+}
+
+void VXNodeFile::writeContentFile(const QString &p_content)
 {
     m_node->getBackend()->writeFile(m_node->fetchPath(), p_content);
+}
 
+void VXNodeFile::handleContentFileWritten()
+{
     m_node->setModifiedTimeUtc();
     m_node->save();
 }
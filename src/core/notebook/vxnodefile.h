@@ -19,6 +19,10 @@ namespace vnotex
 
         void write(const QString &p_content) Q_DECL_OVERRIDE;
 
+        void writeContentFile(const QString &p_content) Q_DECL_OVERRIDE;
+
+        void handleContentFileWritten() Q_DECL_OVERRIDE;
+
         QString getName() const Q_DECL_OVERRIDE;
 
         QString getFilePath() const Q_DECL_OVERRIDE;
@@ -55,13 +55,13 @@ void LocalNotebookBackend::makePath(const QString &p_dirPath)
 void LocalNotebookBackend::writeFile(const QString &p_filePath, const QByteArray &p_data)
 {
     const auto filePath = getFullPath(p_filePath);
-    FileUtils::writeFile(filePath, p_data);
+    FileUtils::writeFileAtomically(filePath, p_data);
 }
 
 void LocalNotebookBackend::writeFile(const QString &p_filePath, const QString &p_text)
 {
     const auto filePath = getFullPath(p_filePath);
-    FileUtils::writeFile(filePath, p_text);
+    FileUtils::writeFileAtomically(filePath, p_text);
 }
 
 void LocalNotebookBackend::writeFile(const QString &p_filePath, const QJsonObject &p_jobj)
@@ -30,10 +30,10 @@ namespace vnotex
         // Create the directory path @p_dirPath. Create all parent directories if necessary.
         void makePath(const QString &p_dirPath) Q_DECL_OVERRIDE;
 
-        // Write @p_data to @p_filePath.
+        // Write @p_data to @p_filePath atomically.
         void writeFile(const QString &p_filePath, const QByteArray &p_data) Q_DECL_OVERRIDE;
 
-        // Write @p_text to @p_filePath.
+        // Write @p_text to @p_filePath atomically.
         void writeFile(const QString &p_filePath, const QString &p_text) Q_DECL_OVERRIDE;
 
         // Write @p_jobj to @p_filePath.
@@ -35,6 +35,12 @@ QSharedPointer<NotebookConfig> BundleNotebookConfigMgr::readNotebookConfig() con
 
 void BundleNotebookConfigMgr::writeNotebookConfig()
 {
+    if (isInBatch()) {
+        m_notebookConfigDirty = true;
+        return;
+    }
+
+    m_notebookConfigDirty = false;
     auto config = NotebookConfig::fromNotebook(getCodeVersion(), getNotebook());
     writeNotebookConfig(*config);
 }
@@ -44,6 +50,13 @@ void BundleNotebookConfigMgr::writeNotebookConfig(const NotebookConfig &p_config
     getBackend()->writeFile(getConfigFilePath(), p_config.toJson());
 }
 
+void BundleNotebookConfigMgr::flush()
+{
+    if (m_notebookConfigDirty) {
+        writeNotebookConfig();
+    }
+}
+
 void BundleNotebookConfigMgr::removeNotebookConfig()
 {
     getBackend()->removeDir(getConfigFolderName());
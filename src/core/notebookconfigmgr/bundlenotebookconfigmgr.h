@@ -22,6 +22,8 @@ namespace vnotex
 
         void removeNotebookConfig();
 
+        void flush() Q_DECL_OVERRIDE;
+
         bool isBuiltInFile(const Node *p_node, const QString &p_name) const Q_DECL_OVERRIDE;
 
         bool isBuiltInFolder(const Node *p_node, const QString &p_name) const Q_DECL_OVERRIDE;
@@ -42,6 +44,9 @@ namespace vnotex
     private:
         void writeNotebookConfig(const NotebookConfig &p_config);
 
+        // Notebook config is changed within a batch and not written yet.
+        bool m_notebookConfigDirty = false;
+
         // Folder name to store the notebook's config.
         // This folder locates in the root folder of the notebook.
         static const QString c_configFolderName;
@@ -1,6 +1,7 @@
 #include "inotebookconfigmgr.h"
 
 #include <notebookbackend/inotebookbackend.h>
+#include <exception.h>
 
 using namespace vnotex;
 
@@ -35,3 +36,40 @@ void INotebookConfigMgr::setNotebook(Notebook *p_notebook)
 {
     m_notebook = p_notebook;
 }
+
+void INotebookConfigMgr::beginBatch()
+{
+    ++m_batchLevel;
+}
+
+void INotebookConfigMgr::endBatch()
+{
+    Q_ASSERT(m_batchLevel > 0);
+    if (--m_batchLevel == 0) {
+        flush();
+    }
+}
+
+bool INotebookConfigMgr::isInBatch() const
+{
+    return m_batchLevel > 0;
+}
+
+void INotebookConfigMgr::flush()
+{
+}
+
+NotebookConfigMgrBatch::NotebookConfigMgrBatch(INotebookConfigMgr *p_configMgr)
+    : m_configMgr(p_configMgr)
+{
+    m_configMgr->beginBatch();
+}
+
+NotebookConfigMgrBatch::~NotebookConfigMgrBatch()
+{
+    try {
+        m_configMgr->endBatch();
+    } catch (Exception &p_e) {
+        qWarning() << "failed to flush config changes of batch" << p_e.what();
+    }
+}
@@ -75,6 +75,15 @@ namespace vnotex
 
         virtual QString fetchNodeAttachmentFolderPath(Node *p_node) = 0;
 
+        // Defer config writes until the outermost endBatch(). Could be nested.
+        void beginBatch();
+        void endBatch();
+
+        bool isInBatch() const;
+
+        // Write all deferred config changes to backend.
+        virtual void flush();
+
     protected:
         // Version of the config processing code.
         virtual QString getCodeVersion() const;
@@ -83,6 +92,22 @@ namespace vnotex
         QSharedPointer<INotebookBackend> m_backend;
 
         Notebook *m_notebook = nullptr;
+
+        int m_batchLevel = 0;
+    };
+
+    // Batch config writes of a config manager within current scope.
+    class NotebookConfigMgrBatch
+    {
+    public:
+        explicit NotebookConfigMgrBatch(INotebookConfigMgr *p_configMgr);
+
+        ~NotebookConfigMgrBatch();
+
+    private:
+        Q_DISABLE_COPY(NotebookConfigMgrBatch)
+
+        INotebookConfigMgr *m_configMgr = nullptr;
     };
 } // ns vnotex
 
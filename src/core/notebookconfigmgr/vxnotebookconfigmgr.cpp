@@ -3,8 +3,14 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
 #include <QDebug>
 
+#include <algorithm>
+
 #include <notebookbackend/inotebookbackend.h>
 #include <notebook/notebookparameters.h>
 #include <notebook/vxnode.h>
@@ -13,11 +19,20 @@
 #include <utils/fileutils.h>
 #include <utils/pathutils.h>
 #include <exception.h>
+#include <filewatcher.h>
 
 #include "nodecontentmediautils.h"
 
 using namespace vnotex;
 
+// Magic of the node config cache file: "VXNC".
+static const quint32 c_nodeConfigCacheMagic = 0x56584e43;
+
+// Bump it when the binary layout of NodeConfig changes.
+static const quint32 c_nodeConfigCacheVersion = 1;
+
+static const QDataStream::Version c_nodeConfigCacheStreamVersion = QDataStream::Qt_5_12;
+
 const QString VXNotebookConfigMgr::NodeConfig::c_version = "version";
 
 const QString VXNotebookConfigMgr::NodeConfig::c_id = "id";
@@ -76,6 +91,28 @@ void VXNotebookConfigMgr::NodeFileConfig::fromJson(const QJsonObject &p_jobj)
     }
 }
 
+void VXNotebookConfigMgr::NodeFileConfig::toBinary(QDataStream &p_stream) const
+{
+    p_stream << m_name
+             << static_cast<quint64>(m_id)
+             << m_createdTimeUtc
+             << m_modifiedTimeUtc
+             << m_attachmentFolder
+             << m_tags;
+}
+
+void VXNotebookConfigMgr::NodeFileConfig::fromBinary(QDataStream &p_stream)
+{
+    quint64 id = Node::InvalidId;
+    p_stream >> m_name
+             >> id
+             >> m_createdTimeUtc
+             >> m_modifiedTimeUtc
+             >> m_attachmentFolder
+             >> m_tags;
+    m_id = id;
+}
+
 QJsonObject VXNotebookConfigMgr::NodeFolderConfig::toJson() const
 {
     QJsonObject jobj;
@@ -90,6 +127,16 @@ void VXNotebookConfigMgr::NodeFolderConfig::fromJson(const QJsonObject &p_jobj)
     m_name = p_jobj[NodeConfig::c_name].toString();
 }
 
+void VXNotebookConfigMgr::NodeFolderConfig::toBinary(QDataStream &p_stream) const
+{
+    p_stream << m_name;
+}
+
+void VXNotebookConfigMgr::NodeFolderConfig::fromBinary(QDataStream &p_stream)
+{
+    p_stream >> m_name;
+}
+
 VXNotebookConfigMgr::NodeConfig::NodeConfig()
 {
 }
@@ -158,11 +205,73 @@ void VXNotebookConfigMgr::NodeConfig::fromJson(const QJsonObject &p_jobj)
     }
 }
 
+QByteArray VXNotebookConfigMgr::NodeConfig::toBinary() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(c_nodeConfigCacheStreamVersion);
+
+    stream << m_version
+           << static_cast<quint64>(m_id)
+           << m_createdTimeUtc
+           << m_modifiedTimeUtc;
+
+    stream << static_cast<quint32>(m_files.size());
+    for (const auto &file : m_files) {
+        file.toBinary(stream);
+    }
+
+    stream << static_cast<quint32>(m_folders.size());
+    for (const auto &folder : m_folders) {
+        folder.toBinary(stream);
+    }
+
+    return data;
+}
+
+bool VXNotebookConfigMgr::NodeConfig::fromBinary(const QByteArray &p_data)
+{
+    QDataStream stream(p_data);
+    stream.setVersion(c_nodeConfigCacheStreamVersion);
+
+    quint64 id = Node::InvalidId;
+    stream >> m_version
+           >> id
+           >> m_createdTimeUtc
+           >> m_modifiedTimeUtc;
+    m_id = id;
+
+    // Each item takes at least 4 bytes, which guards against corrupted counts.
+    quint32 cnt = 0;
+    stream >> cnt;
+    if (stream.status() != QDataStream::Ok || cnt > static_cast<quint32>(p_data.size())) {
+        return false;
+    }
+    m_files.resize(cnt);
+    for (auto &file : m_files) {
+        file.fromBinary(stream);
+    }
+
+    cnt = 0;
+    stream >> cnt;
+    if (stream.status() != QDataStream::Ok || cnt > static_cast<quint32>(p_data.size())) {
+        return false;
+    }
+    m_folders.resize(cnt);
+    for (auto &folder : m_folders) {
+        folder.fromBinary(stream);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
 
 const QString VXNotebookConfigMgr::c_nodeConfigName = "vx.json";
 
 const QString VXNotebookConfigMgr::c_recycleBinFolderName = "vx_recycle_bin";
 
+const QString VXNotebookConfigMgr::c_nodeConfigCacheName = "vx_node_cache.bin";
+
 VXNotebookConfigMgr::VXNotebookConfigMgr(const QString &p_name,
                                          const QString &p_displayName,
                                          const QString &p_description,
@@ -171,6 +280,21 @@ VXNotebookConfigMgr::VXNotebookConfigMgr(const QString &p_name,
     : BundleNotebookConfigMgr(p_backend, p_parent),
       m_info(p_name, p_displayName, p_description)
 {
+    connect(&FileWatcher::getInst(), &FileWatcher::fileChanged,
+            this, &VXNotebookConfigMgr::handleConfigFileChanged);
+}
+
+VXNotebookConfigMgr::~VXNotebookConfigMgr()
+{
+    try {
+        flush();
+    } catch (Exception &p_e) {
+        qWarning() << "failed to flush node configs" << p_e.what();
+    }
+
+    saveNodeConfigCache();
+
+    unwatchAllConfigFiles();
 }
 
 QString VXNotebookConfigMgr::getName() const
@@ -266,9 +390,15 @@ QSharedPointer<VXNotebookConfigMgr::NodeConfig> VXNotebookConfigMgr::readNodeCon
                             QString("node (%1) is a file node without config").arg(p_path));
     } else {
         auto configPath = PathUtils::concatenateFilePath(p_path, c_nodeConfigName);
-        auto data = backend->readFile(configPath);
         auto nodeConfig = QSharedPointer<NodeConfig>::create();
-        nodeConfig->fromJson(QJsonDocument::fromJson(data).object());
+        if (!readNodeConfigFromCache(configPath, *nodeConfig)) {
+            // vx.json is the source of truth. Parse it and refresh the cache.
+            *nodeConfig = NodeConfig();
+            auto data = backend->readFile(configPath);
+            nodeConfig->fromJson(QJsonDocument::fromJson(data).object());
+            updateNodeConfigCache(configPath, *nodeConfig);
+            trustNodeConfigCache(configPath);
+        }
         return nodeConfig;
     }
 
@@ -284,14 +414,67 @@ QString VXNotebookConfigMgr::getNodeConfigFilePath(const Node *p_node) const
 void VXNotebookConfigMgr::writeNodeConfig(const QString &p_path, const NodeConfig &p_config) const
 {
     getBackend()->writeFile(p_path, p_config.toJson());
+    updateNodeConfigCache(p_path, p_config);
 }
 
 void VXNotebookConfigMgr::writeNodeConfig(const Node *p_node)
 {
+    if (isInBatch()) {
+        m_dirtyNodes.insert(p_node);
+        return;
+    }
+
+    m_dirtyNodes.remove(p_node);
     auto config = nodeToNodeConfig(p_node);
     writeNodeConfig(getNodeConfigFilePath(p_node), *config);
 }
 
+void VXNotebookConfigMgr::removeDirtyNodes(const Node *p_node)
+{
+    if (m_dirtyNodes.isEmpty()) {
+        return;
+    }
+
+    m_dirtyNodes.remove(p_node);
+    for (const auto &child : p_node->getChildren()) {
+        if (child->isContainer()) {
+            removeDirtyNodes(child.data());
+        }
+    }
+}
+
+void VXNotebookConfigMgr::flush()
+{
+    // Persist next node ID first so IDs referred by node configs will never be reused.
+    BundleNotebookConfigMgr::flush();
+
+    if (m_dirtyNodes.isEmpty()) {
+        return;
+    }
+
+    // Write deeper nodes first so that a parent never refers to a child folder
+    // whose config is not written yet if we crash halfway.
+    QVector<QPair<int, const Node *>> nodes;
+    nodes.reserve(m_dirtyNodes.size());
+    for (auto node : m_dirtyNodes) {
+        int depth = 0;
+        for (auto pa = node->getParent(); pa; pa = pa->getParent()) {
+            ++depth;
+        }
+        nodes.push_back(qMakePair(depth, node));
+    }
+
+    std::sort(nodes.begin(), nodes.end(), [](const QPair<int, const Node *> &p_a, const QPair<int, const Node *> &p_b) {
+        return p_a.first > p_b.first;
+    });
+
+    for (const auto &pa : nodes) {
+        auto config = nodeToNodeConfig(pa.second);
+        writeNodeConfig(getNodeConfigFilePath(pa.second), *config);
+        m_dirtyNodes.remove(pa.second);
+    }
+}
+
 QSharedPointer<Node> VXNotebookConfigMgr::nodeConfigToNode(const NodeConfig &p_config,
                                                            const QString &p_name,
                                                            Node *p_parent) const
@@ -500,13 +683,20 @@ void VXNotebookConfigMgr::saveNode(const Node *p_node)
 void VXNotebookConfigMgr::renameNode(Node *p_node, const QString &p_name)
 {
     Q_ASSERT(!p_node->isRoot());
+    const auto oldPath = p_node->fetchPath();
     if (p_node->isContainer()) {
-        getBackend()->renameDir(p_node->fetchPath(), p_name);
+        // Watches on Windows hold handles within the folder and block the rename.
+        unwatchConfigFiles(oldPath);
+        getBackend()->renameDir(oldPath, p_name);
     } else {
-        getBackend()->renameFile(p_node->fetchPath(), p_name);
+        getBackend()->renameFile(oldPath, p_name);
     }
 
     p_node->setName(p_name);
+    if (p_node->isContainer()) {
+        // vx.json files are moved along with the folder untouched.
+        moveNodeConfigCache(oldPath, p_node->fetchPath());
+    }
     writeNodeConfig(p_node->getParent());
 }
 
@@ -621,6 +811,9 @@ QSharedPointer<Node> VXNotebookConfigMgr::copyFolderNodeAsChildOf(const QSharedP
                                                                   Node *p_dest,
                                                                   bool p_move)
 {
+    // Write each touched vx.json once instead of once per child.
+    NotebookConfigMgrBatch batch(this);
+
     auto srcFolderPath = p_src->fetchAbsolutePath();
     auto destFolderPath = PathUtils::concatenateFilePath(p_dest->fetchPath(),
                                                          PathUtils::fileName(srcFolderPath));
@@ -670,7 +863,14 @@ void VXNotebookConfigMgr::removeNode(const QSharedPointer<Node> &p_node, bool p_
         for (auto &childNode : p_node->getChildren()) {
             removeNode(childNode, p_force, p_configOnly);
         }
+    }
 
+    // Removing children above will queue @p_node again.
+    if (p_node->isContainer()) {
+        removeDirtyNodes(p_node.data());
+    }
+
+    if (!p_configOnly) {
         removeFilesOfNode(p_node.data(), p_force);
     }
 
@@ -701,6 +901,7 @@ void VXNotebookConfigMgr::removeFilesOfNode(Node *p_node, bool p_force)
         auto configFilePath = getNodeConfigFilePath(p_node);
         getBackend()->removeFile(configFilePath);
         auto folderPath = p_node->fetchPath();
+        moveNodeConfigCache(folderPath, QString());
         if (p_force) {
             getBackend()->removeDir(folderPath);
         } else {
@@ -840,3 +1041,225 @@ void VXNotebookConfigMgr::inheritNodeFlags(const Node *p_node, Node *p_child) co
         markNodeReadOnly(p_child);
     }
 }
+
+QString VXNotebookConfigMgr::getNodeConfigCacheFilePath() const
+{
+    return PathUtils::concatenateFilePath(getConfigFolderName(), c_nodeConfigCacheName);
+}
+
+void VXNotebookConfigMgr::loadNodeConfigCache() const
+{
+    if (m_nodeConfigCacheLoaded) {
+        return;
+    }
+
+    m_nodeConfigCacheLoaded = true;
+    m_nodeConfigCache.clear();
+    m_nodeConfigCacheFile.reset();
+
+    const auto cacheFilePath = getBackend()->getFullPath(getNodeConfigCacheFilePath());
+    if (!QFileInfo::exists(cacheFilePath)) {
+        return;
+    }
+
+    m_nodeConfigCacheFile.reset(new QFile(cacheFilePath));
+    const auto size = m_nodeConfigCacheFile->size();
+    uchar *mem = nullptr;
+    if (m_nodeConfigCacheFile->open(QIODevice::ReadOnly)) {
+        mem = m_nodeConfigCacheFile->map(0, size);
+    }
+    if (!mem) {
+        qWarning() << "failed to map node config cache" << cacheFilePath;
+        m_nodeConfigCacheFile.reset();
+        return;
+    }
+
+    // Entries point into the mapped file directly without copy.
+    const auto raw = QByteArray::fromRawData(reinterpret_cast<const char *>(mem), size);
+    QDataStream stream(raw);
+    stream.setVersion(c_nodeConfigCacheStreamVersion);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 cnt = 0;
+    stream >> magic >> version >> cnt;
+    if (stream.status() != QDataStream::Ok
+        || magic != c_nodeConfigCacheMagic
+        || version != c_nodeConfigCacheVersion) {
+        qInfo() << "discard node config cache of different version" << cacheFilePath;
+        m_nodeConfigCacheFile.reset();
+        return;
+    }
+
+    for (quint32 i = 0; i < cnt; ++i) {
+        QString configPath;
+        NodeConfigCacheEntry entry;
+        quint32 len = 0;
+        stream >> configPath >> entry.m_configModifiedMsecs >> entry.m_configSize >> len;
+
+        const auto offset = stream.device()->pos();
+        if (stream.status() != QDataStream::Ok || offset + len > size) {
+            qWarning() << "discard corrupted node config cache" << cacheFilePath;
+            m_nodeConfigCache.clear();
+            m_nodeConfigCacheFile.reset();
+            return;
+        }
+
+        entry.m_data = QByteArray::fromRawData(raw.constData() + offset, len);
+        stream.skipRawData(len);
+        m_nodeConfigCache.insert(configPath, entry);
+    }
+}
+
+void VXNotebookConfigMgr::saveNodeConfigCache() const
+{
+    if (!m_nodeConfigCacheDirty) {
+        return;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(c_nodeConfigCacheStreamVersion);
+        stream << c_nodeConfigCacheMagic
+               << c_nodeConfigCacheVersion
+               << static_cast<quint32>(m_nodeConfigCache.size());
+        for (auto it = m_nodeConfigCache.constBegin(); it != m_nodeConfigCache.constEnd(); ++it) {
+            const auto &entry = it.value();
+            stream << it.key()
+                   << entry.m_configModifiedMsecs
+                   << entry.m_configSize
+                   << static_cast<quint32>(entry.m_data.size());
+            stream.writeRawData(entry.m_data.constData(), entry.m_data.size());
+        }
+    }
+
+    // Release the mapping before overwriting the file backing it.
+    // The cache will be mapped again on next access.
+    m_nodeConfigCache.clear();
+    m_nodeConfigCacheFile.reset();
+    m_nodeConfigCacheLoaded = false;
+    m_nodeConfigCacheDirty = false;
+
+    try {
+        getBackend()->writeFile(getNodeConfigCacheFilePath(), data);
+    } catch (Exception &p_e) {
+        qWarning() << "failed to write node config cache" << p_e.what();
+    }
+}
+
+bool VXNotebookConfigMgr::readNodeConfigFromCache(const QString &p_configPath, NodeConfig &p_config) const
+{
+    loadNodeConfigCache();
+
+    auto it = m_nodeConfigCache.constFind(p_configPath);
+    if (it == m_nodeConfigCache.constEnd()) {
+        return false;
+    }
+
+    if (!m_trustedConfigFiles.contains(p_configPath)) {
+        QFileInfo fi(getBackend()->getFullPath(p_configPath));
+        if (fi.size() != it->m_configSize
+            || fi.lastModified().toMSecsSinceEpoch() != it->m_configModifiedMsecs) {
+            return false;
+        }
+
+        trustNodeConfigCache(p_configPath);
+    }
+
+    return p_config.fromBinary(it->m_data);
+}
+
+void VXNotebookConfigMgr::trustNodeConfigCache(const QString &p_configPath) const
+{
+    const auto fullPath = QDir::cleanPath(getBackend()->getFullPath(p_configPath));
+    if (!m_watchedConfigFiles.contains(fullPath)) {
+        if (!FileWatcher::getInst().watch(fullPath)) {
+            return;
+        }
+        m_watchedConfigFiles.insert(fullPath, p_configPath);
+    }
+
+    m_trustedConfigFiles.insert(p_configPath);
+}
+
+void VXNotebookConfigMgr::handleConfigFileChanged(const QString &p_filePath)
+{
+    auto it = m_watchedConfigFiles.constFind(p_filePath);
+    if (it != m_watchedConfigFiles.constEnd()) {
+        // Validate by stat on next read.
+        m_trustedConfigFiles.remove(it.value());
+    }
+}
+
+void VXNotebookConfigMgr::unwatchAllConfigFiles()
+{
+    auto &watcher = FileWatcher::getInst();
+    for (auto it = m_watchedConfigFiles.constBegin(); it != m_watchedConfigFiles.constEnd(); ++it) {
+        watcher.unwatch(it.key());
+    }
+    m_watchedConfigFiles.clear();
+    m_trustedConfigFiles.clear();
+}
+
+void VXNotebookConfigMgr::updateNodeConfigCache(const QString &p_configPath, const NodeConfig &p_config) const
+{
+    loadNodeConfigCache();
+
+    m_nodeConfigCacheDirty = true;
+
+    QFileInfo fi(getBackend()->getFullPath(p_configPath));
+    if (!fi.exists()) {
+        m_nodeConfigCache.remove(p_configPath);
+        return;
+    }
+
+    NodeConfigCacheEntry entry;
+    entry.m_configModifiedMsecs = fi.lastModified().toMSecsSinceEpoch();
+    entry.m_configSize = fi.size();
+    entry.m_data = p_config.toBinary();
+    m_nodeConfigCache.insert(p_configPath, entry);
+}
+
+void VXNotebookConfigMgr::moveNodeConfigCache(const QString &p_folderPath, const QString &p_newFolderPath) const
+{
+    Q_ASSERT(!p_folderPath.isEmpty());
+    loadNodeConfigCache();
+
+    const auto prefix = p_folderPath + QLatin1Char('/');
+    QVector<QPair<QString, NodeConfigCacheEntry>> movedEntries;
+    for (auto it = m_nodeConfigCache.begin(); it != m_nodeConfigCache.end();) {
+        if (it.key().startsWith(prefix)) {
+            if (!p_newFolderPath.isEmpty()) {
+                movedEntries.push_back(qMakePair(p_newFolderPath + it.key().mid(p_folderPath.size()),
+                                                 it.value()));
+            }
+            it = m_nodeConfigCache.erase(it);
+            m_nodeConfigCacheDirty = true;
+        } else {
+            ++it;
+        }
+    }
+
+    for (const auto &entry : movedEntries) {
+        m_nodeConfigCache.insert(entry.first, entry.second);
+    }
+
+    // Moved entries will be validated and watched again on next read.
+    unwatchConfigFiles(p_folderPath);
+}
+
+void VXNotebookConfigMgr::unwatchConfigFiles(const QString &p_folderPath) const
+{
+    const auto prefix = p_folderPath + QLatin1Char('/');
+    auto &watcher = FileWatcher::getInst();
+    for (auto it = m_watchedConfigFiles.begin(); it != m_watchedConfigFiles.end();) {
+        if (it.value().startsWith(prefix)) {
+            m_trustedConfigFiles.remove(it.value());
+            watcher.unwatch(it.key());
+            it = m_watchedConfigFiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
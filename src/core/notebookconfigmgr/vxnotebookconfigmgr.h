@@ -5,10 +5,15 @@
 
 #include <QDateTime>
 #include <QVector>
+#include <QHash>
+#include <QSet>
+#include <QScopedPointer>
 
 #include "../global.h"
 
 class QJsonObject;
+class QDataStream;
+class QFile;
 
 namespace vnotex
 {
@@ -23,6 +28,8 @@ namespace vnotex
                                      const QSharedPointer<INotebookBackend> &p_backend,
                                      QObject *p_parent = nullptr);
 
+        ~VXNotebookConfigMgr();
+
         QString getName() const Q_DECL_OVERRIDE;
 
         QString getDisplayName() const Q_DECL_OVERRIDE;
@@ -68,6 +75,8 @@ namespace vnotex
 
         QString fetchNodeAttachmentFolderPath(Node *p_node) Q_DECL_OVERRIDE;
 
+        void flush() Q_DECL_OVERRIDE;
+
     private:
         // Config of a file child.
         struct NodeFileConfig
@@ -76,6 +85,10 @@ namespace vnotex
 
             void fromJson(const QJsonObject &p_jobj);
 
+            void toBinary(QDataStream &p_stream) const;
+
+            void fromBinary(QDataStream &p_stream);
+
             QString m_name;
             ID m_id = Node::InvalidId;
             QDateTime m_createdTimeUtc;
@@ -91,6 +104,10 @@ namespace vnotex
 
             void fromJson(const QJsonObject &p_jobj);
 
+            void toBinary(QDataStream &p_stream) const;
+
+            void fromBinary(QDataStream &p_stream);
+
             QString m_name;
         };
 
@@ -108,6 +125,10 @@ namespace vnotex
 
             void fromJson(const QJsonObject &p_jobj);
 
+            QByteArray toBinary() const;
+
+            bool fromBinary(const QByteArray &p_data);
+
             QString m_version;
             ID m_id = Node::InvalidId;
             QDateTime m_createdTimeUtc;
@@ -134,13 +155,28 @@ namespace vnotex
             static const QString c_tags;
         };
 
+        // Cached binary form of one vx.json, validated by the stat of vx.json.
+        struct NodeConfigCacheEntry
+        {
+            qint64 m_configModifiedMsecs = 0;
+
+            qint64 m_configSize = 0;
+
+            // Serialized NodeConfig. May point into the mapped cache file.
+            QByteArray m_data;
+        };
+
         void createEmptyRootNode();
 
         QSharedPointer<VXNotebookConfigMgr::NodeConfig> readNodeConfig(const QString &p_path) const;
         void writeNodeConfig(const QString &p_path, const NodeConfig &p_config) const;
 
+        // Deferred to flush() within a batch.
         void writeNodeConfig(const Node *p_node);
 
+        // Forget pending writes of @p_node and its descendants.
+        void removeDirtyNodes(const Node *p_node);
+
         QSharedPointer<Node> nodeConfigToNode(const NodeConfig &p_config,
                                               const QString &p_name,
                                               Node *p_parent = nullptr) const;
@@ -186,11 +222,60 @@ namespace vnotex
 
         void inheritNodeFlags(const Node *p_node, Node *p_child) const;
 
+        QString getNodeConfigCacheFilePath() const;
+
+        // Map the cache file and index all its entries.
+        void loadNodeConfigCache() const;
+
+        // Write the cache file if it is changed.
+        void saveNodeConfigCache() const;
+
+        // Return false if there is no valid cache for @p_configPath.
+        bool readNodeConfigFromCache(const QString &p_configPath, NodeConfig &p_config) const;
+
+        void updateNodeConfigCache(const QString &p_configPath, const NodeConfig &p_config) const;
+
+        // Re-key or drop the cache of folder @p_folderPath and all its descendants.
+        // @p_newFolderPath: empty to drop.
+        void moveNodeConfigCache(const QString &p_folderPath, const QString &p_newFolderPath) const;
+
+        // Watch the valid cache of @p_configPath so that it could be used without a stat.
+        void trustNodeConfigCache(const QString &p_configPath) const;
+
+        void handleConfigFileChanged(const QString &p_filePath);
+
+        // Unwatch vx.json of folder @p_folderPath and all its descendants.
+        void unwatchConfigFiles(const QString &p_folderPath) const;
+
+        void unwatchAllConfigFiles();
+
         Info m_info;
 
+        // Container nodes whose config should be written on flush().
+        QSet<const Node *> m_dirtyNodes;
+
+        // Relative path of vx.json -> cache entry.
+        mutable QHash<QString, NodeConfigCacheEntry> m_nodeConfigCache;
+
+        // Mapped cache file backing entries loaded from disk.
+        mutable QScopedPointer<QFile> m_nodeConfigCacheFile;
+
+        mutable bool m_nodeConfigCacheLoaded = false;
+
+        mutable bool m_nodeConfigCacheDirty = false;
+
+        // Full path -> relative path of vx.json watched by FileWatcher.
+        mutable QHash<QString, QString> m_watchedConfigFiles;
+
+        // Relative paths of vx.json whose cache entry is valid until FileWatcher reports a change.
+        mutable QSet<QString> m_trustedConfigFiles;
+
         // Name of the node's config file.
         static const QString c_nodeConfigName;
 
+        // Name of the binary node config cache file within the notebook config folder.
+        static const QString c_nodeConfigCacheName;
+
         // Name of the recycle bin folder which should be a child of the root node.
         static const QString c_recycleBinFolderName;
     };
@@ -285,6 +285,19 @@ QSharedPointer<Notebook> NotebookMgr::findNotebookByRootFolderPath(const QString
     return nullptr;
 }
 
+QSharedPointer<Notebook> NotebookMgr::findNotebookContainingPath(const QString &p_path) const
+{
+    QSharedPointer<Notebook> notebook;
+    for (auto &nb : m_notebooks) {
+        if (PathUtils::pathContains(nb->getRootFolderPath(), p_path)
+            && (!notebook || nb->getRootFolderPath().size() > notebook->getRootFolderPath().size())) {
+            notebook = nb;
+        }
+    }
+
+    return notebook;
+}
+
 QSharedPointer<Notebook> NotebookMgr::findNotebookById(ID p_id) const
 {
     for (auto &nb : m_notebooks) {
@@ -311,6 +324,14 @@ void NotebookMgr::closeNotebook(ID p_id)
     auto notebookToClose = *it;
     emit notebookAboutToClose(notebookToClose.data());
 
+    try {
+        notebookToClose->getConfigMgr()->flush();
+    } catch (Exception &p_e) {
+        qWarning() << QString("failed to flush notebook %1 (%2) (%3)").arg(notebookToClose->getName(),
+                                                                         notebookToClose->getRootFolderPath(),
+                                                                         p_e.what());
+    }
+
     m_notebooks.erase(it);
 
     saveNotebooksToConfig();
@@ -322,6 +343,19 @@ void NotebookMgr::closeNotebook(ID p_id)
                                                          notebookToClose->getRootFolderPath());
 }
 
+void NotebookMgr::close()
+{
+    for (const auto &nb : m_notebooks) {
+        try {
+            nb->getConfigMgr()->flush();
+        } catch (Exception &p_e) {
+            qWarning() << QString("failed to flush notebook %1 (%2) (%3)").arg(nb->getName(),
+                                                                             nb->getRootFolderPath(),
+                                                                             p_e.what());
+        }
+    }
+}
+
 void NotebookMgr::removeNotebook(ID p_id)
 {
     auto it = std::find_if(m_notebooks.begin(),
@@ -63,8 +63,15 @@ namespace vnotex
 
         QSharedPointer<Notebook> findNotebookById(ID p_id) const;
 
+        // Find the notebook whose root folder contains @p_path.
+        // The innermost one is returned for nested notebooks.
+        QSharedPointer<Notebook> findNotebookContainingPath(const QString &p_path) const;
+
         void closeNotebook(ID p_id);
 
+        // Flush pending changes of all notebooks. Called on quit.
+        void close();
+
         void removeNotebook(ID p_id);
 
     public slots:
@@ -0,0 +1,226 @@
+#include "previewdiskcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrent>
+#include <QDebug>
+
+#include <algorithm>
+
+#include <utils/fileutils.h>
+#include <utils/pathutils.h>
+#include "configmgr.h"
+#include "exception.h"
+
+using namespace vnotex;
+
+// Magic of the cache entry file: "VXPC".
+static const quint32 c_entryMagic = 0x56585043;
+
+// Bump it when the layout of the entry file changes.
+static const quint32 c_entryVersion = 1;
+
+static const QDataStream::Version c_entryStreamVersion = QDataStream::Qt_5_12;
+
+// Size limit of the whole cache in bytes.
+static const qint64 c_maxSize = 128 * 1024 * 1024;
+
+// Evict down to this size to avoid evicting on every write.
+static const qint64 c_evictedSize = c_maxSize / 4 * 3;
+
+// Log the hit ratio every such lookups.
+static const int c_statsLogInterval = 200;
+
+PreviewDiskCache &PreviewDiskCache::getInst()
+{
+    static PreviewDiskCache cache;
+    return cache;
+}
+
+PreviewDiskCache::PreviewDiskCache()
+{
+    m_folderPath = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                  QStringLiteral("previews"));
+    m_threadPool.setMaxThreadCount(1);
+}
+
+PreviewDiskCache::~PreviewDiskCache()
+{
+    m_threadPool.waitForDone();
+}
+
+QString PreviewDiskCache::generateKey(const QString &p_lang,
+                                      const QString &p_text,
+                                      qreal p_scaleFactor,
+                                      const QString &p_theme,
+                                      QRgb p_background)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(p_lang.toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(p_text.toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(QByteArray::number(p_scaleFactor, 'f', 2));
+    hash.addData("\n", 1);
+    hash.addData(p_theme.toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(QByteArray::number(p_background, 16));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString PreviewDiskCache::getEntryFilePath(const QString &p_key) const
+{
+    // Spread entries into sub-folders by the first two characters.
+    return PathUtils::concatenateFilePath(PathUtils::concatenateFilePath(m_folderPath, p_key.left(2)), p_key);
+}
+
+bool PreviewDiskCache::get(const QString &p_key, Entry &p_entry)
+{
+    const auto filePath = getEntryFilePath(p_key);
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        recordLookup(false);
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(c_entryStreamVersion);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version >> p_entry.m_format >> p_entry.m_needScale >> p_entry.m_data;
+    file.close();
+
+    if (stream.status() != QDataStream::Ok
+        || magic != c_entryMagic
+        || version != c_entryVersion
+        || p_entry.m_data.isEmpty()) {
+        recordLookup(false);
+        return false;
+    }
+
+    recordLookup(true);
+
+    // Mark it as recently used for eviction.
+    QtConcurrent::run(&m_threadPool, [filePath]() {
+        QFile file(filePath);
+        if (file.open(QIODevice::ReadWrite)) {
+            file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+        }
+    });
+
+    return true;
+}
+
+void PreviewDiskCache::set(const QString &p_key, const Entry &p_entry)
+{
+    if (p_entry.m_data.isEmpty()) {
+        return;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(c_entryStreamVersion);
+        stream << c_entryMagic << c_entryVersion << p_entry.m_format << p_entry.m_needScale << p_entry.m_data;
+    }
+
+    const auto filePath = getEntryFilePath(p_key);
+    QtConcurrent::run(&m_threadPool, [this, filePath, data]() {
+        write(filePath, data);
+    });
+}
+
+void PreviewDiskCache::write(const QString &p_filePath, const QByteArray &p_data)
+{
+    try {
+        QDir().mkpath(PathUtils::parentDirPath(p_filePath));
+        // A partially written entry will be rejected by get(), so no need to write atomically.
+        FileUtils::writeFile(p_filePath, p_data);
+    } catch (Exception &p_e) {
+        qWarning() << "failed to write preview cache entry" << p_filePath << p_e.what();
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_totalSize == -1) {
+        // Count existing entries, including the new one.
+        m_totalSize = 0;
+        QDirIterator it(m_folderPath, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            it.next();
+            m_totalSize += it.fileInfo().size();
+        }
+    } else {
+        m_totalSize += p_data.size();
+    }
+
+    if (m_totalSize > c_maxSize) {
+        evict();
+    }
+}
+
+void PreviewDiskCache::evict()
+{
+    QVector<QFileInfo> entries;
+    QDirIterator it(m_folderPath, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        entries.push_back(it.fileInfo());
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const QFileInfo &p_a, const QFileInfo &p_b) {
+        return p_a.lastModified() < p_b.lastModified();
+    });
+
+    m_totalSize = 0;
+    for (const auto &entry : entries) {
+        m_totalSize += entry.size();
+    }
+
+    int cnt = 0;
+    for (const auto &entry : entries) {
+        if (m_totalSize <= c_evictedSize) {
+            break;
+        }
+
+        if (QFile::remove(entry.absoluteFilePath())) {
+            m_totalSize -= entry.size();
+            ++cnt;
+        }
+    }
+
+    qInfo() << "evicted" << cnt << "preview cache entries, size now" << m_totalSize;
+}
+
+void PreviewDiskCache::recordLookup(bool p_hit)
+{
+    // Lookups may happen in multiple threads.
+    if (p_hit) {
+        m_hitCount.fetchAndAddRelaxed(1);
+    } else {
+        m_missCount.fetchAndAddRelaxed(1);
+    }
+
+    const int hitCount = m_hitCount.load();
+    const int total = hitCount + m_missCount.load();
+    if (total % c_statsLogInterval == 0) {
+        qInfo() << "preview disk cache hits" << hitCount << "misses" << (total - hitCount)
+                << QString("(%1%)").arg(hitCount * 100 / total);
+    }
+}
+
+int PreviewDiskCache::getHitCount() const
+{
+    return m_hitCount.load();
+}
+
+int PreviewDiskCache::getMissCount() const
+{
+    return m_missCount.load();
+}
@@ -0,0 +1,81 @@
+#ifndef PREVIEWDISKCACHE_H
+#define PREVIEWDISKCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QColor>
+#include <QMutex>
+#include <QThreadPool>
+#include <QAtomicInt>
+
+namespace vnotex
+{
+    // Content-addressed disk cache of rendered graph and math previews, shared
+    // by all editors and kept across sessions.
+    // Least recently used entries are evicted once the cache exceeds its size limit.
+    class PreviewDiskCache
+    {
+    public:
+        struct Entry
+        {
+            // Format of @m_data, such as svg and png.
+            QString m_format;
+
+            QByteArray m_data;
+
+            bool m_needScale = false;
+        };
+
+        static PreviewDiskCache &getInst();
+
+        // Everything affecting the rendered result should be part of the key.
+        static QString generateKey(const QString &p_lang,
+                                   const QString &p_text,
+                                   qreal p_scaleFactor,
+                                   const QString &p_theme,
+                                   QRgb p_background);
+
+        // Thread-safe. Read the entry file, so better not call it in GUI thread.
+        bool get(const QString &p_key, Entry &p_entry);
+
+        // Write in background.
+        void set(const QString &p_key, const Entry &p_entry);
+
+        int getHitCount() const;
+
+        int getMissCount() const;
+
+    private:
+        PreviewDiskCache();
+
+        ~PreviewDiskCache();
+
+        QString getEntryFilePath(const QString &p_key) const;
+
+        // Called in the write thread.
+        void write(const QString &p_filePath, const QByteArray &p_data);
+
+        // Remove least recently used entries until the cache fits in the limit.
+        // Called in the write thread.
+        void evict();
+
+        void recordLookup(bool p_hit);
+
+        QString m_folderPath;
+
+        // One thread to write entries and evict in order.
+        QThreadPool m_threadPool;
+
+        // Protect m_totalSize.
+        QMutex m_mutex;
+
+        // Total size of the entries on disk. -1 if not counted yet.
+        qint64 m_totalSize = -1;
+
+        QAtomicInt m_hitCount;
+
+        QAtomicInt m_missCount;
+    };
+} // ns vnotex
+
+#endif // PREVIEWDISKCACHE_H
@@ -0,0 +1,9 @@
+SOURCES += \
+    $$PWD/searchindex.cpp \
+    $$PWD/searchindexmgr.cpp \
+    $$PWD/searchtokenizer.cpp
+
+HEADERS += \
+    $$PWD/searchindex.h \
+    $$PWD/searchindexmgr.h \
+    $$PWD/searchtokenizer.h
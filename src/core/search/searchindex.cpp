@@ -0,0 +1,496 @@
+#include "searchindex.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDataStream>
+#include <QtEndian>
+#include <QSet>
+#include <QDebug>
+
+#include <algorithm>
+#include <cmath>
+
+#include <utils/fileutils.h>
+#include <utils/pathutils.h>
+#include <exception.h>
+
+#include "searchtokenizer.h"
+
+using namespace vnotex;
+
+// Magic of the index file: "VXSI".
+static const quint32 c_indexMagic = 0x56585349;
+
+// Bump it when the layout of the index file or the tokenization changes.
+static const quint32 c_indexVersion = 2;
+
+static const QDataStream::Version c_indexStreamVersion = QDataStream::Qt_5_12;
+
+// Size of one posting in the mapped file: document ID and frequency.
+static const int c_postingSize = 8;
+
+// Minimum size of one document in the index file: path length, modified time and length.
+static const int c_minDocumentSize = 16;
+
+// Parameters of BM25.
+static const double c_bm25K1 = 1.2;
+
+static const double c_bm25B = 0.75;
+
+SearchIndex::SearchIndex(const QString &p_filePath)
+    : m_filePath(p_filePath)
+{
+}
+
+SearchIndex::~SearchIndex()
+{
+}
+
+void SearchIndex::unmap()
+{
+    m_mappedTerms.clear();
+    m_mappedPostings = nullptr;
+    m_mappedFile.reset();
+    m_unsavedData.clear();
+}
+
+void SearchIndex::clear()
+{
+    unmap();
+    m_documents.clear();
+    m_pathToDoc.clear();
+    m_terms.clear();
+    m_totalLength = 0;
+    m_dirty = true;
+}
+
+bool SearchIndex::isDirty() const
+{
+    return m_dirty;
+}
+
+bool SearchIndex::load()
+{
+    clear();
+    m_dirty = false;
+
+    if (m_filePath.isEmpty() || !QFileInfo::exists(m_filePath)) {
+        return false;
+    }
+
+    m_mappedFile.reset(new QFile(m_filePath));
+    const auto size = m_mappedFile->size();
+    uchar *mem = nullptr;
+    if (m_mappedFile->open(QIODevice::ReadOnly)) {
+        mem = m_mappedFile->map(0, size);
+    }
+    if (!mem) {
+        qWarning() << "failed to map search index" << m_filePath;
+        m_mappedFile.reset();
+        return false;
+    }
+
+    if (!parse(mem, size)) {
+        qWarning() << "discard invalid search index" << m_filePath;
+        clear();
+        return false;
+    }
+
+    m_dirty = false;
+    return true;
+}
+
+bool SearchIndex::parse(const uchar *p_data, qint64 p_size)
+{
+    const auto raw = QByteArray::fromRawData(reinterpret_cast<const char *>(p_data), p_size);
+    QDataStream stream(raw);
+    stream.setVersion(c_indexStreamVersion);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 docCnt = 0;
+    stream >> magic >> version >> docCnt;
+    if (stream.status() != QDataStream::Ok
+        || magic != c_indexMagic
+        || version != c_indexVersion) {
+        return false;
+    }
+
+    // Do not trust the count before allocating.
+    if (docCnt > (p_size - stream.device()->pos()) / c_minDocumentSize) {
+        return false;
+    }
+
+    m_documents.resize(docCnt);
+    for (quint32 i = 0; i < docCnt; ++i) {
+        auto &doc = m_documents[i];
+        stream >> doc.m_path >> doc.m_modifiedMsecs >> doc.m_length;
+        if (stream.status() != QDataStream::Ok) {
+            return false;
+        }
+        m_pathToDoc.insert(doc.m_path, i);
+        m_totalLength += doc.m_length;
+    }
+
+    quint32 termCnt = 0;
+    quint32 postingCnt = 0;
+    stream >> termCnt >> postingCnt;
+    m_mappedTerms.reserve(termCnt);
+    for (quint32 i = 0; i < termCnt; ++i) {
+        QString term;
+        MappedPostings postings;
+        stream >> term >> postings.m_start >> postings.m_count;
+        if (stream.status() != QDataStream::Ok
+            || postings.m_start + postings.m_count > postingCnt) {
+            return false;
+        }
+        m_mappedTerms.insert(term, postings);
+    }
+
+    const auto offset = stream.device()->pos();
+    if (stream.status() != QDataStream::Ok
+        || offset + static_cast<qint64>(postingCnt) * c_postingSize > p_size) {
+        return false;
+    }
+
+    m_mappedPostings = p_data + offset;
+
+    // Postings are used to index m_documents directly.
+    for (quint32 i = 0; i < postingCnt; ++i) {
+        if (qFromLittleEndian<quint32>(m_mappedPostings + static_cast<qint64>(i) * c_postingSize) >= docCnt) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SearchIndex::save()
+{
+    if (!m_dirty || m_filePath.isEmpty()) {
+        return;
+    }
+
+    // Compact IDs of live documents.
+    QVector<int> idMap(m_documents.size(), -1);
+    QVector<const Document *> docs;
+    docs.reserve(m_pathToDoc.size());
+    for (int i = 0; i < m_documents.size(); ++i) {
+        if (!m_documents[i].m_removed) {
+            idMap[i] = docs.size();
+            docs.push_back(&m_documents[i]);
+        }
+    }
+
+    auto terms = m_mappedTerms.keys();
+    for (auto it = m_terms.constBegin(); it != m_terms.constEnd(); ++it) {
+        if (!m_mappedTerms.contains(it.key())) {
+            terms.push_back(it.key());
+        }
+    }
+
+    // Postings are sorted by document ID within each term.
+    QByteArray postingData;
+    QVector<MappedPostings> termPostings(terms.size());
+    quint32 postingCnt = 0;
+    for (int i = 0; i < terms.size(); ++i) {
+        termPostings[i].m_start = postingCnt;
+        forEachPosting(terms[i], [&idMap, &postingData, &postingCnt](const Posting &p_posting) {
+            const int id = idMap[p_posting.m_docId];
+            if (id == -1) {
+                return;
+            }
+
+            char buf[c_postingSize];
+            qToLittleEndian<quint32>(id, buf);
+            qToLittleEndian<quint32>(p_posting.m_frequency, buf + 4);
+            postingData.append(buf, c_postingSize);
+            ++postingCnt;
+        });
+        termPostings[i].m_count = postingCnt - termPostings[i].m_start;
+    }
+
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setVersion(c_indexStreamVersion);
+        stream << c_indexMagic
+               << c_indexVersion
+               << static_cast<quint32>(docs.size());
+        for (const auto doc : docs) {
+            stream << doc->m_path << doc->m_modifiedMsecs << doc->m_length;
+        }
+
+        quint32 liveTermCnt = 0;
+        for (const auto &postings : termPostings) {
+            if (postings.m_count > 0) {
+                ++liveTermCnt;
+            }
+        }
+
+        stream << liveTermCnt << postingCnt;
+        for (int i = 0; i < terms.size(); ++i) {
+            if (termPostings[i].m_count > 0) {
+                stream << terms[i] << termPostings[i].m_start << termPostings[i].m_count;
+            }
+        }
+    }
+    data.append(postingData);
+
+    // Release the mapping before overwriting the file backing it.
+    unmap();
+
+    try {
+        QDir().mkpath(PathUtils::parentDirPath(m_filePath));
+        FileUtils::writeFileAtomically(m_filePath, data);
+    } catch (Exception &p_e) {
+        qWarning() << "failed to write search index" << m_filePath << p_e.what();
+
+        // Keep using the compacted index from memory and retry later.
+        clear();
+        m_unsavedData = data;
+        parse(reinterpret_cast<const uchar *>(m_unsavedData.constData()), m_unsavedData.size());
+        return;
+    }
+
+    // Map the compacted index.
+    if (!load()) {
+        qWarning() << "failed to reload search index" << m_filePath;
+    }
+}
+
+void SearchIndex::forEachPosting(const QString &p_term, const std::function<void(const Posting &)> &p_func) const
+{
+    auto mappedIt = m_mappedTerms.constFind(p_term);
+    if (mappedIt != m_mappedTerms.constEnd()) {
+        const uchar *data = m_mappedPostings + static_cast<qint64>(mappedIt->m_start) * c_postingSize;
+        for (quint32 i = 0; i < mappedIt->m_count; ++i, data += c_postingSize) {
+            Posting posting;
+            posting.m_docId = qFromLittleEndian<quint32>(data);
+            posting.m_frequency = qFromLittleEndian<quint32>(data + 4);
+            p_func(posting);
+        }
+    }
+
+    auto it = m_terms.constFind(p_term);
+    if (it != m_terms.constEnd()) {
+        for (const auto &posting : it.value()) {
+            p_func(posting);
+        }
+    }
+}
+
+SearchIndex::DocumentTerms SearchIndex::analyze(const QString &p_text)
+{
+    DocumentTerms terms;
+    const auto tokens = SearchTokenizer::tokenize(p_text);
+    terms.m_length = tokens.size();
+    for (const auto &token : tokens) {
+        ++terms.m_frequencies[token.m_term];
+    }
+    return terms;
+}
+
+void SearchIndex::updateDocument(const QString &p_path, qint64 p_modifiedMsecs, const DocumentTerms &p_terms)
+{
+    auto it = m_pathToDoc.find(p_path);
+    if (it != m_pathToDoc.end()) {
+        removeDocument(it.value());
+    }
+
+    const quint32 id = m_documents.size();
+    Document doc;
+    doc.m_path = p_path;
+    doc.m_modifiedMsecs = p_modifiedMsecs;
+    doc.m_length = p_terms.m_length;
+    m_documents.push_back(doc);
+    m_pathToDoc.insert(p_path, id);
+    m_totalLength += doc.m_length;
+
+    for (auto termIt = p_terms.m_frequencies.constBegin(); termIt != p_terms.m_frequencies.constEnd(); ++termIt) {
+        Posting posting;
+        posting.m_docId = id;
+        posting.m_frequency = termIt.value();
+        m_terms[termIt.key()].push_back(posting);
+    }
+
+    m_dirty = true;
+}
+
+void SearchIndex::removeDocument(int p_docId)
+{
+    auto &doc = m_documents[p_docId];
+    Q_ASSERT(!doc.m_removed);
+    doc.m_removed = true;
+    m_totalLength -= doc.m_length;
+    m_pathToDoc.remove(doc.m_path);
+    m_dirty = true;
+}
+
+void SearchIndex::removeDocuments(const QString &p_path)
+{
+    const auto paths = getDocumentPaths(p_path);
+    for (const auto &path : paths) {
+        removeDocument(m_pathToDoc.value(path));
+    }
+}
+
+void SearchIndex::renameDocuments(const QString &p_path, const QString &p_newPath)
+{
+    const auto paths = getDocumentPaths(p_path);
+    for (const auto &path : paths) {
+        const int id = m_pathToDoc.take(path);
+        auto &doc = m_documents[id];
+        doc.m_path = p_newPath + path.mid(p_path.size());
+        m_pathToDoc.insert(doc.m_path, id);
+    }
+
+    if (!paths.isEmpty()) {
+        m_dirty = true;
+    }
+}
+
+qint64 SearchIndex::getModifiedMsecs(const QString &p_path) const
+{
+    auto it = m_pathToDoc.constFind(p_path);
+    if (it == m_pathToDoc.constEnd()) {
+        return -1;
+    }
+
+    return m_documents[it.value()].m_modifiedMsecs;
+}
+
+QStringList SearchIndex::getDocumentPaths(const QString &p_path) const
+{
+    if (p_path.isEmpty()) {
+        return m_pathToDoc.keys();
+    }
+
+    QStringList paths;
+    if (m_pathToDoc.contains(p_path)) {
+        paths << p_path;
+    }
+
+    // Documents under a folder are adjacent in the sorted map.
+    const auto prefix = p_path + QLatin1Char('/');
+    for (auto it = m_pathToDoc.lowerBound(prefix);
+         it != m_pathToDoc.constEnd() && it.key().startsWith(prefix);
+         ++it) {
+        paths << it.key();
+    }
+    return paths;
+}
+
+int SearchIndex::getDocumentCount() const
+{
+    return m_pathToDoc.size();
+}
+
+QVector<SearchIndex::Result> SearchIndex::search(const QString &p_query, int p_maxResults) const
+{
+    QVector<Result> results;
+
+    QStringList terms;
+    {
+        QSet<QString> termSet;
+        for (const auto &token : SearchTokenizer::tokenize(p_query, true)) {
+            if (!termSet.contains(token.m_term)) {
+                termSet.insert(token.m_term);
+                terms << token.m_term;
+            }
+        }
+    }
+
+    const int docCnt = getDocumentCount();
+    if (terms.isEmpty() || docCnt == 0 || p_maxResults <= 0) {
+        return results;
+    }
+
+    // Live postings of each term.
+    QVector<QVector<Posting>> postingLists(terms.size());
+    for (int i = 0; i < terms.size(); ++i) {
+        auto &postings = postingLists[i];
+        forEachPosting(terms[i], [this, &postings](const Posting &p_posting) {
+            if (!m_documents[p_posting.m_docId].m_removed) {
+                postings.push_back(p_posting);
+            }
+        });
+
+        if (postings.isEmpty()) {
+            // No document contains all the terms.
+            return results;
+        }
+    }
+
+    // Start from the rarest term to keep the candidates few.
+    std::sort(postingLists.begin(), postingLists.end(),
+              [](const QVector<Posting> &p_a, const QVector<Posting> &p_b) {
+                  return p_a.size() < p_b.size();
+              });
+
+    const double avgLength = qMax(1.0, static_cast<double>(m_totalLength) / docCnt);
+
+    // Document ID -> (score, number of matched terms).
+    QHash<quint32, QPair<double, int>> candidates;
+    for (int i = 0; i < postingLists.size(); ++i) {
+        const auto &postings = postingLists[i];
+        const double df = postings.size();
+        const double idf = std::log(1 + (docCnt - df + 0.5) / (df + 0.5));
+        for (const auto &posting : postings) {
+            QPair<double, int> *candidate = nullptr;
+            if (i == 0) {
+                candidate = &candidates[posting.m_docId];
+            } else {
+                auto it = candidates.find(posting.m_docId);
+                if (it == candidates.end()) {
+                    continue;
+                }
+                candidate = &it.value();
+            }
+
+            const double tf = posting.m_frequency;
+            const double norm = 1 - c_bm25B + c_bm25B * m_documents[posting.m_docId].m_length / avgLength;
+            candidate->first += idf * tf * (c_bm25K1 + 1) / (tf + c_bm25K1 * norm);
+            ++candidate->second;
+        }
+    }
+
+    results.reserve(candidates.size());
+    for (auto it = candidates.constBegin(); it != candidates.constEnd(); ++it) {
+        if (it.value().second == postingLists.size()) {
+            Result result;
+            result.m_path = m_documents[it.key()].m_path;
+            result.m_score = it.value().first;
+            results.push_back(result);
+        }
+    }
+
+    const int cnt = qMin(p_maxResults, results.size());
+    std::partial_sort(results.begin(), results.begin() + cnt, results.end(),
+                      [](const Result &p_a, const Result &p_b) {
+                          return p_a.m_score > p_b.m_score;
+                      });
+    results.resize(cnt);
+    return results;
+}
+
+QString SearchIndex::generateSnippet(const QString &p_text, const QString &p_query, int p_length)
+{
+    int pos = -1;
+    for (const auto &token : SearchTokenizer::tokenize(p_query, true)) {
+        const int idx = p_text.indexOf(token.m_term, 0, Qt::CaseInsensitive);
+        if (idx != -1 && (pos == -1 || idx < pos)) {
+            pos = idx;
+        }
+    }
+
+    const int start = pos == -1 ? 0 : qMax(0, pos - p_length / 3);
+    auto snippet = p_text.mid(start, p_length).simplified();
+    if (start > 0) {
+        snippet.prepend(QStringLiteral("..."));
+    }
+    if (start + p_length < p_text.size()) {
+        snippet.append(QStringLiteral("..."));
+    }
+    return snippet;
+}
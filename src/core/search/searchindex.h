@@ -0,0 +1,149 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QScopedPointer>
+
+#include <functional>
+
+class QFile;
+
+namespace vnotex
+{
+    // Inverted index of the notes of one notebook.
+    // Postings of the index file are used in place via memory mapping, while
+    // changes since loading are kept in memory until save().
+    // Should be used in one thread, except analyze().
+    class SearchIndex
+    {
+    public:
+        // Term frequencies of one document.
+        struct DocumentTerms
+        {
+            QHash<QString, int> m_frequencies;
+
+            // Number of tokens.
+            int m_length = 0;
+        };
+
+        struct Result
+        {
+            // Relative path of the document.
+            QString m_path;
+
+            double m_score = 0;
+        };
+
+        // @p_filePath: index file. Empty to keep the index in memory only.
+        explicit SearchIndex(const QString &p_filePath = QString());
+
+        ~SearchIndex();
+
+        // Return false if there is no valid index file.
+        bool load();
+
+        // Write the index file if it is changed.
+        void save();
+
+        void clear();
+
+        bool isDirty() const;
+
+        // Thread-safe.
+        static DocumentTerms analyze(const QString &p_text);
+
+        // Add document @p_path or replace the existing one.
+        void updateDocument(const QString &p_path, qint64 p_modifiedMsecs, const DocumentTerms &p_terms);
+
+        // Remove document @p_path or all the documents under folder @p_path.
+        void removeDocuments(const QString &p_path);
+
+        // Re-key document @p_path or all the documents under folder @p_path.
+        void renameDocuments(const QString &p_path, const QString &p_newPath);
+
+        // Return -1 if @p_path is not indexed.
+        qint64 getModifiedMsecs(const QString &p_path) const;
+
+        // Paths of all the documents under folder @p_path. Empty @p_path for all.
+        QStringList getDocumentPaths(const QString &p_path = QString()) const;
+
+        int getDocumentCount() const;
+
+        // Return documents containing all the terms of @p_query, ranked by BM25.
+        QVector<Result> search(const QString &p_query, int p_maxResults) const;
+
+        // Return text around the first match of any term of @p_query in @p_text.
+        static QString generateSnippet(const QString &p_text, const QString &p_query, int p_length = 120);
+
+    private:
+        struct Document
+        {
+            QString m_path;
+
+            qint64 m_modifiedMsecs = 0;
+
+            int m_length = 0;
+
+            bool m_removed = false;
+        };
+
+        struct Posting
+        {
+            quint32 m_docId = 0;
+
+            quint32 m_frequency = 0;
+        };
+
+        // Postings of one term within the mapped file.
+        struct MappedPostings
+        {
+            // Index of the first posting.
+            quint32 m_start = 0;
+
+            quint32 m_count = 0;
+        };
+
+        // Call @p_func on all postings of @p_term, including those of removed documents.
+        void forEachPosting(const QString &p_term, const std::function<void(const Posting &)> &p_func) const;
+
+        void removeDocument(int p_docId);
+
+        // Read the index from @p_data, which should outlive the index.
+        bool parse(const uchar *p_data, qint64 p_size);
+
+        void unmap();
+
+        QString m_filePath;
+
+        // Document ID -> document. IDs of removed documents are not reused until save().
+        QVector<Document> m_documents;
+
+        // Path -> ID of live documents, sorted to look up documents under a folder.
+        QMap<QString, int> m_pathToDoc;
+
+        // Sum of the lengths of live documents.
+        qint64 m_totalLength = 0;
+
+        // Term -> postings within the mapped index file.
+        QHash<QString, MappedPostings> m_mappedTerms;
+
+        QScopedPointer<QFile> m_mappedFile;
+
+        // Postings array within the mapped index file.
+        const uchar *m_mappedPostings = nullptr;
+
+        // Compacted index kept in memory if it failed to be written.
+        QByteArray m_unsavedData;
+
+        // Term -> postings added since loading.
+        QHash<QString, QVector<Posting>> m_terms;
+
+        bool m_dirty = false;
+    };
+} // ns vnotex
+
+#endif // SEARCHINDEX_H
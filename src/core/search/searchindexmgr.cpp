@@ -0,0 +1,431 @@
+#include "searchindexmgr.h"
+
+#include <QTimer>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QDebug>
+
+#include <notebook/notebook.h>
+#include <notebook/node.h>
+#include <notebookbackend/inotebookbackend.h>
+#include <buffer/buffer.h>
+#include <utils/fileutils.h>
+#include <utils/pathutils.h>
+#include <exception.h>
+#include "vnotex.h"
+#include "notebookmgr.h"
+#include "buffermgr.h"
+#include "configmgr.h"
+#include "searchindex.h"
+
+using namespace vnotex;
+
+// Name of the folder of index files within the user cache folder.
+static const QString c_indexFolderName = QStringLiteral("search_indexes");
+
+// Number of notes read and analyzed in one background run.
+static const int c_batchSize = 500;
+
+// Interval in milliseconds to write changed indexes.
+static const int c_saveInterval = 30 * 1000;
+
+namespace
+{
+    // One note to check and index if changed.
+    struct Job
+    {
+        // Relative path of the note.
+        QString m_path;
+
+        QString m_filePath;
+
+        // Modified time of the note when indexed. -1 to index it anyway.
+        qint64 m_indexedMsecs = -1;
+
+        qint64 m_modifiedMsecs = 0;
+
+        // Whether the note is analyzed and m_terms is valid.
+        bool m_succeeded = false;
+
+        SearchIndex::DocumentTerms m_terms;
+    };
+
+    Job analyzeNote(Job p_job)
+    {
+        QFileInfo fi(p_job.m_filePath);
+        if (!fi.exists()) {
+            return p_job;
+        }
+
+        p_job.m_modifiedMsecs = fi.lastModified().toMSecsSinceEpoch();
+        if (p_job.m_modifiedMsecs == p_job.m_indexedMsecs) {
+            // Up to date.
+            return p_job;
+        }
+
+        try {
+            const auto content = FileUtils::readTextFile(p_job.m_filePath);
+            p_job.m_terms = SearchIndex::analyze(PathUtils::fileName(p_job.m_path) + QLatin1Char('\n') + content);
+            p_job.m_succeeded = true;
+        } catch (Exception &p_e) {
+            qWarning() << "failed to read note to index" << p_job.m_filePath << p_e.what();
+        }
+        return p_job;
+    }
+
+    // One search result to generate snippet for.
+    struct SnippetJob
+    {
+        QString m_filePath;
+
+        QString m_query;
+    };
+
+    QString generateSnippet(const SnippetJob &p_job)
+    {
+        try {
+            return SearchIndex::generateSnippet(FileUtils::readTextFile(p_job.m_filePath), p_job.m_query);
+        } catch (Exception &p_e) {
+            qWarning() << "failed to read note for snippet" << p_job.m_filePath << p_e.what();
+            return QString();
+        }
+    }
+}
+
+struct SearchIndexMgr::NotebookIndex
+{
+    Notebook *m_notebook = nullptr;
+
+    QSharedPointer<SearchIndex> m_index;
+
+    // Notes waiting to be checked and indexed.
+    QVector<Job> m_jobs;
+
+    QFutureWatcher<Job> m_watcher;
+
+    // Progress of current run.
+    int m_done = 0;
+
+    // Number of notes indexed in current run.
+    int m_updated = 0;
+
+    int m_total = 0;
+
+    QElapsedTimer m_timer;
+};
+
+SearchIndexMgr::SearchIndexMgr(QObject *p_parent)
+    : QObject(p_parent)
+{
+    m_saveTimer = new QTimer(this);
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(c_saveInterval);
+    connect(m_saveTimer, &QTimer::timeout,
+            this, &SearchIndexMgr::saveAll);
+}
+
+SearchIndexMgr::~SearchIndexMgr()
+{
+    close();
+}
+
+void SearchIndexMgr::init()
+{
+    auto &notebookMgr = VNoteX::getInst().getNotebookMgr();
+    connect(&notebookMgr, &NotebookMgr::notebookAboutToClose,
+            this, &SearchIndexMgr::dropIndex);
+    connect(&notebookMgr, &NotebookMgr::notebookAboutToRemove,
+            this, &SearchIndexMgr::dropIndex);
+
+    connect(&VNoteX::getInst().getBufferMgr(), &BufferMgr::bufferSaved,
+            this, &SearchIndexMgr::handleBufferSaved);
+}
+
+QString SearchIndexMgr::getIndexFilePath(const Notebook *p_notebook)
+{
+    // Keep it out of the notebook, which may be synced by other tools.
+    const auto rootFolderPath = QDir::cleanPath(p_notebook->getRootFolderPath());
+    const auto hash = QCryptographicHash::hash(rootFolderPath.toUtf8(), QCryptographicHash::Sha1).toHex();
+    const auto folderPath = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                           c_indexFolderName);
+    return PathUtils::concatenateFilePath(folderPath, QString::fromLatin1(hash) + QStringLiteral(".bin"));
+}
+
+SearchIndexMgr::NotebookIndex *SearchIndexMgr::fetchIndex(Notebook *p_notebook)
+{
+    auto it = m_indexes.find(p_notebook->getId());
+    if (it != m_indexes.end()) {
+        return it.value().data();
+    }
+
+    auto index = QSharedPointer<NotebookIndex>::create();
+    index->m_notebook = p_notebook;
+    index->m_index.reset(new SearchIndex(getIndexFilePath(p_notebook)));
+    index->m_index->load();
+    m_indexes.insert(p_notebook->getId(), index);
+
+    auto idx = index.data();
+    connect(&idx->m_watcher, &QFutureWatcher<Job>::finished,
+            this, [this, idx]() {
+                handleBatchFinished(idx);
+            });
+
+    connect(p_notebook, &Notebook::nodeAdded,
+            this, [this, idx](Node *p_node) {
+                syncNode(idx, p_node);
+            });
+    connect(p_notebook, &Notebook::nodeRemoved,
+            this, [this, idx](const QString &p_path) {
+                idx->m_index->removeDocuments(p_path);
+                scheduleSave();
+            });
+    connect(p_notebook, &Notebook::nodeRenamed,
+            this, [this, idx](Node *p_node, const QString &p_oldPath) {
+                idx->m_index->renameDocuments(p_oldPath, p_node->fetchPath());
+                scheduleSave();
+            });
+
+    // Catch up with changes made while the index is not loaded.
+    syncNode(idx, p_notebook->getRootNode().data());
+    return idx;
+}
+
+void SearchIndexMgr::dropIndex(const Notebook *p_notebook)
+{
+    auto index = m_indexes.take(p_notebook->getId());
+    if (!index) {
+        return;
+    }
+
+    disconnect(index->m_notebook, nullptr, this, nullptr);
+
+    index->m_jobs.clear();
+    index->m_watcher.cancel();
+    index->m_watcher.waitForFinished();
+
+    index->m_index->save();
+}
+
+void SearchIndexMgr::syncNode(NotebookIndex *p_index, Node *p_node)
+{
+    if (p_index->m_notebook->isNodeInRecycleBin(p_node)) {
+        return;
+    }
+
+    QSet<QString> paths;
+    collectJobs(p_index, p_node, paths);
+
+    // Drop notes removed outside.
+    if (p_node->isContainer()) {
+        const auto indexedPaths = p_index->m_index->getDocumentPaths(p_node->isRoot() ? QString() : p_node->fetchPath());
+        for (const auto &path : indexedPaths) {
+            if (!paths.contains(path)) {
+                p_index->m_index->removeDocuments(path);
+            }
+        }
+    }
+
+    startJobs(p_index);
+}
+
+void SearchIndexMgr::startJobs(NotebookIndex *p_index)
+{
+    if (p_index->m_watcher.isRunning()) {
+        // Will be picked up by next batch.
+        p_index->m_total = p_index->m_done + p_index->m_jobs.size();
+        return;
+    }
+
+    if (p_index->m_jobs.isEmpty()) {
+        scheduleSave();
+        return;
+    }
+
+    p_index->m_done = 0;
+    p_index->m_updated = 0;
+    p_index->m_total = p_index->m_jobs.size();
+    p_index->m_timer.start();
+    startNextBatch(p_index);
+}
+
+void SearchIndexMgr::collectJobs(NotebookIndex *p_index, Node *p_node, QSet<QString> &p_paths) const
+{
+    if (p_node->getUse() == Node::Use::RecycleBin) {
+        return;
+    }
+
+    if (p_node->hasContent()) {
+        // Files are checked in the worker thread.
+        Job job;
+        job.m_path = p_node->fetchPath();
+        job.m_filePath = p_node->fetchAbsolutePath();
+        job.m_indexedMsecs = p_index->m_index->getModifiedMsecs(job.m_path);
+        p_paths.insert(job.m_path);
+        p_index->m_jobs.push_back(job);
+    }
+
+    if (p_node->isContainer()) {
+        if (!p_node->isLoaded()) {
+            try {
+                p_node->load();
+            } catch (Exception &p_e) {
+                qWarning() << "failed to load node to index" << p_node->fetchPath() << p_e.what();
+                return;
+            }
+        }
+
+        for (const auto &child : p_node->getChildren()) {
+            collectJobs(p_index, child.data(), p_paths);
+        }
+    }
+}
+
+void SearchIndexMgr::startNextBatch(NotebookIndex *p_index)
+{
+    Q_ASSERT(!p_index->m_watcher.isRunning());
+    const int cnt = qMin(c_batchSize, p_index->m_jobs.size());
+    const auto batch = p_index->m_jobs.mid(p_index->m_jobs.size() - cnt);
+    p_index->m_jobs.resize(p_index->m_jobs.size() - cnt);
+    p_index->m_watcher.setFuture(QtConcurrent::mapped(batch, analyzeNote));
+}
+
+void SearchIndexMgr::handleBatchFinished(NotebookIndex *p_index)
+{
+    const auto future = p_index->m_watcher.future();
+    if (future.isCanceled()) {
+        return;
+    }
+
+    const auto jobs = future.results();
+    int updatedCnt = 0;
+    for (const auto &job : jobs) {
+        if (job.m_succeeded) {
+            p_index->m_index->updateDocument(job.m_path, job.m_modifiedMsecs, job.m_terms);
+            ++updatedCnt;
+        }
+    }
+    p_index->m_updated += updatedCnt;
+
+    p_index->m_done += jobs.size();
+    emit indexingProgressChanged(p_index->m_notebook, p_index->m_done, p_index->m_total);
+
+    if (!p_index->m_jobs.isEmpty()) {
+        startNextBatch(p_index);
+        return;
+    }
+
+    const auto elapsed = qMax<qint64>(p_index->m_timer.elapsed(), 1);
+    qInfo() << "checked" << p_index->m_done << "notes and indexed" << p_index->m_updated
+            << "of notebook" << p_index->m_notebook->getName()
+            << "in" << elapsed << "ms" << (p_index->m_done * 1000 / elapsed) << "notes/s";
+
+    emit indexUpdated(p_index->m_notebook);
+    scheduleSave();
+}
+
+bool SearchIndexMgr::isIndexing(const Notebook *p_notebook) const
+{
+    auto index = m_indexes.value(p_notebook->getId());
+    return index && index->m_watcher.isRunning();
+}
+
+QVector<SearchIndexMgr::Result> SearchIndexMgr::search(Notebook *p_notebook, const QString &p_query, int p_maxResults)
+{
+    QVector<Result> results;
+    auto index = fetchIndex(p_notebook);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const auto docs = index->m_index->search(p_query, p_maxResults);
+    results.reserve(docs.size());
+    for (const auto &doc : docs) {
+        Result result;
+        result.m_filePath = p_notebook->getBackend()->getFullPath(doc.m_path);
+        result.m_name = PathUtils::fileName(doc.m_path);
+        result.m_score = doc.m_score;
+        results.push_back(result);
+    }
+
+    qDebug() << "search" << p_query << "in notebook" << p_notebook->getName()
+             << "got" << results.size() << "results in" << timer.elapsed() << "ms";
+    return results;
+}
+
+QFuture<QString> SearchIndexMgr::generateSnippets(const QVector<Result> &p_results, const QString &p_query)
+{
+    QVector<SnippetJob> jobs;
+    jobs.reserve(p_results.size());
+    for (const auto &result : p_results) {
+        SnippetJob job;
+        job.m_filePath = result.m_filePath;
+        job.m_query = p_query;
+        jobs.push_back(job);
+    }
+    return QtConcurrent::mapped(jobs, generateSnippet);
+}
+
+void SearchIndexMgr::rebuild(Notebook *p_notebook)
+{
+    auto index = fetchIndex(p_notebook);
+
+    index->m_jobs.clear();
+    index->m_watcher.cancel();
+    index->m_watcher.waitForFinished();
+
+    index->m_index->clear();
+    syncNode(index, p_notebook->getRootNode().data());
+}
+
+void SearchIndexMgr::handleBufferSaved(Buffer *p_buffer)
+{
+    auto node = p_buffer->getNode();
+    if (!node) {
+        return;
+    }
+
+    auto index = m_indexes.value(node->getNotebook()->getId());
+    if (!index || index->m_notebook->isNodeInRecycleBin(node)) {
+        // Will be synced once loaded.
+        return;
+    }
+
+    // Analyze the saved file in the worker thread.
+    Job job;
+    job.m_path = node->fetchPath();
+    job.m_filePath = p_buffer->getContentPath();
+    index->m_jobs.push_back(job);
+    startJobs(index.data());
+}
+
+void SearchIndexMgr::scheduleSave()
+{
+    if (!m_saveTimer->isActive()) {
+        m_saveTimer->start();
+    }
+}
+
+void SearchIndexMgr::saveAll()
+{
+    for (const auto &index : m_indexes) {
+        index->m_index->save();
+    }
+}
+
+void SearchIndexMgr::close()
+{
+    m_saveTimer->stop();
+
+    for (const auto &index : m_indexes) {
+        index->m_jobs.clear();
+        index->m_watcher.cancel();
+        index->m_watcher.waitForFinished();
+    }
+
+    saveAll();
+}
@@ -0,0 +1,103 @@
+#ifndef SEARCHINDEXMGR_H
+#define SEARCHINDEXMGR_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QHash>
+#include <QVector>
+#include <QSet>
+#include <QFuture>
+
+#include "../global.h"
+
+class QTimer;
+
+namespace vnotex
+{
+    class Notebook;
+    class Node;
+    class Buffer;
+    class SearchIndex;
+
+    // Manage the full-text search indexes of notebooks.
+    // The index of a notebook is loaded on first search, brought up to date with
+    // the notes on disk in background, and then kept updated on buffer saves and
+    // node changes.
+    class SearchIndexMgr : public QObject
+    {
+        Q_OBJECT
+    public:
+        struct Result
+        {
+            // Absolute path of the note.
+            QString m_filePath;
+
+            QString m_name;
+
+            double m_score = 0;
+        };
+
+        explicit SearchIndexMgr(QObject *p_parent = nullptr);
+
+        ~SearchIndexMgr();
+
+        void init();
+
+        // Search notes of @p_notebook. Results may be incomplete while indexing.
+        // Snippets are not included. Use generateSnippets() to get them.
+        QVector<Result> search(Notebook *p_notebook, const QString &p_query, int p_maxResults = 100);
+
+        // Read the notes of @p_results and generate snippets in background.
+        // The i-th result of the future is the snippet of @p_results[i].
+        static QFuture<QString> generateSnippets(const QVector<Result> &p_results, const QString &p_query);
+
+        // Drop the index of @p_notebook and build it from scratch.
+        void rebuild(Notebook *p_notebook);
+
+        bool isIndexing(const Notebook *p_notebook) const;
+
+        // Write all the indexes. Called on quit.
+        void close();
+
+    signals:
+        // @p_total: number of notes to check in current run.
+        void indexingProgressChanged(const Notebook *p_notebook, int p_done, int p_total);
+
+        void indexUpdated(const Notebook *p_notebook);
+
+    private:
+        struct NotebookIndex;
+
+        NotebookIndex *fetchIndex(Notebook *p_notebook);
+
+        void dropIndex(const Notebook *p_notebook);
+
+        // Collect notes within @p_node to check and index if changed, and drop
+        // indexed notes that no longer exist.
+        void syncNode(NotebookIndex *p_index, Node *p_node);
+
+        // Start a run of the pending jobs if not running.
+        void startJobs(NotebookIndex *p_index);
+
+        void collectJobs(NotebookIndex *p_index, Node *p_node, QSet<QString> &p_paths) const;
+
+        void startNextBatch(NotebookIndex *p_index);
+
+        void handleBatchFinished(NotebookIndex *p_index);
+
+        void handleBufferSaved(Buffer *p_buffer);
+
+        void scheduleSave();
+
+        void saveAll();
+
+        static QString getIndexFilePath(const Notebook *p_notebook);
+
+        // Notebook ID -> index.
+        QHash<ID, QSharedPointer<NotebookIndex>> m_indexes;
+
+        QTimer *m_saveTimer = nullptr;
+    };
+} // ns vnotex
+
+#endif // SEARCHINDEXMGR_H
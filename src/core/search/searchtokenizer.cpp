@@ -0,0 +1,96 @@
+#include "searchtokenizer.h"
+
+using namespace vnotex;
+
+const int SearchTokenizer::c_maxTermLength = 64;
+
+bool SearchTokenizer::isCjk(uint p_ucs4)
+{
+    return (p_ucs4 >= 0x3040 && p_ucs4 <= 0x30ff)      // Hiragana and Katakana.
+           || (p_ucs4 >= 0x3400 && p_ucs4 <= 0x4dbf)   // CJK Unified Ideographs Extension A.
+           || (p_ucs4 >= 0x4e00 && p_ucs4 <= 0x9fff)   // CJK Unified Ideographs.
+           || (p_ucs4 >= 0xac00 && p_ucs4 <= 0xd7af)   // Hangul Syllables.
+           || (p_ucs4 >= 0xf900 && p_ucs4 <= 0xfaff)   // CJK Compatibility Ideographs.
+           || (p_ucs4 >= 0x20000 && p_ucs4 <= 0x2fa1f); // Supplementary ideographs.
+}
+
+QVector<SearchTokenizer::Token> SearchTokenizer::tokenize(const QString &p_text, bool p_isQuery)
+{
+    QVector<Token> tokens;
+
+    // Start offset of current word.
+    int wordStart = -1;
+
+    // Offsets of the CJK characters of current run, each of which may take two QChars.
+    QVector<int> cjkOffsets;
+
+    auto flushWord = [&tokens, &wordStart, &p_text](int p_end) {
+        if (wordStart == -1) {
+            return;
+        }
+
+        Token token;
+        token.m_term = p_text.mid(wordStart, qMin(p_end - wordStart, c_maxTermLength)).toCaseFolded();
+        token.m_offset = wordStart;
+        tokens.push_back(token);
+        wordStart = -1;
+    };
+
+    auto flushCjk = [&tokens, &cjkOffsets, &p_text, p_isQuery](int p_end) {
+        if (cjkOffsets.isEmpty()) {
+            return;
+        }
+
+        cjkOffsets.push_back(p_end);
+        const int cnt = cjkOffsets.size() - 1;
+        if (cnt == 1 || !p_isQuery) {
+            for (int i = 0; i < cnt; ++i) {
+                Token token;
+                token.m_term = p_text.mid(cjkOffsets[i], cjkOffsets[i + 1] - cjkOffsets[i]);
+                token.m_offset = cjkOffsets[i];
+                tokens.push_back(token);
+            }
+        }
+
+        if (cnt > 1) {
+            for (int i = 0; i + 1 < cnt; ++i) {
+                Token token;
+                token.m_term = p_text.mid(cjkOffsets[i], cjkOffsets[i + 2] - cjkOffsets[i]);
+                token.m_offset = cjkOffsets[i];
+                tokens.push_back(token);
+            }
+        }
+
+        cjkOffsets.clear();
+    };
+
+    const int len = p_text.size();
+    for (int i = 0; i < len;) {
+        uint ucs4 = p_text[i].unicode();
+        int charLen = 1;
+        if (p_text[i].isHighSurrogate() && i + 1 < len && p_text[i + 1].isLowSurrogate()) {
+            ucs4 = QChar::surrogateToUcs4(p_text[i], p_text[i + 1]);
+            charLen = 2;
+        }
+
+        if (isCjk(ucs4)) {
+            flushWord(i);
+            cjkOffsets.push_back(i);
+        } else if (QChar::isLetterOrNumber(ucs4) || ucs4 == '_') {
+            flushCjk(i);
+            if (wordStart == -1) {
+                wordStart = i;
+            }
+        } else {
+            flushWord(i);
+            flushCjk(i);
+        }
+
+        i += charLen;
+    }
+
+    flushWord(len);
+    flushCjk(len);
+
+    return tokens;
+}
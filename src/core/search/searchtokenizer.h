@@ -0,0 +1,40 @@
+#ifndef SEARCHTOKENIZER_H
+#define SEARCHTOKENIZER_H
+
+#include <QString>
+#include <QVector>
+
+namespace vnotex
+{
+    // Split text into search terms.
+    // Runs of letters and digits form case-folded words, while runs of CJK
+    // characters are split into overlapping bigrams since there are no spaces
+    // between words. Documents also get CJK unigrams so that a single character
+    // query could match.
+    class SearchTokenizer
+    {
+    public:
+        struct Token
+        {
+            QString m_term;
+
+            // Offset in the text.
+            int m_offset = 0;
+        };
+
+        SearchTokenizer() = delete;
+
+        // Thread-safe.
+        // @p_isQuery: CJK runs of a query are split into unigrams only if they
+        // have one character.
+        static QVector<Token> tokenize(const QString &p_text, bool p_isQuery = false);
+
+        static bool isCjk(uint p_ucs4);
+
+    private:
+        // Terms longer than this are truncated.
+        static const int c_maxTermLength;
+    };
+} // ns vnotex
+
+#endif // SEARCHTOKENIZER_H
@@ -6,8 +6,10 @@
 #include <widgets/mainwindow.h>
 #include "notebookmgr.h"
 #include "buffermgr.h"
+#include "search/searchindexmgr.h"
 #include "configmgr.h"
 #include "coreconfig.h"
+#include "filewatcher.h"
 
 #include "fileopenparameters.h"
 
@@ -23,12 +25,18 @@ VNoteX::VNoteX(QObject *p_parent)
 {
     m_instanceId = QRandomGenerator::global()->generate64();
 
+    // Construct FileWatcher before VNoteX is constructed so that it is destructed
+    // after VNoteX, whose buffers and notebooks unwatch files on destruction.
+    FileWatcher::getInst();
+
     initThemeMgr();
 
     initNotebookMgr();
 
     initBufferMgr();
 
+    initSearchIndexMgr();
+
     initDocsUtils();
 }
 
@@ -84,6 +92,21 @@ void VNoteX::initBufferMgr()
 
     connect(this, &VNoteX::openFileRequested,
             m_bufferMgr, QOverload<const QString &, const QSharedPointer<FileOpenParameters> &>::of(&BufferMgr::open));
+
+    // Connected before ViewArea to finish pending writes before any other handling.
+    connect(this, &VNoteX::nodeAboutToMove,
+            m_bufferMgr, &BufferMgr::waitForBackgroundSaves);
+    connect(this, &VNoteX::nodeAboutToRemove,
+            m_bufferMgr, &BufferMgr::waitForBackgroundSaves);
+    connect(this, &VNoteX::nodeAboutToRename,
+            m_bufferMgr, &BufferMgr::waitForBackgroundSaves);
+}
+
+void VNoteX::initSearchIndexMgr()
+{
+    Q_ASSERT(!m_searchIndexMgr);
+    m_searchIndexMgr = new SearchIndexMgr(this);
+    m_searchIndexMgr->init();
 }
 
 NotebookMgr &VNoteX::getNotebookMgr() const
@@ -96,6 +119,11 @@ BufferMgr &VNoteX::getBufferMgr() const
     return *m_bufferMgr;
 }
 
+SearchIndexMgr &VNoteX::getSearchIndexMgr() const
+{
+    return *m_searchIndexMgr;
+}
+
 void VNoteX::showStatusMessage(const QString &p_message, int timeoutMilliseconds)
 {
     emit statusMessageRequested(p_message, timeoutMilliseconds);
@@ -12,6 +12,7 @@ namespace vnotex
     class MainWindow;
     class NotebookMgr;
     class BufferMgr;
+    class SearchIndexMgr;
     class Node;
     struct FileOpenParameters;
     class Event;
@@ -43,6 +44,8 @@ namespace vnotex
 
         BufferMgr &getBufferMgr() const;
 
+        SearchIndexMgr &getSearchIndexMgr() const;
+
         ID getInstanceId() const;
 
     public slots:
@@ -106,6 +109,8 @@ namespace vnotex
 
         void initBufferMgr();
 
+        void initSearchIndexMgr();
+
         void initDocsUtils();
 
         MainWindow *m_mainWindow;
@@ -119,6 +124,9 @@ namespace vnotex
         // QObject managed.
         BufferMgr *m_bufferMgr;
 
+        // QObject managed.
+        SearchIndexMgr *m_searchIndexMgr = nullptr;
+
         // Used to identify app's instance.
         ID m_instanceId = 0;
     };
@@ -74,7 +74,7 @@ class GraphPreviewer {
                 let id = p_id;
                 let timeStamp = p_timeStamp;
                 return function(p_svgNode) {
-                    previewer.setGraphPreviewData(id, timeStamp, 'svg', p_svgNode.outerHTML, false, true);
+                    previewer.setGraphPreviewData(id, timeStamp, 'svg', p_svgNode ? p_svgNode.outerHTML : '', false, true);
                 };
             };
             this.vnotex.getWorker('graphviz').renderText(p_text, func(this, p_id, p_timeStamp));
@@ -163,20 +163,21 @@ class GraphPreviewer {
                 canvas.height = p_image.height;
                 canvas.width = p_image.width;
                 ctx.drawImage(p_image, 0, 0);
-                let dataUrl = null;
                 try {
-                    dataUrl = canvas.toDataURL();
+                    canvas.toBlob((p_blob) => {
+                        if (p_blob) {
+                            p_dataSetter(p_id, p_timeStamp, 'png', p_blob, false, false);
+                        } else {
+                            p_dataSetter(p_id, p_timeStamp);
+                        }
+                    });
                 } catch (err) {
                     // Tainted canvas may be caused by the <foreignObject> in SVG.
                     console.error('failed to draw image on canvas', err);
 
                     // Try simply using the SVG.
                     p_dataSetter(p_id, p_timeStamp, 'svg', p_svgNode.outerHTML, false, false);
-                    return;
                 }
-
-                let png = dataUrl ? dataUrl.substring(dataUrl.indexOf(',') + 1) : '';
-                p_dataSetter(p_id, p_timeStamp, 'png', png, true, false);
         });
     }
 
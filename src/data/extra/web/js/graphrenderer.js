@@ -22,7 +22,10 @@ class GraphRenderer extends VxWorker {
     }
 
     reset() {
-        this.graphIdx = 0;
+        // Keep graphs rendered before unique when only part of them is re-rendered.
+        if (!this.vnotex.getWorker('markdownit').isIncrementalRender()) {
+            this.graphIdx = 0;
+        }
         this.nodesToRender = [];
         this.numOfRenderedNodes = 0;
     }
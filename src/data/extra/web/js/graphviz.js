@@ -6,8 +6,13 @@ class Graphviz extends GraphRenderer {
 
         this.graphDivClass = 'vx-graphviz-graph';
 
-        this.extraScripts = [this.scriptFolderPath + '/viz.js/viz.js',
-                             this.scriptFolderPath + '/viz.js/lite.render.js'];
+        // Whether render with the local program instead of viz.js.
+        this.localRenderEnabled = !window.vxOptions.webGraphviz;
+
+        if (!this.localRenderEnabled) {
+            this.extraScripts = [this.scriptFolderPath + '/viz.js/viz.js',
+                                 this.scriptFolderPath + '/viz.js/lite.render.js'];
+        }
 
         this.viz = null;
 
@@ -27,7 +32,9 @@ class Graphviz extends GraphRenderer {
 
     initialize(p_callback) {
         return super.initialize(() => {
-            this.viz = new Viz();
+            if (!this.localRenderEnabled) {
+                this.viz = new Viz();
+            }
             p_callback();
         });
     }
@@ -70,7 +77,21 @@ class Graphviz extends GraphRenderer {
             };
         };
 
-        if (this.format === 'svg') {
+        if (this.localRenderEnabled) {
+            let callback = func(this, p_node);
+            this.vnotex.renderGraphLocally(this.name,
+                                           this.format,
+                                           p_node.textContent,
+                                           (p_format, p_data) => {
+                let element = Graphviz.dataToElement(p_format, p_data);
+                if (element) {
+                    callback(element);
+                } else {
+                    console.error('failed to render Graphviz locally');
+                    this.finishRenderingOne();
+                }
+            });
+        } else if (this.format === 'svg') {
             this.viz.renderSVGElement(p_node.textContent)
                 .then(func(this, p_node))
                 .catch(function(p_err) {
@@ -90,6 +111,13 @@ class Graphviz extends GraphRenderer {
     // Render a graph from @p_text in SVG format.
     // p_callback(svgNode).
     renderText(p_text, p_callback) {
+        if (this.localRenderEnabled) {
+            this.vnotex.renderGraphLocally(this.name, 'svg', p_text, (p_format, p_data) => {
+                p_callback(Graphviz.dataToElement(p_format, p_data));
+            });
+            return;
+        }
+
         let func = () => {
             this.viz.renderSVGElement(p_text)
                 .then(p_callback)
@@ -105,6 +133,26 @@ class Graphviz extends GraphRenderer {
 
         func();
     }
+
+    // Convert data rendered locally to an element. Return null if failed.
+    static dataToElement(p_format, p_data) {
+        if (!p_data) {
+            return null;
+        }
+
+        if (p_format === 'svg') {
+            let doc = new DOMParser().parseFromString(p_data, 'image/svg+xml');
+            let svgNode = doc.documentElement;
+            if (!svgNode || svgNode.nodeName !== 'svg') {
+                return null;
+            }
+            return document.importNode(svgNode, true);
+        }
+
+        let img = document.createElement('img');
+        img.src = 'data:image/' + p_format + ';base64,' + p_data;
+        return img;
+    }
 }
 
 window.vnotex.registerWorker(new Graphviz());
@@ -112,6 +112,16 @@ class MarkdownIt extends VxWorker {
         // Pre nodes collection.
         this.preNodes = null;
 
+        // Top-level blocks in current container, each led by a comment marker node.
+        // [{ marker, key, line }]. Null to render the whole text next time.
+        this.blocks = null;
+
+        // Top-level elements rendered in last round. Null if the whole container is rendered.
+        this.renderedRoots = null;
+
+        // Patterns of block HTML that could not be rendered alone.
+        this.fullRenderPatterns = [];
+
         this.codeNodesStore = new CodeNodeStoreByLang();
 
         this.codeNodesCollected = false;
@@ -272,37 +282,257 @@ class MarkdownIt extends VxWorker {
     // Render Markdown @p_text to HTML in @p_node.
     // @p_finishCbStr will be called after finishing loading new content nodes.
     // This could prevent Mermaid Gantt from negative width error.
+    // The whole text is parsed, but only the changed top-level blocks are replaced
+    // in the DOM and handed to other workers if possible.
     render(p_node, p_text, p_finishCbStr) {
         this.frontMatterNode = null;
         this.codeNodesStore.clearNodes();
         this.codeNodesCollected = false;
         this.headerIds[0].clear();
         this.headerIds[1].clear();
+        this.renderedRoots = null;
 
         if (p_node != this.lastContainerNode) {
             this.lastContainerNode = p_node;
-            this.preNodes = null;
+            this.blocks = null;
         }
 
         if (!p_text) {
             p_node.innerHTML = '';
+            this.blocks = null;
+            this.preNodes = p_node.getElementsByTagName('pre');
             this.finishWork();
             this.markdownRenderFinished();
             return;
         }
 
-        let html = this.mdit.render(p_text);
+        let startTime = performance.now();
+        let env = {};
+        let blocks = this.renderBlocks(this.mdit.parse(p_text, env), env);
+        let domStartTime = performance.now();
+        this.vnotex.addRenderTiming('markdownit.parse', domStartTime - startTime);
+
+        if (!this.blocks || this.renderChangedBlocks(p_node, blocks, p_finishCbStr) == -1) {
+            this.renderAllBlocks(p_node, blocks, p_finishCbStr);
+        }
+        this.vnotex.addRenderTiming('markdownit.dom', performance.now() - domStartTime);
+
+        this.finishWork();
+    }
+
+    // Split @p_tokens into top-level blocks and render each one.
+    // Return [{ key, html, line, needFullRender }].
+    renderBlocks(p_tokens, p_env) {
+        let blocks = [];
+        let start = 0;
+        for (let i = 0; i < p_tokens.length; ++i) {
+            let token = p_tokens[i];
+            if (token.level != 0 || token.nesting > 0) {
+                continue;
+            }
+
+            let slice = p_tokens.slice(start, i + 1);
+            let html = this.mdit.renderer.render(slice, this.mdit.options, p_env);
+
+            // Line numbers do not matter for the key since they are shifted in place.
+            let key = html.replace(/ data-source-line="\d+"/g, '');
+            let line = -1;
+            let hasHtml = false;
+            slice.forEach((p_token) => {
+                if (line == -1 && p_token.map) {
+                    line = p_token.map[0];
+                }
+                if (p_token.type == 'html_block') {
+                    hasHtml = true;
+                } else if (p_token.type == 'front_matter') {
+                    key += p_token.content;
+                }
+            });
+
+            blocks.push({
+                key: key,
+                html: html,
+                line: line,
+                // Raw HTML may be unbalanced across blocks.
+                needFullRender: hasHtml || this.fullRenderPatterns.some((p_pattern) => p_pattern.test(html))
+            });
+
+            start = i + 1;
+        }
+
+        return blocks;
+    }
+
+    // Comments do not affect styles.
+    static createBlockMarkerHtml() {
+        return '<!--vx-block-->';
+    }
+
+    static isBlockMarker(p_node) {
+        return p_node.nodeType == Node.COMMENT_NODE && p_node.data == 'vx-block';
+    }
+
+    renderAllBlocks(p_node, p_blocks, p_finishCbStr) {
+        let html = p_blocks.map((p_block) => MarkdownIt.createBlockMarkerHtml() + p_block.html).join('');
         p_node.innerHTML = html + this.loadedGuard(p_finishCbStr);
 
-        if (this.preNodes == null) {
-            this.preNodes = p_node.getElementsByTagName('pre');
+        this.preNodes = p_node.getElementsByTagName('pre');
+        this.renderedRoots = null;
+
+        // Markers nested in raw HTML could not be used.
+        let markers = Array.from(p_node.childNodes).filter((p_child) => MarkdownIt.isBlockMarker(p_child));
+        if (markers.length == p_blocks.length) {
+            this.blocks = p_blocks.map((p_block, p_idx) => {
+                return { marker: markers[p_idx], key: p_block.key, line: p_block.line };
+            });
+        } else {
+            this.blocks = null;
         }
 
         if (this.frontMatterNode) {
             p_node.insertAdjacentElement('afterbegin', this.frontMatterNode);
         }
+    }
 
-        this.finishWork();
+    // Replace the blocks between the common head and tail of old and new blocks.
+    // Return the number of blocks rendered or -1 if it needs a full render.
+    renderChangedBlocks(p_node, p_blocks, p_finishCbStr) {
+        let oldBlocks = this.blocks;
+        let head = 0;
+        while (head < oldBlocks.length && head < p_blocks.length
+               && oldBlocks[head].key == p_blocks[head].key) {
+            ++head;
+        }
+
+        let tail = 0;
+        while (tail < oldBlocks.length - head && tail < p_blocks.length - head
+               && oldBlocks[oldBlocks.length - 1 - tail].key == p_blocks[p_blocks.length - 1 - tail].key) {
+            ++tail;
+        }
+
+        let changedBlocks = p_blocks.slice(head, p_blocks.length - tail);
+        if (changedBlocks.some((p_block) => p_block.needFullRender)) {
+            return -1;
+        }
+
+        let oldEnd = oldBlocks.length - tail;
+        let endMarker = tail > 0 ? oldBlocks[oldEnd].marker : null;
+
+        // The loaded guard of last round has removed itself already.
+        if (head < oldEnd) {
+            let node = oldBlocks[head].marker;
+            while (node && node !== endMarker) {
+                let next = node.nextSibling;
+                p_node.removeChild(node);
+                node = next;
+            }
+        }
+
+        let tmpl = document.createElement('template');
+        tmpl.innerHTML = changedBlocks.map((p_block) => MarkdownIt.createBlockMarkerHtml() + p_block.html).join('');
+
+        let roots = [];
+        let markers = [];
+        Array.from(tmpl.content.childNodes).forEach((p_child) => {
+            if (MarkdownIt.isBlockMarker(p_child)) {
+                markers.push(p_child);
+            } else if (p_child.nodeType == Node.ELEMENT_NODE) {
+                roots.push(p_child);
+            }
+        });
+        console.assert(markers.length == changedBlocks.length, 'markers mismatch', markers.length, changedBlocks.length);
+
+        if (this.frontMatterNode && head == 0 && changedBlocks.length > 0) {
+            markers[0].parentNode.insertBefore(this.frontMatterNode, markers[0].nextSibling);
+            roots.unshift(this.frontMatterNode);
+        }
+
+        p_node.insertBefore(tmpl.content, endMarker);
+
+        // Shift the line numbers of the tail blocks.
+        for (let i = 0; i < tail; ++i) {
+            let oldBlock = oldBlocks[oldEnd + i];
+            let newBlock = p_blocks[p_blocks.length - tail + i];
+            if (oldBlock.line > -1 && newBlock.line > -1 && oldBlock.line != newBlock.line) {
+                this.shiftSourceLines(oldBlock.marker, newBlock.line - oldBlock.line);
+            }
+        }
+
+        let blocks = oldBlocks.slice(0, head);
+        changedBlocks.forEach((p_block, p_idx) => {
+            blocks.push({ marker: markers[p_idx], key: p_block.key, line: p_block.line });
+        });
+        for (let i = 0; i < tail; ++i) {
+            let oldBlock = oldBlocks[oldEnd + i];
+            blocks.push({ marker: oldBlock.marker, key: oldBlock.key, line: p_blocks[p_blocks.length - tail + i].line });
+        }
+        this.blocks = blocks;
+
+        p_node.insertAdjacentHTML('beforeend', this.loadedGuard(p_finishCbStr));
+
+        this.preNodes = [];
+        roots.forEach((p_root) => {
+            if (p_root.tagName == 'PRE') {
+                this.preNodes.push(p_root);
+            }
+            this.preNodes.push(...p_root.getElementsByTagName('pre'));
+        });
+        this.renderedRoots = roots;
+        return changedBlocks.length;
+    }
+
+    // Shift source line numbers of nodes of the block led by @p_marker by @p_delta.
+    shiftSourceLines(p_marker, p_delta) {
+        for (let node = p_marker.nextSibling; node && !MarkdownIt.isBlockMarker(node); node = node.nextSibling) {
+            if (node.nodeType != Node.ELEMENT_NODE) {
+                continue;
+            }
+
+            let nodes = Array.from(node.querySelectorAll('[data-source-line]'));
+            if (node.hasAttribute('data-source-line')) {
+                nodes.push(node);
+            }
+            nodes.forEach((p_node) => {
+                let line = parseInt(p_node.getAttribute('data-source-line')) + p_delta;
+                p_node.setAttribute('data-source-line', line);
+            });
+        }
+    }
+
+    // Whether last round only rendered part of the blocks.
+    isIncrementalRender() {
+        return this.renderedRoots != null;
+    }
+
+    // Return top-level nodes rendered in last round.
+    getRenderedRoots() {
+        return this.renderedRoots ? this.renderedRoots : [this.lastContainerNode];
+    }
+
+    // Return nodes of class @p_className rendered in last round.
+    getRenderedElementsByClassName(p_className) {
+        if (!this.renderedRoots) {
+            return Array.from(this.lastContainerNode.getElementsByClassName(p_className));
+        }
+
+        let nodes = [];
+        this.renderedRoots.forEach((p_root) => {
+            if (p_root.classList.contains(p_className)) {
+                nodes.push(p_root);
+            }
+            nodes.push(...p_root.getElementsByClassName(p_className));
+        });
+        return nodes;
+    }
+
+    // Render the whole text next time.
+    requestFullRender() {
+        this.blocks = null;
+    }
+
+    // Blocks with HTML matching @p_pattern will trigger a full render.
+    addFullRenderPattern(p_pattern) {
+        this.fullRenderPatterns.push(p_pattern);
     }
 
     loadedGuard(p_cbStr) {
@@ -324,7 +554,9 @@ class MarkdownIt extends VxWorker {
 
     // Will be called when basic markdown is rendered.
     markdownRenderFinished() {
-        window.vxImageViewer.setupForAllImages(this.lastContainerNode);
+        this.getRenderedRoots().forEach((p_root) => {
+            window.vxImageViewer.setupForAllImages(p_root);
+        });
         this.vnotex.setBasicMarkdownRendered();
     }
 
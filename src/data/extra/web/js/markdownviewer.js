@@ -11,6 +11,14 @@ new QWebChannel(qt.webChannelTransport,
             window.vnotex.setMarkdownText(p_text);
         });
 
+        adapter.textPatched.connect(function(p_firstLine, p_removedLineCount, p_insertedLines) {
+            window.vnotex.applyMarkdownTextPatch(p_firstLine, p_removedLineCount, p_insertedLines);
+        });
+
+        adapter.baseUrlUpdated.connect(function(p_url) {
+            window.vnotex.setBaseUrl(p_url);
+        });
+
         adapter.editLineNumberUpdated.connect(function(p_lineNumber) {
             window.vnotex.scrollToLine(p_lineNumber);
         });
@@ -43,6 +51,10 @@ new QWebChannel(qt.webChannelTransport,
             window.vnotex.findText(p_text, p_options);
         });
 
+        adapter.graphRendered.connect(function(p_id, p_format, p_data) {
+            window.vnotex.setLocallyRenderedGraph(p_id, p_format, p_data);
+        });
+
         console.log('QWebChannel has been set up');
         if (window.vnotex.initialized) {
             window.vnotex.kickOffMarkdown();
@@ -45,7 +45,11 @@ class MathJaxRenderer extends VxWorker {
             this.render(this.vnotex.contentContainer, 'tex-to-render');
         });
 
-        this.vnotex.getWorker('markdownit').addLangsToSkipHighlight(this.langs);
+        let markdownIt = this.vnotex.getWorker('markdownit');
+        markdownIt.addLangsToSkipHighlight(this.langs);
+
+        // Equation numbers and labels are counted from the beginning.
+        markdownIt.addFullRenderPattern(/\\(tag|label)\b|\\begin\{(equation|align|gather|multline|eqnarray|alignat)\}/);
     }
 
     initialize(p_callback) {
@@ -73,13 +77,13 @@ class MathJaxRenderer extends VxWorker {
         this.transformExtraNodes(p_node, p_className, extraNodes);
 
         // Collect nodes to render.
-        let nodes = p_node.getElementsByClassName(p_className);
+        let nodes = this.vnotex.getWorker('markdownit').getRenderedElementsByClassName(p_className);
         if (nodes.length == 0) {
             this.finishWork();
             return;
         }
 
-        this.nodesToRender = Array.from(nodes);
+        this.nodesToRender = nodes;
 
         if (!this.initialize(() => {
             this.renderNodes();
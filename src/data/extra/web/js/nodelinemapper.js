@@ -43,6 +43,7 @@ class NodeLineMapper {
     }
 
     updateHeadingNodes() {
+        let startTime = performance.now();
         this.headingNodes = this.container.querySelectorAll("h1, h2, h3, h4, h5, h6");
         let headings = [];
         let needSectionNumber = window.vxOptions.sectionNumberEnabled;
@@ -63,6 +64,8 @@ class NodeLineMapper {
         this.adapter.setSectionNumberEnabled(needSectionNumber);
 
         this.adapter.setHeadings(headings);
+
+        this.adapter.addRenderTiming('nodelinemapper.headings', performance.now() - startTime);
     }
 
     scrollToLine(p_lineNumber) {
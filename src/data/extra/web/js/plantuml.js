@@ -6,8 +6,13 @@ class PlantUml extends GraphRenderer {
 
         this.graphDivClass = 'vx-plantuml-graph';
 
-        this.extraScripts = [this.scriptFolderPath + '/plantuml/synchro2.js',
-                             this.scriptFolderPath + '/plantuml/zopfli.raw.min.js'];
+        // Whether render with the local program instead of the online server.
+        this.localRenderEnabled = !window.vxOptions.webPlantUml;
+
+        if (!this.localRenderEnabled) {
+            this.extraScripts = [this.scriptFolderPath + '/plantuml/synchro2.js',
+                                 this.scriptFolderPath + '/plantuml/zopfli.raw.min.js'];
+        }
 
         this.serverUrl = 'http://www.plantuml.com/plantuml';
 
@@ -49,6 +54,14 @@ class PlantUml extends GraphRenderer {
             };
         };
 
+        if (this.localRenderEnabled) {
+            this.vnotex.renderGraphLocally(this.name,
+                                           this.format,
+                                           p_node.textContent,
+                                           func(this, p_node));
+            return true;
+        }
+
         this.renderOnline(this.serverUrl,
                           this.format,
                           p_node.textContent,
@@ -59,6 +72,11 @@ class PlantUml extends GraphRenderer {
     // Render a graph from @p_text in SVG format.
     // p_callback(format, data).
     renderText(p_text, p_callback) {
+        if (this.localRenderEnabled) {
+            this.vnotex.renderGraphLocally(this.name, 'svg', p_text, p_callback);
+            return;
+        }
+
         let func = () => {
             this.renderOnline(this.serverUrl,
                               'svg',
@@ -120,7 +138,7 @@ class PlantUml extends GraphRenderer {
                 window.vxImageViewer.setupSVGToView(obj.children[0], false);
             } else {
                 obj = document.createElement('img');
-                obj.src = "data:image/" + p_format + ";base64, " + p_result;
+                obj.src = "data:image/" + p_format + ";base64," + p_result;
                 window.vxImageViewer.setupIMGToView(obj);
             }
 
@@ -85,7 +85,9 @@ class PrismRenderer extends VxWorker {
 
             p_containerNode.classList.add('line-numbers');
 
-            Prism.highlightAllUnder(p_containerNode, false /* async or not */);
+            this.vnotex.getWorker('markdownit').getRenderedRoots().forEach((p_root) => {
+                Prism.highlightAllUnder(p_root, false /* async or not */);
+            });
         }
 
         this.finishWork();
@@ -19,6 +19,42 @@ class Utils {
         xmlHttp.send(null);
     }
 
+    // @p_callback(p_succeeded).
+    static httpPost(p_url, p_data, p_callback) {
+        let xmlHttp = new XMLHttpRequest();
+        xmlHttp.open("POST", p_url);
+
+        xmlHttp.onload = function() {
+            p_callback(xmlHttp.status >= 200 && xmlHttp.status < 300);
+        };
+
+        xmlHttp.onerror = function() {
+            p_callback(false);
+        };
+
+        xmlHttp.send(p_data);
+    }
+
+    static base64ToBytes(p_base64) {
+        let str = atob(p_base64);
+        let bytes = new Uint8Array(str.length);
+        for (let i = 0; i < str.length; ++i) {
+            bytes[i] = str.charCodeAt(i);
+        }
+        return bytes;
+    }
+
+    // @p_callback(p_base64).
+    static blobToBase64(p_blob, p_callback) {
+        let reader = new FileReader();
+        reader.onload = function() {
+            let dataUrl = reader.result;
+            p_callback(dataUrl.substring(dataUrl.indexOf(',') + 1));
+        };
+
+        reader.readAsDataURL(p_blob);
+    }
+
     static loadScript(p_src, p_callback) {
         let script = document.createElement('script');
         if (p_callback) {
@@ -25,6 +25,16 @@ class VNoteX extends EventEmitter {
 
         this.numOfOngoingWorkers = 0;
 
+        // Latest Markdown text from cpp side, which patches apply to.
+        this.markdownText = null;
+
+        // Time when the pending text is received, in ms since epoch.
+        this.textReceivedTime = 0;
+
+        // Timings of current round of rendering, reported to cpp side once finished.
+        // { receivedTime, startTime, stages: [{ name, time }] }.
+        this.renderStats = null;
+
         this.pendingData = {
             text: null,
             lineNumber: -1,
@@ -39,6 +49,12 @@ class VNoteX extends EventEmitter {
 
         this.sectionNumberBaseLevel = 2;
 
+        // Callbacks of graphs rendered at cpp side.
+        // id -> callback.
+        this.localRenderCallbacks = new Map();
+
+        this.lastLocalRenderId = 0;
+
         window.addEventListener('load', () => {
             console.log('window load finished');
 
@@ -54,6 +70,20 @@ class VNoteX extends EventEmitter {
 
             this.searcher = new MarkJs(this, this.contentContainer);
 
+            // In-page anchors will navigate away once the base URL differs from the page URL.
+            this.contentContainer.addEventListener('click', (p_event) => {
+                let link = p_event.target.closest('a');
+                if (!link || !document.querySelector('base')) {
+                    return;
+                }
+
+                let href = link.getAttribute('href');
+                if (href && href.startsWith('#')) {
+                    p_event.preventDefault();
+                    this.nodeLineMapper.scrollToAnchor(decodeURIComponent(href.substring(1)));
+                }
+            });
+
             this.sectionNumberBaseLevel = window.vxOptions.sectionNumberBaseLevel;
             if (this.sectionNumberBaseLevel > 3) {
                 console.warn('only support section number base level less than 3', this.sectionNumberBaseLevel);
@@ -75,8 +105,15 @@ class VNoteX extends EventEmitter {
     }
 
     finishWorker(p_name) {
+        // Time from the start of the round to the finish of each worker.
+        if (this.renderStats) {
+            this.addRenderTiming(p_name, performance.now() - this.renderStats.startTime);
+        }
+
         --this.numOfOngoingWorkers;
         if (this.numOfOngoingWorkers == 0) {
+            this.reportRenderStats();
+
             // Signal out anyway.
             this.emit('fullMarkdownRendered');
 
@@ -104,19 +141,78 @@ class VNoteX extends EventEmitter {
         window.vxMarkdownAdapter.setReady(true);
     }
 
-    setMarkdownText(p_text) {
+    setMarkdownText(p_text, p_receivedTime = Date.now()) {
+        this.markdownText = p_text;
         if (this.numOfOngoingWorkers > 0) {
             this.pendingData.text = p_text;
+            if (!this.textReceivedTime) {
+                this.textReceivedTime = p_receivedTime;
+            }
             console.info('wait for last render finish with remaing workers',
                          this.numOfOngoingWorkers);
         } else {
             this.numOfOngoingWorkers = this.workers.size;
             this.pendingData.text = null;
+            this.renderStats = {
+                receivedTime: this.textReceivedTime ? this.textReceivedTime : p_receivedTime,
+                startTime: performance.now(),
+                stages: []
+            };
+            this.textReceivedTime = 0;
             console.log('start new round with ' + this.numOfOngoingWorkers + ' workers');
             this.emit('markdownTextUpdated', p_text);
         }
     }
 
+    // Resolve relative URLs against @p_url, which should be set before the text.
+    setBaseUrl(p_url) {
+        let baseNode = document.querySelector('base');
+        if (!baseNode) {
+            baseNode = document.createElement('base');
+            document.head.insertAdjacentElement('afterbegin', baseNode);
+        }
+        baseNode.href = p_url;
+
+        // Resources loaded against the old base should be reloaded.
+        this.getWorker('markdownit').requestFullRender();
+    }
+
+    // Replace @p_removedLineCount lines from @p_firstLine with @p_insertedLines.
+    applyMarkdownTextPatch(p_firstLine, p_removedLineCount, p_insertedLines) {
+        if (this.markdownText === null) {
+            console.error('no Markdown text to patch');
+            return;
+        }
+
+        let receivedTime = Date.now();
+        let lines = this.markdownText.split('\n');
+        lines.splice(p_firstLine, p_removedLineCount, ...p_insertedLines);
+        this.setMarkdownText(lines.join('\n'), receivedTime);
+    }
+
+    // Record the time cost of stage @p_name of current round in ms.
+    addRenderTiming(p_name, p_time) {
+        if (this.renderStats) {
+            this.renderStats.stages.push({ name: p_name, time: Math.round(p_time) });
+        }
+    }
+
+    reportRenderStats() {
+        let stats = this.renderStats;
+        this.renderStats = null;
+        if (!stats) {
+            return;
+        }
+
+        let totalTime = performance.now() - stats.startTime;
+        window.vxMarkdownAdapter.setRenderStats({
+            receivedTime: stats.receivedTime,
+            waitTime: Math.round(performance.timeOrigin + stats.startTime - stats.receivedTime),
+            totalTime: Math.round(totalTime),
+            stages: stats.stages
+        });
+    }
+
     scrollToLine(p_lineNumber) {
         if (p_lineNumber < 0) {
             return;
@@ -182,22 +278,87 @@ class VNoteX extends EventEmitter {
         }
     }
 
+    // @p_data.data could be a string or a Blob.
     setGraphPreviewData(p_data) {
-        window.vxMarkdownAdapter.setGraphPreviewData(p_data.id,
-                                                     p_data.timeStamp,
-                                                     p_data.format,
-                                                     p_data.data,
-                                                     p_data.base64,
-                                                     p_data.needScale);
+        this.postPreviewData('graph', p_data, (p_data) => {
+            window.vxMarkdownAdapter.setGraphPreviewData(p_data.id,
+                                                         p_data.timeStamp,
+                                                         p_data.format,
+                                                         p_data.data,
+                                                         p_data.base64,
+                                                         p_data.needScale);
+        });
     }
 
+    // @p_data.data could be a string or a Blob.
     setMathPreviewData(p_data) {
-        window.vxMarkdownAdapter.setMathPreviewData(p_data.id,
-                                                    p_data.timeStamp,
-                                                    p_data.format,
-                                                    p_data.data,
-                                                    p_data.base64,
-                                                    p_data.needScale);
+        this.postPreviewData('math', p_data, (p_data) => {
+            window.vxMarkdownAdapter.setMathPreviewData(p_data.id,
+                                                        p_data.timeStamp,
+                                                        p_data.format,
+                                                        p_data.data,
+                                                        p_data.base64,
+                                                        p_data.needScale);
+        });
+    }
+
+    // Post the data in binary to the endpoint of the adapter to avoid passing
+    // it as a string through the web channel.
+    // Fall back to @p_channelSetter if not available.
+    postPreviewData(p_kind, p_data, p_channelSetter) {
+        let url = window.vxMarkdownAdapter.previewDataUrl;
+        let fallback = () => {
+            if (p_data.data instanceof Blob) {
+                Utils.blobToBase64(p_data.data, (p_base64) => {
+                    p_data.data = p_base64;
+                    p_data.base64 = true;
+                    p_channelSetter(p_data);
+                });
+            } else {
+                p_channelSetter(p_data);
+            }
+        };
+
+        if (!url || !p_data.data) {
+            fallback();
+            return;
+        }
+
+        let body = p_data.data;
+        if (!(body instanceof Blob)) {
+            body = p_data.base64 ? Utils.base64ToBytes(body) : new Blob([body]);
+        }
+
+        url += p_kind
+               + '?id=' + p_data.id
+               + '&timeStamp=' + p_data.timeStamp
+               + '&format=' + encodeURIComponent(p_data.format)
+               + '&needScale=' + (p_data.needScale ? 1 : 0);
+        Utils.httpPost(url, body, (p_succeeded) => {
+            if (!p_succeeded) {
+                console.warn('failed to post preview data', url);
+                fallback();
+            }
+        });
+    }
+
+    // Render a graph of @p_lang with the local program at cpp side.
+    // p_callback(format, data). @data is empty on failure and in Base64 if
+    // @format is not svg.
+    renderGraphLocally(p_lang, p_format, p_text, p_callback) {
+        let id = ++this.lastLocalRenderId;
+        this.localRenderCallbacks.set(id, p_callback);
+        window.vxMarkdownAdapter.renderGraph(id, p_lang, p_format, p_text);
+    }
+
+    setLocallyRenderedGraph(p_id, p_format, p_data) {
+        let callback = this.localRenderCallbacks.get(p_id);
+        if (!callback) {
+            return;
+        }
+
+        this.localRenderCallbacks.delete(p_id);
+        callback(p_format, p_data);
     }
 
     setHeadings(p_headings) {
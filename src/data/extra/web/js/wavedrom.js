@@ -12,6 +12,13 @@ class WaveDromRenderer extends GraphRenderer {
         this.langs = ['wavedrom', 'wave'];
     }
 
+    registerInternal() {
+        super.registerInternal();
+
+        // Graph index should start from 0 or style will be missing.
+        this.vnotex.getWorker('markdownit').addFullRenderPattern(/class="lang-(wavedrom|wave)"/);
+    }
+
     // Render @p_node as WaveDrom graph.
     // Return true on success.
     renderOne(p_node, p_idx) {
@@ -2,7 +2,7 @@ lessThan(QT_MAJOR_VERSION, 5): error("requires Qt 5 and above")
 
 equals(QT_MAJOR_VERSION, 5):lessThan(QT_MINOR_VERSION, 12): error("requires Qt 5.12 and above")
 
-QT += core gui widgets webenginewidgets webchannel network svg printsupport
+QT += core gui widgets webenginewidgets webchannel concurrent network svg printsupport
 
 CONFIG -= qtquickcompiler
 
@@ -4,12 +4,24 @@
 #include <QMimeDatabase>
 #include <QDateTime>
 #include <QTemporaryFile>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <limits>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "../core/exception.h"
 #include "pathutils.h"
 
 using namespace vnotex;
 
+// Files larger than this will be decoded from memory map.
+static const qint64 c_mapFileSize = 8 * 1024 * 1024;
+
 QByteArray FileUtils::readFile(const QString &p_filePath)
 {
     QFile file(p_filePath);
@@ -29,6 +41,21 @@ QString FileUtils::readTextFile(const QString &p_filePath)
                             QString("failed to read file: %1").arg(p_filePath));
     }
 
+    const auto size = file.size();
+    if (size >= c_mapFileSize && size <= std::numeric_limits<int>::max()) {
+        // Decode from the mapped pages directly to save a copy of the whole file.
+        auto data = file.map(0, size);
+        if (data) {
+            auto text = QString::fromUtf8(reinterpret_cast<const char *>(data), static_cast<int>(size));
+            file.unmap(data);
+            file.close();
+
+            // Drop all '\r' as Text mode does, including the lone ones.
+            text.remove(QLatin1Char('\r'));
+            return text;
+        }
+    }
+
     QString text(file.readAll());
     file.close();
     return text;
@@ -59,6 +86,72 @@ void FileUtils::writeFile(const QString &p_filePath, const QString &p_text)
     file.close();
 }
 
+void FileUtils::writeFileAtomically(const QString &p_filePath,
+                                    const QByteArray &p_data,
+                                    bool p_syncDir)
+{
+    // QSaveFile writes to a temporary file and syncs it to disk before renaming.
+    QSaveFile file(p_filePath);
+    // Write in place if we could not create a temporary file there.
+    file.setDirectWriteFallback(true);
+    if (!file.open(QIODevice::WriteOnly)) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1").arg(p_filePath));
+    }
+
+    if (file.write(p_data) != p_data.size() || !file.commit()) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1 (%2)").arg(p_filePath, file.errorString()));
+    }
+
+    if (p_syncDir) {
+        syncDir(PathUtils::parentDirPath(p_filePath));
+    }
+}
+
+void FileUtils::writeFileAtomically(const QString &p_filePath,
+                                    const QString &p_text,
+                                    bool p_syncDir)
+{
+    QSaveFile file(p_filePath);
+    file.setDirectWriteFallback(true);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1").arg(p_filePath));
+    }
+
+    QTextStream stream(&file);
+    stream << p_text;
+    stream.flush();
+    if (stream.status() != QTextStream::Ok || !file.commit()) {
+        Exception::throwOne(Exception::Type::FailToWriteFile,
+                            QString("failed to write to file: %1 (%2)").arg(p_filePath, file.errorString()));
+    }
+
+    if (p_syncDir) {
+        syncDir(PathUtils::parentDirPath(p_filePath));
+    }
+}
+
+void FileUtils::syncDir(const QString &p_dirPath)
+{
+#if defined(Q_OS_UNIX)
+    int fd = ::open(QFile::encodeName(p_dirPath).constData(), O_RDONLY);
+    if (fd == -1) {
+        qWarning() << "failed to open directory to sync" << p_dirPath;
+        return;
+    }
+
+    if (::fsync(fd) != 0) {
+        qWarning() << "failed to sync directory" << p_dirPath;
+    }
+
+    ::close(fd);
+#else
+    Q_UNUSED(p_dirPath);
+#endif
+}
+
 void FileUtils::renameFile(const QString &p_path, const QString &p_name)
 {
     Q_ASSERT(PathUtils::isLegalFileName(p_name));
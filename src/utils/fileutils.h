@@ -23,6 +23,21 @@ namespace vnotex
 
         static void writeFile(const QString &p_filePath, const QString &p_text);
 
+        // Write to a temporary file in the same directory, sync it to disk and then
+        // rename it to @p_filePath. @p_filePath holds either the old or the new content
+        // even if we crash halfway.
+        // @p_syncDir: sync the parent directory to make the rename itself durable.
+        static void writeFileAtomically(const QString &p_filePath,
+                                        const QByteArray &p_data,
+                                        bool p_syncDir = false);
+
+        static void writeFileAtomically(const QString &p_filePath,
+                                        const QString &p_text,
+                                        bool p_syncDir = false);
+
+        // Flush directory entries of @p_dirPath to disk. No-op on platforms without support.
+        static void syncDir(const QString &p_dirPath);
+
         // Rename file or dir.
         static void renameFile(const QString &p_path, const QString &p_name);
 
@@ -4,6 +4,44 @@
 
 using namespace vnotex;
 
+static void increaseSectionNumber(QVector<int> &p_sectionNumber, int p_level, int p_baseLevel)
+{
+    Q_ASSERT(p_level >= 1 && p_level < p_sectionNumber.size());
+    if (p_level < p_baseLevel) {
+        p_sectionNumber.fill(0);
+        return;
+    }
+
+    ++p_sectionNumber[p_level];
+    for (int i = p_level + 1; i < p_sectionNumber.size(); ++i) {
+        p_sectionNumber[i] = 0;
+    }
+}
+
+static QString joinSectionNumberStr(const QVector<int> &p_sectionNumber, bool p_endingDot)
+{
+    QString res;
+    for (auto sec : p_sectionNumber) {
+        if (sec != 0) {
+            if (res.isEmpty()) {
+                res = QString::number(sec);
+            } else {
+                res += '.' + QString::number(sec);
+            }
+        } else if (res.isEmpty()) {
+            continue;
+        } else {
+            break;
+        }
+    }
+
+    if (p_endingDot && !res.isEmpty()) {
+        return res + '.';
+    } else {
+        return res;
+    }
+}
+
 QString TextUtils::removeCodeBlockFence(const QString &p_text)
 {
     auto text = unindentTextMultiLines(p_text);
@@ -85,3 +123,55 @@ QString TextUtils::purifyUrl(const QString &p_url)
 
     return p_url;
 }
+
+bool TextUtils::diffLines(const QString &p_old,
+                          const QString &p_new,
+                          int &p_firstLine,
+                          int &p_removedLineCount,
+                          QStringList &p_insertedLines)
+{
+    if (p_old == p_new) {
+        return false;
+    }
+
+    const auto oldLines = p_old.splitRef(QLatin1Char('\n'));
+    const auto newLines = p_new.splitRef(QLatin1Char('\n'));
+    const int minCnt = qMin(oldLines.size(), newLines.size());
+
+    int prefix = 0;
+    while (prefix < minCnt && oldLines[prefix] == newLines[prefix]) {
+        ++prefix;
+    }
+
+    int suffix = 0;
+    while (suffix < minCnt - prefix
+           && oldLines[oldLines.size() - 1 - suffix] == newLines[newLines.size() - 1 - suffix]) {
+        ++suffix;
+    }
+
+    p_firstLine = prefix;
+    p_removedLineCount = oldLines.size() - suffix - prefix;
+    p_insertedLines.clear();
+    for (int i = prefix; i < newLines.size() - suffix; ++i) {
+        p_insertedLines << newLines[i].toString();
+    }
+    return true;
+}
+
+QStringList TextUtils::generateSectionNumbers(const QVector<int> &p_levels,
+                                              int p_baseLevel,
+                                              bool p_endingDot,
+                                              int p_first)
+{
+    QStringList numbers;
+    numbers.reserve(qMax(p_levels.size() - p_first, 0));
+    QVector<int> sectionNumber(7, 0);
+    for (int i = 0; i < p_levels.size(); ++i) {
+        increaseSectionNumber(sectionNumber, p_levels[i], p_baseLevel);
+        // Headings before @p_first are only counted.
+        if (i >= p_first) {
+            numbers << joinSectionNumberStr(sectionNumber, p_endingDot);
+        }
+    }
+    return numbers;
+}
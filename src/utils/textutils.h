@@ -2,6 +2,8 @@
 #define TEXTUTILS_H
 
 #include <QString>
+#include <QStringList>
+#include <QVector>
 
 namespace vnotex
 {
@@ -23,6 +25,22 @@ namespace vnotex
 
         // Remove query in the url (?xxx).
         static QString purifyUrl(const QString &p_url);
+
+        // Diff @p_new against @p_old by lines: lines [@p_firstLine, @p_firstLine + @p_removedLineCount)
+        // of @p_old are replaced by @p_insertedLines.
+        // Return false if they are the same.
+        static bool diffLines(const QString &p_old,
+                              const QString &p_new,
+                              int &p_firstLine,
+                              int &p_removedLineCount,
+                              QStringList &p_insertedLines);
+
+        // Generate section numbers, like "1.2" or "1.2." if @p_endingDot, of headings of
+        // @p_levels from @p_first on. Headings above @p_baseLevel get an empty one.
+        static QStringList generateSectionNumbers(const QVector<int> &p_levels,
+                                                  int p_baseLevel,
+                                                  bool p_endingDot,
+                                                  int p_first = 0);
     };
 }
 
@@ -85,9 +85,9 @@ QString Utils::pickAvailableFontFamily(const QStringList &p_families)
     return QString();
 }
 
-QPixmap Utils::svgToPixmap(const QByteArray &p_content,
-                           QRgb p_background,
-                           qreal p_scaleFactor)
+QImage Utils::svgToImage(const QByteArray &p_content,
+                         QRgb p_background,
+                         qreal p_scaleFactor)
 {
     QSvgRenderer renderer(p_content);
     QSize deSz = renderer.defaultSize();
@@ -95,17 +95,17 @@ QPixmap Utils::svgToPixmap(const QByteArray &p_content,
         deSz *= p_scaleFactor;
     }
 
-    QPixmap pm(deSz);
+    QImage img(deSz, QImage::Format_ARGB32_Premultiplied);
     if (p_background == 0x0) {
         // Fill a transparent background to avoid glitchy preview.
-        pm.fill(QColor(255, 255, 255, 0));
+        img.fill(QColor(255, 255, 255, 0));
     } else {
-        pm.fill(p_background);
+        img.fill(p_background);
     }
 
-    QPainter painter(&pm);
+    QPainter painter(&img);
     renderer.render(&painter);
-    return pm;
+    return img;
 }
 
 bool Utils::fuzzyEqual(qreal p_a, qreal p_b)
@@ -43,9 +43,10 @@ namespace vnotex
 
         static QString pickAvailableFontFamily(const QStringList &p_families);
 
-        static QPixmap svgToPixmap(const QByteArray &p_content,
-                                   QRgb p_background,
-                                   qreal p_scaleFactor);
+        // Could be called in non-GUI threads.
+        static QImage svgToImage(const QByteArray &p_content,
+                                 QRgb p_background,
+                                 qreal p_scaleFactor);
 
         static bool fuzzyEqual(qreal p_a, qreal p_b);
 
@@ -0,0 +1,303 @@
+#include "folderimporter.h"
+
+#include <QDir>
+#include <QThread>
+#include <QTimer>
+#include <QEventLoop>
+#include <QtConcurrent>
+#include <QDebug>
+
+#include <notebook/notebook.h>
+#include <notebookconfigmgr/inotebookconfigmgr.h>
+#include <core/exception.h>
+#include <utils/utils.h>
+#include "importfolderutils.h"
+#include "legacynotebookutils.h"
+
+using namespace vnotex;
+
+// Interval in milliseconds to report progress.
+static const int c_progressInterval = 100;
+
+FolderImporter::FolderImporter(const QString &p_folderPath,
+                               Mode p_mode,
+                               const QStringList &p_suffixes,
+                               QObject *p_parent)
+    : QObject(p_parent),
+      m_mode(p_mode),
+      m_suffixes(p_suffixes),
+      m_root(QSharedPointer<FolderEntry>::create())
+{
+    m_root->m_path = p_folderPath;
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+}
+
+FolderImporter::~FolderImporter()
+{
+    cancel();
+    m_threadPool.waitForDone();
+}
+
+bool FolderImporter::isCanceled() const
+{
+    return m_canceled.loadAcquire() != 0;
+}
+
+void FolderImporter::cancel()
+{
+    m_canceled.storeRelease(1);
+
+    QMutexLocker locker(&m_mutex);
+    m_queueCondition.wakeAll();
+}
+
+bool FolderImporter::scan(const Notebook *p_notebook, const Node *p_node)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    m_notebook = p_notebook;
+    m_node = p_node;
+
+    m_queue.clear();
+    m_queue.push_back(m_root.data());
+    m_pendingFolders = 1;
+    m_entryCount.storeRelease(0);
+
+    for (int i = 0; i < m_threadPool.maxThreadCount(); ++i) {
+        QtConcurrent::run(&m_threadPool, [this]() {
+            runWorker();
+        });
+    }
+
+    if (!m_threadPool.waitForDone(c_progressInterval)) {
+        // Keep the event loop running for progress and cancellation.
+        QEventLoop loop;
+        QTimer pollTimer;
+        pollTimer.setInterval(c_progressInterval);
+        connect(&pollTimer, &QTimer::timeout,
+                &loop, [this, &loop]() {
+                    emit progressChanged(m_entryCount.loadAcquire(), 0);
+                    if (m_threadPool.waitForDone(0)) {
+                        loop.quit();
+                    }
+                });
+        pollTimer.start();
+        loop.exec();
+    }
+
+    const auto elapsed = qMax<qint64>(timer.elapsed(), 1);
+    const int cnt = m_entryCount.loadAcquire();
+    qInfo() << "scanned" << cnt << "entries of" << m_root->m_path
+            << "in" << elapsed << "ms" << (cnt * 1000 / elapsed) << "entries/s"
+            << (isCanceled() ? "(canceled)" : "");
+
+    return !isCanceled();
+}
+
+void FolderImporter::runWorker()
+{
+    QMutexLocker locker(&m_mutex);
+    while (true) {
+        while (m_queue.isEmpty() && m_pendingFolders > 0 && !isCanceled()) {
+            m_queueCondition.wait(&m_mutex);
+        }
+
+        if (m_queue.isEmpty() || isCanceled()) {
+            break;
+        }
+
+        // Take the most recently found folder to walk depth-first and keep the queue short.
+        auto folder = m_queue.takeLast();
+        locker.unlock();
+
+        const auto subFolders = scanFolder(folder);
+
+        locker.relock();
+        m_queue += subFolders;
+        m_pendingFolders += subFolders.size() - 1;
+        if (!subFolders.isEmpty() || m_pendingFolders == 0) {
+            m_queueCondition.wakeAll();
+        }
+    }
+}
+
+QVector<FolderImporter::FolderEntry *> FolderImporter::scanFolder(FolderEntry *p_folder)
+{
+    switch (m_mode) {
+    case Mode::Suffixes:
+        return scanFolderBySuffixes(p_folder);
+
+    case Mode::LegacyConfig:
+        return scanFolderByLegacyConfig(p_folder);
+    }
+
+    return QVector<FolderEntry *>();
+}
+
+QVector<FolderImporter::FolderEntry *> FolderImporter::scanFolderBySuffixes(FolderEntry *p_folder)
+{
+    QVector<FolderEntry *> subFolders;
+
+    QDir dir(p_folder->m_path);
+    const auto children = dir.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+    for (const auto &child : children) {
+        Entry entry;
+        if (child.isDir()) {
+            if (isBuiltInFolder(child.fileName())) {
+                continue;
+            }
+
+            entry.m_folder = QSharedPointer<FolderEntry>::create();
+            entry.m_folder->m_path = child.absoluteFilePath();
+            subFolders.push_back(entry.m_folder.data());
+        } else if (!m_suffixes.contains(child.suffix()) || isBuiltInFile(child.fileName())) {
+            continue;
+        }
+
+        entry.m_name = child.fileName();
+        p_folder->m_children.push_back(entry);
+    }
+
+    m_entryCount.fetchAndAddRelaxed(p_folder->m_children.size());
+    return subFolders;
+}
+
+QVector<FolderImporter::FolderEntry *> FolderImporter::scanFolderByLegacyConfig(FolderEntry *p_folder)
+{
+    QVector<FolderEntry *> subFolders;
+
+    QDir dir(p_folder->m_path);
+    const auto config = LegacyNotebookUtils::getFolderConfig(p_folder->m_path);
+
+    // Folders.
+    LegacyNotebookUtils::forEachFolder(config, [this, &dir, p_folder, &subFolders](const QString &name) {
+                if (!dir.exists(name)) {
+                    p_folder->m_errors << ImportFolderUtilsTranslate::tr("Folder (%1) does not exist.").arg(name);
+                    return;
+                }
+
+                if (isBuiltInFolder(name)) {
+                    p_folder->m_errors << ImportFolderUtilsTranslate::tr("Folder (%1) conflicts with built-in folder.").arg(name);
+                    return;
+                }
+
+                Entry entry;
+                entry.m_name = name;
+                entry.m_paras.m_createdTimeUtc = LegacyNotebookUtils::getCreatedTimeUtcOfFolder(dir.filePath(name));
+                entry.m_folder = QSharedPointer<FolderEntry>::create();
+                entry.m_folder->m_path = dir.filePath(name);
+                subFolders.push_back(entry.m_folder.data());
+                p_folder->m_children.push_back(entry);
+            });
+
+    // Files.
+    LegacyNotebookUtils::forEachFile(config, [this, &dir, p_folder](const LegacyNotebookUtils::FileInfo &info) {
+                if (!dir.exists(info.m_name)) {
+                    p_folder->m_errors << ImportFolderUtilsTranslate::tr("File (%1) does not exist.").arg(info.m_name);
+                    return;
+                }
+
+                if (isBuiltInFile(info.m_name)) {
+                    p_folder->m_errors << ImportFolderUtilsTranslate::tr("File (%1) conflicts with built-in file.").arg(info.m_name);
+                    return;
+                }
+
+                Entry entry;
+                entry.m_name = info.m_name;
+                entry.m_paras.m_createdTimeUtc = info.m_createdTimeUtc;
+                entry.m_paras.m_modifiedTimeUtc = info.m_modifiedTimeUtc;
+                entry.m_paras.m_attachmentFolder = info.m_attachmentFolder;
+                entry.m_paras.m_tags = info.m_tags;
+                p_folder->m_children.push_back(entry);
+            });
+
+    m_entryCount.fetchAndAddRelaxed(p_folder->m_children.size());
+    return subFolders;
+}
+
+bool FolderImporter::isBuiltInFolder(const QString &p_name) const
+{
+    // Nodes of nested folders are not created yet, so all levels are checked against m_node.
+    return m_notebook->isBuiltInFolder(m_node, p_name);
+}
+
+bool FolderImporter::isBuiltInFile(const QString &p_name) const
+{
+    return m_notebook->isBuiltInFile(m_node, p_name);
+}
+
+void FolderImporter::commit(Notebook *p_notebook, Node *p_node, QString &p_errMsg)
+{
+    if (isCanceled()) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_committedCount = 0;
+    m_progressTimer.start();
+    emit progressChanged(0, m_entryCount.loadAcquire());
+
+    {
+        // Write each config once after all children are added.
+        NotebookConfigMgrBatch batch(p_notebook->getConfigMgr().data());
+        commitFolder(p_notebook, p_node, *m_root, p_errMsg);
+    }
+
+    const auto elapsed = qMax<qint64>(timer.elapsed(), 1);
+    qInfo() << "committed" << m_committedCount << "entries of" << m_root->m_path
+            << "in" << elapsed << "ms" << (m_committedCount * 1000 / elapsed) << "entries/s"
+            << (isCanceled() ? "(canceled)" : "");
+}
+
+void FolderImporter::commitFolder(Notebook *p_notebook,
+                                  Node *p_node,
+                                  const FolderEntry &p_folder,
+                                  QString &p_errMsg)
+{
+    for (const auto &err : p_folder.m_errors) {
+        Utils::appendMsg(p_errMsg, err);
+    }
+
+    const bool isLegacy = m_mode == Mode::LegacyConfig;
+    if (isLegacy) {
+        LegacyNotebookUtils::removeFolderConfigFile(p_folder.m_path);
+    }
+
+    for (const auto &child : p_folder.m_children) {
+        if (isCanceled()) {
+            return;
+        }
+
+        entryCommitted();
+
+        if (child.m_folder) {
+            QSharedPointer<Node> node;
+            try {
+                node = p_notebook->addAsNode(p_node, Node::Flag::Container, child.m_name, child.m_paras);
+            } catch (Exception &p_e) {
+                Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Failed to add folder (%1) as node (%2).").arg(child.m_name, p_e.what()));
+                continue;
+            }
+
+            commitFolder(p_notebook, node.data(), *child.m_folder, p_errMsg);
+        } else {
+            try {
+                p_notebook->addAsNode(p_node, Node::Flag::Content, child.m_name, child.m_paras);
+            } catch (Exception &p_e) {
+                Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Failed to add file (%1) as node (%2).").arg(child.m_name, p_e.what()));
+            }
+        }
+    }
+}
+
+void FolderImporter::entryCommitted()
+{
+    ++m_committedCount;
+    if (m_progressTimer.elapsed() >= c_progressInterval) {
+        m_progressTimer.restart();
+        emit progressChanged(m_committedCount, m_entryCount.loadAcquire());
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef FOLDERIMPORTER_H
+#define FOLDERIMPORTER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QSharedPointer>
+#include <QVector>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+#include <notebook/node.h>
+
+namespace vnotex
+{
+    class Notebook;
+
+    // Import the contents of a folder into a notebook.
+    // The folder tree is scanned by a pool of threads without touching the notebook,
+    // then committed to the notebook in one batch on the calling thread.
+    class FolderImporter : public QObject
+    {
+        Q_OBJECT
+    public:
+        enum class Mode
+        {
+            // Import all folders and files matching given suffixes.
+            Suffixes,
+            // Import folders and files recorded in the legacy notebook configs.
+            LegacyConfig
+        };
+
+        FolderImporter(const QString &p_folderPath,
+                       Mode p_mode,
+                       const QStringList &p_suffixes = QStringList(),
+                       QObject *p_parent = nullptr);
+
+        ~FolderImporter();
+
+        // Scan the folder tree in the background while keeping the event loop running.
+        // Built-in folders and files of @p_notebook are skipped.
+        // @p_node: the node to import into, which is the node of the folder.
+        // Return false if canceled.
+        bool scan(const Notebook *p_notebook, const Node *p_node);
+
+        // Add scanned folders and files as children of @p_node in one batch.
+        // @p_node has already been added.
+        void commit(Notebook *p_notebook, Node *p_node, QString &p_errMsg);
+
+        bool isCanceled() const;
+
+    public slots:
+        void cancel();
+
+    signals:
+        // @p_total: 0 during scanning.
+        void progressChanged(int p_done, int p_total);
+
+    private:
+        struct FolderEntry;
+
+        // A child folder or file.
+        struct Entry
+        {
+            QString m_name;
+
+            NodeParameters m_paras;
+
+            // Null for a file.
+            QSharedPointer<FolderEntry> m_folder;
+        };
+
+        struct FolderEntry
+        {
+            QString m_path;
+
+            QVector<Entry> m_children;
+
+            // Errors found during scanning.
+            QStringList m_errors;
+        };
+
+        // Worker loop fetching folders to scan from the shared queue.
+        void runWorker();
+
+        // Fill @p_folder and return its child folders to scan.
+        QVector<FolderEntry *> scanFolder(FolderEntry *p_folder);
+
+        QVector<FolderEntry *> scanFolderBySuffixes(FolderEntry *p_folder);
+
+        QVector<FolderEntry *> scanFolderByLegacyConfig(FolderEntry *p_folder);
+
+        bool isBuiltInFolder(const QString &p_name) const;
+
+        bool isBuiltInFile(const QString &p_name) const;
+
+        void commitFolder(Notebook *p_notebook,
+                          Node *p_node,
+                          const FolderEntry &p_folder,
+                          QString &p_errMsg);
+
+        void entryCommitted();
+
+        const Mode m_mode;
+
+        const QStringList m_suffixes;
+
+        QSharedPointer<FolderEntry> m_root;
+
+        // Only read by the workers during scan().
+        const Notebook *m_notebook = nullptr;
+
+        const Node *m_node = nullptr;
+
+        QThreadPool m_threadPool;
+
+        // Protect m_queue and m_pendingFolders.
+        QMutex m_mutex;
+
+        QWaitCondition m_queueCondition;
+
+        // Folders waiting to be scanned.
+        QVector<FolderEntry *> m_queue;
+
+        // Folders queued or being scanned.
+        int m_pendingFolders = 0;
+
+        QAtomicInt m_canceled = 0;
+
+        // Number of entries found by scan().
+        QAtomicInt m_entryCount = 0;
+
+        // Number of entries handled by commit().
+        int m_committedCount = 0;
+
+        QElapsedTimer m_progressTimer;
+    };
+} // ns vnotex
+
+#endif // FOLDERIMPORTER_H
@@ -98,7 +98,8 @@ bool ImportFolderDialog::importFolder()
     ImportFolderUtils::importFolderContents(nb,
                                             m_newNode.data(),
                                             m_filterWidget->getSuffixes(),
-                                            errMsg);
+                                            errMsg,
+                                            this);
 
     emit nb->nodeUpdated(m_parentNode);
 
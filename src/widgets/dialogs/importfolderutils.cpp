@@ -1,106 +1,74 @@
 #include "importfolderutils.h"
 
+#include <QProgressDialog>
+#include <QScopedPointer>
+
 #include <notebook/notebook.h>
-#include <core/exception.h>
-#include <QCoreApplication>
-#include "legacynotebookutils.h"
 #include <utils/utils.h>
+#include "folderimporter.h"
 
 using namespace vnotex;
 
 void ImportFolderUtils::importFolderContents(Notebook *p_notebook,
                                              Node *p_node,
                                              const QStringList &p_suffixes,
-                                             QString &p_errMsg)
+                                             QString &p_errMsg,
+                                             QWidget *p_progressParent)
 {
-    auto rootDir = p_node->toDir();
-    auto children = rootDir.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot | QDir::NoSymLinks);
-    for (const auto &child : children) {
-        if (child.isDir()) {
-            if (p_notebook->isBuiltInFolder(p_node, child.fileName())) {
-                continue;
-            }
-
-            QSharedPointer<Node> node;
-            try {
-                node = p_notebook->addAsNode(p_node, Node::Flag::Container, child.fileName(), NodeParameters());
-            } catch (Exception &p_e) {
-                Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Failed to add folder (%1) as node (%2).").arg(child.fileName(), p_e.what()));
-                continue;
-            }
-
-            importFolderContents(p_notebook, node.data(), p_suffixes, p_errMsg);
-        } else if (!p_notebook->isBuiltInFile(p_node, child.fileName())) {
-            if (p_suffixes.contains(child.suffix())) {
-                try {
-                    p_notebook->addAsNode(p_node, Node::Flag::Content, child.fileName(), NodeParameters());
-                } catch (Exception &p_e) {
-                    Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Failed to add file (%1) as node (%2).").arg(child.filePath(), p_e.what()));
-                }
-            }
-        }
-    }
+    FolderImporter importer(p_node->fetchAbsolutePath(), FolderImporter::Mode::Suffixes, p_suffixes);
+    runImporter(importer, p_notebook, p_node, p_errMsg, p_progressParent);
 }
 
 void ImportFolderUtils::importFolderContentsByLegacyConfig(Notebook *p_notebook,
                                                            Node *p_node,
-                                                           QString &p_errMsg)
+                                                           QString &p_errMsg,
+                                                           QWidget *p_progressParent)
 {
-    auto rootDir = p_node->toDir();
-
-    const auto config = LegacyNotebookUtils::getFolderConfig(rootDir.absolutePath());
-
-    // Remove the config file.
-    LegacyNotebookUtils::removeFolderConfigFile(rootDir.absolutePath());
-
-    // Folders.
-    LegacyNotebookUtils::forEachFolder(config, [&rootDir, p_notebook, p_node, &p_errMsg](const QString &name) {
-                if (!rootDir.exists(name)) {
-                    Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Folder (%1) does not exist.").arg(name));
-                    return;
-                }
-
-                if (p_notebook->isBuiltInFolder(p_node, name)) {
-                    Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Folder (%1) conflicts with built-in folder.").arg(name));
-                    return;
-                }
+    FolderImporter importer(p_node->fetchAbsolutePath(), FolderImporter::Mode::LegacyConfig);
+    runImporter(importer, p_notebook, p_node, p_errMsg, p_progressParent);
+}
 
-                QSharedPointer<Node> node;
-                try {
-                    NodeParameters paras;
-                    paras.m_createdTimeUtc = LegacyNotebookUtils::getCreatedTimeUtcOfFolder(rootDir.filePath(name));
-                    node = p_notebook->addAsNode(p_node, Node::Flag::Container, name, paras);
-                } catch (Exception &p_e) {
-                    Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Failed to add folder (%1) as node (%2).").arg(name, p_e.what()));
-                    return;
-                }
+void ImportFolderUtils::runImporter(FolderImporter &p_importer,
+                                    Notebook *p_notebook,
+                                    Node *p_node,
+                                    QString &p_errMsg,
+                                    QWidget *p_progressParent)
+{
+    QScopedPointer<QProgressDialog> proDlg;
+    if (p_progressParent) {
+        proDlg.reset(new QProgressDialog(ImportFolderUtilsTranslate::tr("Scanning folder..."),
+                                         ImportFolderUtilsTranslate::tr("Cancel"),
+                                         0,
+                                         0,
+                                         p_progressParent));
+        proDlg->setWindowModality(Qt::WindowModal);
+        proDlg->setWindowTitle(ImportFolderUtilsTranslate::tr("Import Folder"));
+        proDlg->setMinimumDuration(500);
+        proDlg->setValue(0);
 
-                ImportFolderUtils::importFolderContentsByLegacyConfig(p_notebook, node.data(), p_errMsg);
-            });
+        QObject::connect(proDlg.data(), &QProgressDialog::canceled,
+                         &p_importer, &FolderImporter::cancel);
+        auto dlg = proDlg.data();
+        QObject::connect(&p_importer, &FolderImporter::progressChanged,
+                         dlg, [dlg](int p_done, int p_total) {
+                             if (p_total == 0) {
+                                 dlg->setLabelText(ImportFolderUtilsTranslate::tr("Scanning folder (%1 found)...").arg(p_done));
+                                 return;
+                             }
 
-    // Files.
-    LegacyNotebookUtils::forEachFile(config, [&rootDir, p_notebook, p_node, &p_errMsg](const LegacyNotebookUtils::FileInfo &info) {
-                if (!rootDir.exists(info.m_name)) {
-                    Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("File (%1) does not exist.").arg(info.m_name));
-                    return;
-                }
+                             if (dlg->maximum() != p_total) {
+                                 dlg->setLabelText(ImportFolderUtilsTranslate::tr("Adding nodes..."));
+                                 dlg->setMaximum(p_total);
+                             }
+                             dlg->setValue(p_done);
+                         });
+    }
 
-                if (p_notebook->isBuiltInFile(p_node, info.m_name)) {
-                    Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("File (%1) conflicts with built-in file.").arg(info.m_name));
-                    return;
-                }
+    if (p_importer.scan(p_notebook, p_node)) {
+        p_importer.commit(p_notebook, p_node, p_errMsg);
+    }
 
-                QSharedPointer<Node> node;
-                try {
-                    NodeParameters paras;
-                    paras.m_createdTimeUtc = info.m_createdTimeUtc;
-                    paras.m_modifiedTimeUtc = info.m_modifiedTimeUtc;
-                    paras.m_attachmentFolder = info.m_attachmentFolder;
-                    paras.m_tags = info.m_tags;
-                    node = p_notebook->addAsNode(p_node, Node::Flag::Content, info.m_name, paras);
-                } catch (Exception &p_e) {
-                    Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Failed to add file (%1) as node (%2).").arg(info.m_name, p_e.what()));
-                    return;
-                }
-            });
+    if (p_importer.isCanceled()) {
+        Utils::appendMsg(p_errMsg, ImportFolderUtilsTranslate::tr("Import canceled."));
+    }
 }
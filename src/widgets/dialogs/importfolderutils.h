@@ -5,10 +5,13 @@
 
 #include <QStringList>
 
+class QWidget;
+
 namespace vnotex
 {
     class Notebook;
     class Node;
+    class FolderImporter;
 
     // A dummy class used to do translations.
     class ImportFolderUtilsTranslate : public QObject
@@ -23,16 +26,26 @@ namespace vnotex
 
         // Process folder @p_node.
         // @p_node has already been added.
+        // @p_progressParent: show a cancelable progress dialog if not null.
         static void importFolderContents(Notebook *p_notebook,
                                          Node *p_node,
                                          const QStringList &p_suffixes,
-                                         QString &p_errMsg);
+                                         QString &p_errMsg,
+                                         QWidget *p_progressParent = nullptr);
 
         // Process folder @p_node by legacy notebook config.
         // @p_node has already been added.
         static void importFolderContentsByLegacyConfig(Notebook *p_notebook,
                                                        Node *p_node,
-                                                       QString &p_errMsg);
+                                                       QString &p_errMsg,
+                                                       QWidget *p_progressParent = nullptr);
+
+    private:
+        static void runImporter(FolderImporter &p_importer,
+                                Notebook *p_notebook,
+                                Node *p_node,
+                                QString &p_errMsg,
+                                QWidget *p_progressParent);
     };
 }
 
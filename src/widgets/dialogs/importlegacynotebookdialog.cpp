@@ -123,7 +123,7 @@ bool ImportLegacyNotebookDialog::importLegacyNotebook()
     }
 
     auto rootNode = nb->getRootNode();
-    ImportFolderUtils::importFolderContentsByLegacyConfig(nb.data(), rootNode.data(), errMsg);
+    ImportFolderUtils::importFolderContentsByLegacyConfig(nb.data(), rootNode.data(), errMsg, this);
 
     emit nb->nodeUpdated(rootNode.data());
 
@@ -151,7 +151,7 @@ bool NewNotebookFromFolderDialog::newNotebookFromFolder()
 
     QString errMsg;
     auto rootNode = nb->getRootNode();
-    ImportFolderUtils::importFolderContents(nb.data(), rootNode.data(), m_filterWidget->getSuffixes(), errMsg);
+    ImportFolderUtils::importFolderContents(nb.data(), rootNode.data(), m_filterWidget->getSuffixes(), errMsg, this);
 
     emit nb->nodeUpdated(rootNode.data());
 
@@ -0,0 +1,139 @@
+#include "searchdialog.h"
+
+#include <QVBoxLayout>
+#include <QLineEdit>
+#include <QListWidgetItem>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include "vnotex.h"
+#include <notebook/notebook.h>
+#include <core/search/searchindexmgr.h>
+#include <core/fileopenparameters.h>
+#include "../widgetsfactory.h"
+#include "../listwidget.h"
+
+using namespace vnotex;
+
+SearchDialog::SearchDialog(Notebook *p_notebook, QWidget *p_parent)
+    : Dialog(p_parent),
+      m_notebook(p_notebook)
+{
+    setupUI();
+
+    auto &searchIndexMgr = VNoteX::getInst().getSearchIndexMgr();
+    connect(&searchIndexMgr, &SearchIndexMgr::indexingProgressChanged,
+            this, [this](const Notebook *p_nb, int p_done, int p_total) {
+                if (p_nb == m_notebook) {
+                    setInformationText(tr("Indexing notes (%1/%2).").arg(p_done).arg(p_total));
+                }
+            });
+    connect(&searchIndexMgr, &SearchIndexMgr::indexUpdated,
+            this, [this](const Notebook *p_nb) {
+                if (p_nb == m_notebook) {
+                    search();
+                }
+            });
+
+    m_keywordLineEdit->setFocus();
+}
+
+void SearchDialog::setupUI()
+{
+    auto widget = new QWidget(this);
+    auto mainLayout = new QVBoxLayout(widget);
+    setCentralWidget(widget);
+
+    m_keywordLineEdit = WidgetsFactory::createLineEdit(widget);
+    m_keywordLineEdit->setPlaceholderText(tr("Keywords to search for in notebook"));
+    mainLayout->addWidget(m_keywordLineEdit);
+
+    m_searchTimer = new QTimer(this);
+    m_searchTimer->setSingleShot(true);
+    m_searchTimer->setInterval(200);
+    connect(m_searchTimer, &QTimer::timeout,
+            this, &SearchDialog::search);
+    connect(m_keywordLineEdit, &QLineEdit::textChanged,
+            m_searchTimer, QOverload<>::of(&QTimer::start));
+    connect(m_keywordLineEdit, &QLineEdit::returnPressed,
+            this, [this]() {
+                if (m_resultList->count() > 0) {
+                    openResult(m_resultList->currentItem());
+                }
+            });
+
+    m_resultList = new ListWidget(widget);
+    m_resultList->setWordWrap(true);
+    connect(m_resultList, &QListWidget::itemActivated,
+            this, &SearchDialog::openResult);
+    mainLayout->addWidget(m_resultList);
+
+    setDialogButtonBox(QDialogButtonBox::Close);
+
+    setWindowTitle(tr("Search In Notebook (%1)").arg(m_notebook->getName()));
+}
+
+void SearchDialog::search()
+{
+    cancelSnippets();
+    m_resultList->clear();
+
+    const auto keyword = m_keywordLineEdit->text().trimmed();
+    if (keyword.isEmpty()) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto &searchIndexMgr = VNoteX::getInst().getSearchIndexMgr();
+    const auto results = searchIndexMgr.search(m_notebook, keyword);
+    for (const auto &result : results) {
+        auto item = new QListWidgetItem(m_resultList);
+        item->setText(result.m_name);
+        item->setToolTip(result.m_filePath);
+        item->setData(Qt::UserRole, result.m_filePath);
+    }
+    m_resultList->setCurrentRow(0);
+
+    if (!results.isEmpty()) {
+        m_snippetWatcher = new QFutureWatcher<QString>(this);
+        connect(m_snippetWatcher, &QFutureWatcher<QString>::resultReadyAt,
+                this, [this](int p_idx) {
+                    const auto snippet = m_snippetWatcher->resultAt(p_idx);
+                    auto item = m_resultList->item(p_idx);
+                    if (item && !snippet.isEmpty()) {
+                        item->setText(item->text() + QLatin1Char('\n') + snippet);
+                    }
+                });
+        m_snippetWatcher->setFuture(SearchIndexMgr::generateSnippets(results, keyword));
+    }
+
+    if (!searchIndexMgr.isIndexing(m_notebook)) {
+        setInformationText(tr("%n result(s) in %1 ms.", "", results.size()).arg(timer.elapsed()));
+    }
+}
+
+void SearchDialog::cancelSnippets()
+{
+    if (!m_snippetWatcher) {
+        return;
+    }
+
+    // Results of the old watcher should not reach the new list.
+    m_snippetWatcher->disconnect(this);
+    m_snippetWatcher->cancel();
+    m_snippetWatcher->deleteLater();
+    m_snippetWatcher = nullptr;
+}
+
+void SearchDialog::openResult(QListWidgetItem *p_item)
+{
+    if (!p_item) {
+        return;
+    }
+
+    auto paras = QSharedPointer<FileOpenParameters>::create();
+    emit VNoteX::getInst().openFileRequested(p_item->data(Qt::UserRole).toString(), paras);
+    accept();
+}
@@ -0,0 +1,49 @@
+#ifndef SEARCHDIALOG_H
+#define SEARCHDIALOG_H
+
+#include "dialog.h"
+
+#include <QFutureWatcher>
+
+class QLineEdit;
+class QListWidget;
+class QListWidgetItem;
+class QTimer;
+
+namespace vnotex
+{
+    class Notebook;
+
+    // Full-text search within notes of one notebook.
+    class SearchDialog : public Dialog
+    {
+        Q_OBJECT
+    public:
+        SearchDialog(Notebook *p_notebook, QWidget *p_parent = nullptr);
+
+    private slots:
+        void search();
+
+        void openResult(QListWidgetItem *p_item);
+
+    private:
+        void setupUI();
+
+        // Stop updating the snippets of previous results.
+        void cancelSnippets();
+
+        Notebook *m_notebook = nullptr;
+
+        QLineEdit *m_keywordLineEdit = nullptr;
+
+        QListWidget *m_resultList = nullptr;
+
+        // Search after user stops typing.
+        QTimer *m_searchTimer = nullptr;
+
+        // Fill in snippets of results as they are ready.
+        QFutureWatcher<QString> *m_snippetWatcher = nullptr;
+    };
+} // ns vnotex
+
+#endif // SEARCHDIALOG_H
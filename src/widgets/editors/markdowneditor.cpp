@@ -62,6 +62,14 @@ MarkdownEditor::Heading::Heading(const QString &p_name,
 {
 }
 
+bool MarkdownEditor::Heading::operator==(const Heading &p_a) const
+{
+    return m_level == p_a.m_level
+           && m_blockNumber == p_a.m_blockNumber
+           && m_name == p_a.m_name
+           && m_sectionNumber == p_a.m_sectionNumber;
+}
+
 MarkdownEditor::MarkdownEditor(const MarkdownEditorConfig &p_config,
                                const QSharedPointer<vte::MarkdownEditorConfig> &p_editorConfig,
                                QWidget *p_parent)
@@ -777,6 +785,15 @@ int MarkdownEditor::getCurrentHeadingIndex() const
 
 void MarkdownEditor::updateHeadings(const QVector<vte::peg::ElementRegion> &p_headerRegions)
 {
+    if (m_buffer && m_buffer->isLargeFile()) {
+        // No outline and section number for large file.
+        if (!m_headings.isEmpty()) {
+            m_headings.clear();
+            emit headingsChanged();
+        }
+        return;
+    }
+
     bool needUpdateSectionNumber = false;
     if (isReadOnly()) {
         m_sectionNumberEnabled = false;
@@ -797,6 +814,10 @@ void MarkdownEditor::updateHeadings(const QVector<vte::peg::ElementRegion> &p_he
     QVector<Heading> headings;
     headings.reserve(p_headerRegions.size());
 
+    // Block text -> heading matched.
+    QHash<QString, Heading> matchCache;
+    matchCache.reserve(p_headerRegions.size());
+
     // Assume that each block contains only one line.
     // Only support # syntax for now.
     auto doc = document();
@@ -810,24 +831,39 @@ void MarkdownEditor::updateHeadings(const QVector<vte::peg::ElementRegion> &p_he
             qWarning() << "header accross multiple blocks, starting from block" << block.blockNumber() << block.text();
         }
 
-        auto match = vte::MarkdownUtils::matchHeader(block.text());
-        if (match.m_matched) {
-            Heading heading(match.m_header,
-                            match.m_level,
-                            match.m_sequence,
-                            block.blockNumber());
+        // Only match the blocks changed since last update.
+        const auto text = block.text();
+        Heading heading;
+        auto it = m_headingMatchCache.constFind(text);
+        if (it != m_headingMatchCache.constEnd()) {
+            heading = it.value();
+        } else {
+            auto match = vte::MarkdownUtils::matchHeader(text);
+            if (match.m_matched) {
+                heading = Heading(match.m_header, match.m_level, match.m_sequence);
+            }
+        }
+        matchCache.insert(text, heading);
+
+        if (heading.m_level != -1) {
+            heading.m_blockNumber = block.blockNumber();
             headings.append(heading);
         }
     }
+    m_headingMatchCache.swap(matchCache);
 
-    OutlineProvider::makePerfectHeadings(headings, m_headings);
+    QVector<Heading> perfectHeadings;
+    OutlineProvider::makePerfectHeadings(headings, perfectHeadings);
 
     if (needUpdateSectionNumber) {
         // Use a timer to kick off the update to let user have time to undo.
         m_sectionNumberTimer->start();
     }
 
-    emit headingsChanged();
+    if (perfectHeadings != m_headings) {
+        m_headings.swap(perfectHeadings);
+        emit headingsChanged();
+    }
 
     emit currentHeadingChanged();
 }
@@ -1127,116 +1163,26 @@ void MarkdownEditor::fetchImagesToLocalAndReplace(QString &p_text)
     proDlg.setValue(regs.size());
 }
 
-static void increaseSectionNumber(QVector<int> &p_sectionNumber, int p_level, int p_baseLevel)
-{
-    Q_ASSERT(p_level >= 1 && p_level < p_sectionNumber.size());
-    if (p_level < p_baseLevel) {
-        p_sectionNumber.fill(0);
-        return;
-    }
-
-    ++p_sectionNumber[p_level];
-    for (int i = p_level + 1; i < p_sectionNumber.size(); ++i) {
-        p_sectionNumber[i] = 0;
-    }
-}
-
-static QString joinSectionNumberStr(const QVector<int> &p_sectionNumber, bool p_endingDot)
-{
-    QString res;
-    for (auto sec : p_sectionNumber) {
-        if (sec != 0) {
-            if (res.isEmpty()) {
-                res = QString::number(sec);
-            } else {
-                res += '.' + QString::number(sec);
-            }
-        } else if (res.isEmpty()) {
-            continue;
-        } else {
-            break;
-        }
-    }
-
-    if (p_endingDot && !res.isEmpty()) {
-        return res + '.';
-    } else {
-        return res;
-    }
-}
-
-static bool updateHeadingSectionNumber(QTextCursor &p_cursor,
-                                       const QTextBlock &p_block,
-                                       const QString &p_sectionNumber,
-                                       bool p_endingDot)
-{
-    if (!p_block.isValid()) {
-        return false;
-    }
-
-    QString text = p_block.text();
-    auto match = vte::MarkdownUtils::matchHeader(text);
-    Q_ASSERT(match.m_matched);
-
-    bool isSequence = false;
-    if (!match.m_sequence.isEmpty()) {
-        // Check if this sequence is the real sequence matching current style.
-        if (match.m_sequence.endsWith('.')) {
-            isSequence = p_endingDot;
-        } else {
-            isSequence = !p_endingDot;
-        }
-    }
-
-    int start = match.m_level + 1;
-    int end = match.m_level + match.m_spacesAfterMarker;
-    if (isSequence) {
-        end += match.m_sequence.size() + match.m_spacesAfterSequence;
-    }
-
-    Q_ASSERT(start <= end);
-
-    p_cursor.setPosition(p_block.position() + start);
-    if (start != end) {
-        p_cursor.setPosition(p_block.position() + end, QTextCursor::KeepAnchor);
-    }
-
-    if (p_sectionNumber.isEmpty()) {
-        p_cursor.removeSelectedText();
-    } else {
-        p_cursor.insertText(p_sectionNumber + ' ');
-    }
-    return true;
-}
-
 bool MarkdownEditor::updateSectionNumber(const QVector<Heading> &p_headings)
 {
-    QVector<int> sectionNumber(7, 0);
     int baseLevel = m_config.getSectionNumberBaseLevel();
     if (baseLevel < 1 || baseLevel > 6) {
         baseLevel = 1;
     }
 
-    bool changed = false;
     bool endingDot = m_config.getSectionNumberStyle() == MarkdownEditorConfig::SectionNumberStyle::DigDotDigDot;
-    auto doc = document();
-    QTextCursor cursor(doc);
-    cursor.beginEditBlock();
+
+    QVector<SectionNumberUpdater::Heading> headings;
+    headings.reserve(p_headings.size());
     for (const auto &heading : p_headings) {
-        increaseSectionNumber(sectionNumber, heading.m_level, baseLevel);
-        auto sectionStr = m_sectionNumberEnabled ? joinSectionNumberStr(sectionNumber, endingDot) : QString();
-        if (heading.m_blockNumber > -1 && sectionStr != heading.m_sectionNumber) {
-            if (updateHeadingSectionNumber(cursor,
-                                           doc->findBlockByNumber(heading.m_blockNumber),
-                                           sectionStr,
-                                           endingDot)) {
-                changed = true;
-            }
-        }
+        SectionNumberUpdater::Heading hd;
+        hd.m_level = heading.m_level;
+        hd.m_sectionNumber = heading.m_sectionNumber;
+        hd.m_blockNumber = heading.m_blockNumber;
+        headings.push_back(hd);
     }
-    cursor.endEditBlock();
 
-    return changed;
+    return m_sectionNumberUpdater.update(document(), headings, m_sectionNumberEnabled, baseLevel, endingDot);
 }
 
 void MarkdownEditor::overrideSectionNumber(OverrideState p_state)
@@ -2,12 +2,15 @@
 #define MARKDOWNEDITOR_H
 
 #include <QScopedPointer>
+#include <QHash>
 
 #include <vtextedit/vmarkdowneditor.h>
 #include <vtextedit/pegmarkdownhighlighter.h>
 
 #include <core/global.h>
 
+#include "sectionnumberupdater.h"
+
 class QMimeData;
 class QMenu;
 class QTimer;
@@ -37,6 +40,8 @@ namespace vnotex
                     const QString &p_sectionNumber = QString(),
                     int p_blockNumber = -1);
 
+            bool operator==(const Heading &p_a) const;
+
             QString m_name;
 
             int m_level = -1;
@@ -186,6 +191,10 @@ namespace vnotex
 
         QVector<Heading> m_headings;
 
+        // Block text -> heading matched from it, with m_blockNumber unset.
+        // Used to skip matching the heading blocks unchanged since last update.
+        QHash<QString, Heading> m_headingMatchCache;
+
         // TimeStamp used as sequence number to interact with Web side.
         TimeStamp m_timeStamp = 0;
 
@@ -196,6 +205,8 @@ namespace vnotex
         // Used to detect the config change and do a clean up.
         bool m_sectionNumberEnabled = false;
 
+        SectionNumberUpdater m_sectionNumberUpdater;
+
         OverrideState m_overriddenSectionNumber = OverrideState::NoOverride;
 
         // Managed by QObject.
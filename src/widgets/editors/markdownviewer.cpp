@@ -8,7 +8,6 @@
 #include <QScopedPointer>
 
 #include "markdownvieweradapter.h"
-#include "previewhelper.h"
 #include <utils/clipboardutils.h>
 #include <utils/fileutils.h>
 #include <utils/utils.h>
@@ -30,15 +29,27 @@ MarkdownViewer::MarkdownViewer(MarkdownViewerAdapter *p_adapter,
                                const QColor &p_background,
                                qreal p_zoomFactor,
                                QWidget *p_parent)
-    : WebViewer(p_background, p_zoomFactor, p_parent),
+    : MarkdownViewer(p_adapter, nullptr, p_background, p_zoomFactor, p_parent)
+{
+}
+
+MarkdownViewer::MarkdownViewer(MarkdownViewerAdapter *p_adapter,
+                               QWebEnginePage *p_page,
+                               const QColor &p_background,
+                               qreal p_zoomFactor,
+                               QWidget *p_parent)
+    : WebViewer(p_page, p_background, p_zoomFactor, p_parent),
       m_adapter(p_adapter)
 {
-    m_adapter->setParent(this);
+    if (!p_page) {
+        // Keep the adapter and channel with the page so that it could be reused.
+        m_adapter->setParent(page());
 
-    auto channel = new QWebChannel(this);
-    channel->registerObject(QStringLiteral("vxAdapter"), m_adapter);
+        auto channel = new QWebChannel(page());
+        channel->registerObject(QStringLiteral("vxAdapter"), m_adapter);
 
-    page()->setWebChannel(channel);
+        page()->setWebChannel(channel);
+    }
 
     connect(QApplication::clipboard(), &QClipboard::changed,
             this, &MarkdownViewer::handleClipboardChanged);
@@ -66,35 +77,6 @@ MarkdownViewerAdapter *MarkdownViewer::adapter() const
     return m_adapter;
 }
 
-void MarkdownViewer::setPreviewHelper(PreviewHelper *p_previewHelper)
-{
-    connect(p_previewHelper, &PreviewHelper::graphPreviewRequested,
-            this, [this, p_previewHelper](quint64 p_id,
-                                          TimeStamp p_timeStamp,
-                                          const QString &p_lang,
-                                          const QString &p_text) {
-                if (m_adapter->isViewerReady()) {
-                    m_adapter->graphPreviewRequested(p_id, p_timeStamp, p_lang, p_text);
-                } else {
-                    p_previewHelper->handleGraphPreviewData(MarkdownViewerAdapter::PreviewData());
-                }
-            });
-    connect(p_previewHelper, &PreviewHelper::mathPreviewRequested,
-            this, [this, p_previewHelper](quint64 p_id,
-                                          TimeStamp p_timeStamp,
-                                          const QString &p_text) {
-                if (m_adapter->isViewerReady()) {
-                    m_adapter->mathPreviewRequested(p_id, p_timeStamp, p_text);
-                } else {
-                    p_previewHelper->handleMathPreviewData(MarkdownViewerAdapter::PreviewData());
-                }
-            });
-    connect(m_adapter, &MarkdownViewerAdapter::graphPreviewDataReady,
-            p_previewHelper, &PreviewHelper::handleGraphPreviewData);
-    connect(m_adapter, &MarkdownViewerAdapter::mathPreviewDataReady,
-            p_previewHelper, &PreviewHelper::handleMathPreviewData);
-}
-
 void MarkdownViewer::contextMenuEvent(QContextMenuEvent *p_event)
 {
     QScopedPointer<QMenu> menu(page()->createStandardContextMenu());
@@ -8,7 +8,6 @@
 namespace vnotex
 {
     class MarkdownViewerAdapter;
-    class PreviewHelper;
 
     class MarkdownViewer : public WebViewer
     {
@@ -20,9 +19,14 @@ namespace vnotex
                        qreal p_zoomFactor,
                        QWidget *p_parent = nullptr);
 
-        MarkdownViewerAdapter *adapter() const;
+        // Use @p_page loaded already with @p_adapter registered, such as one from MarkdownViewerPool.
+        MarkdownViewer(MarkdownViewerAdapter *p_adapter,
+                       QWebEnginePage *p_page,
+                       const QColor &p_background,
+                       qreal p_zoomFactor,
+                       QWidget *p_parent = nullptr);
 
-        void setPreviewHelper(PreviewHelper *p_previewHelper);
+        MarkdownViewerAdapter *adapter() const;
 
     signals:
         void zoomFactorChanged(qreal p_factor);
@@ -59,7 +63,7 @@ namespace vnotex
         // @p_baseUrl: if it is a folder, please end it with '/'. It is not used now in web side.
         void crossCopy(const QString &p_target, const QString &p_baseUrl, const QString &p_html);
 
-        // Managed by QObject.
+        // Managed by QObject along with the page.
         MarkdownViewerAdapter *m_adapter = nullptr;
 
         // Whether this view has hooked the Copy Image Url action.
@@ -2,8 +2,13 @@
 
 #include <QDebug>
 #include <QMap>
+#include <QDateTime>
+
+#include <core/localgraphrenderer.h>
+#include <utils/textutils.h>
 
 #include "../outlineprovider.h"
+#include "previewdataserver.h"
 
 using namespace vnotex;
 
@@ -56,6 +61,36 @@ MarkdownViewerAdapter::Heading MarkdownViewerAdapter::Heading::fromJson(const QJ
                    p_obj.value(QStringLiteral("anchor")).toString());
 }
 
+MarkdownViewerAdapter::RenderStats MarkdownViewerAdapter::RenderStats::fromJson(const QJsonObject &p_obj,
+                                                                                qint64 p_sentTime)
+{
+    RenderStats stats;
+    auto addStage = [&stats](const QString &p_name, int p_time) {
+        Stage stage;
+        stage.m_name = p_name;
+        stage.m_time = p_time;
+        stats.m_stages.push_back(stage);
+    };
+
+    // Text may be received after a while if the channel is busy.
+    const auto receivedTime = static_cast<qint64>(p_obj.value(QStringLiteral("receivedTime")).toDouble());
+    const int transferTime = p_sentTime > 0 ? static_cast<int>(qMax<qint64>(receivedTime - p_sentTime, 0)) : 0;
+    addStage(QStringLiteral("transfer"), transferTime);
+
+    // Text may wait for last round to finish.
+    const int waitTime = p_obj.value(QStringLiteral("waitTime")).toInt();
+    addStage(QStringLiteral("wait"), waitTime);
+
+    const auto stages = p_obj.value(QStringLiteral("stages")).toArray();
+    for (const auto &stage : stages) {
+        const auto obj = stage.toObject();
+        addStage(obj.value(QStringLiteral("name")).toString(), obj.value(QStringLiteral("time")).toInt());
+    }
+
+    stats.m_totalTime = transferTime + waitTime + p_obj.value(QStringLiteral("totalTime")).toInt();
+    return stats;
+}
+
 QJsonObject MarkdownViewerAdapter::FindOption::toJson() const
 {
     QJsonObject obj;
@@ -69,10 +104,22 @@ QJsonObject MarkdownViewerAdapter::FindOption::toJson() const
 MarkdownViewerAdapter::MarkdownViewerAdapter(QObject *p_parent)
     : QObject(p_parent)
 {
+    m_previewDataServer = &PreviewDataServer::getInst();
+    m_previewDataUrl = m_previewDataServer->registerAdapter(this);
 }
 
 MarkdownViewerAdapter::~MarkdownViewerAdapter()
 {
+    // Do not call getInst() here, which may construct the server again during
+    // static destruction.
+    if (m_previewDataServer) {
+        m_previewDataServer->unregisterAdapter(this);
+    }
+}
+
+const QString &MarkdownViewerAdapter::getPreviewDataUrl() const
+{
+    return m_previewDataUrl;
 }
 
 void MarkdownViewerAdapter::setText(int p_revision,
@@ -87,7 +134,7 @@ void MarkdownViewerAdapter::setText(int p_revision,
 
     m_revision = p_revision;
     if (m_viewerReady) {
-        emit textUpdated(p_text);
+        updateViewerText(p_text);
         scrollToPosition(Position(p_lineNumber, ""));
     } else {
         m_pendingData.reset(new MarkdownData(p_text, p_lineNumber, ""));
@@ -101,9 +148,19 @@ void MarkdownViewerAdapter::setReady(bool p_ready)
     }
 
     m_viewerReady = p_ready;
-    if (m_viewerReady) {
+    if (!m_viewerReady) {
+        // The page will be reloaded and needs the whole text again.
+        m_revision = -1;
+        m_viewerTextSynced = false;
+        m_viewerText.clear();
+        m_baseUrl.clear();
+    } else {
+        if (!m_baseUrl.isEmpty()) {
+            emit baseUrlUpdated(m_baseUrl);
+        }
+
         if (m_pendingData) {
-            emit textUpdated(m_pendingData->m_text);
+            updateViewerText(m_pendingData->m_text);
             scrollToPosition(m_pendingData->m_position);
             m_pendingData.reset();
         }
@@ -113,6 +170,49 @@ void MarkdownViewerAdapter::setReady(bool p_ready)
 
 }
 
+void MarkdownViewerAdapter::setBaseUrl(const QString &p_url)
+{
+    if (m_baseUrl == p_url) {
+        return;
+    }
+
+    m_baseUrl = p_url;
+    if (m_viewerReady) {
+        emit baseUrlUpdated(m_baseUrl);
+    }
+}
+
+void MarkdownViewerAdapter::clear()
+{
+    m_revision = -1;
+    m_pendingData.reset();
+    if (m_viewerReady) {
+        updateViewerText(QString());
+    }
+}
+
+void MarkdownViewerAdapter::updateViewerText(const QString &p_text)
+{
+    m_textSentTime = QDateTime::currentMSecsSinceEpoch();
+
+    if (!m_viewerTextSynced) {
+        m_viewerTextSynced = true;
+        m_viewerText = p_text;
+        emit textUpdated(p_text);
+        return;
+    }
+
+    int firstLine = 0;
+    int removedLineCount = 0;
+    QStringList insertedLines;
+    if (!TextUtils::diffLines(m_viewerText, p_text, firstLine, removedLineCount, insertedLines)) {
+        return;
+    }
+
+    m_viewerText = p_text;
+    emit textPatched(firstLine, removedLineCount, insertedLines);
+}
+
 void MarkdownViewerAdapter::scrollToLine(int p_lineNumber)
 {
     if (p_lineNumber == -1) {
@@ -199,6 +299,13 @@ void MarkdownViewerAdapter::setHeadings(const QJsonArray &p_headings)
     emit headingsChanged();
 }
 
+void MarkdownViewerAdapter::setRenderStats(const QJsonObject &p_stats)
+{
+    const auto stats = RenderStats::fromJson(p_stats, m_textSentTime);
+    m_textSentTime = 0;
+    emit renderStatsUpdated(stats);
+}
+
 void MarkdownViewerAdapter::setCurrentHeadingAnchor(int p_index, const QString &p_anchor)
 {
     m_currentHeadingIndex = -1;
@@ -328,3 +435,28 @@ void MarkdownViewerAdapter::setFindText(const QString &p_text, int p_totalMatche
 {
     emit findTextReady(p_text, p_totalMatches, p_currentMatchIndex);
 }
+
+void MarkdownViewerAdapter::renderGraph(quint64 p_id,
+                                        const QString &p_lang,
+                                        const QString &p_format,
+                                        const QString &p_text)
+{
+    LocalGraphRenderer::Backend backend;
+    if (!LocalGraphRenderer::backendOfLang(p_lang, backend)) {
+        qWarning() << "local rendering is not supported" << p_lang;
+        emit graphRendered(p_id, p_format, QString());
+        return;
+    }
+
+    LocalGraphRenderer::getInst().render(backend,
+                                         p_format,
+                                         p_text,
+                                         this,
+                                         [this, p_id](const QString &p_format, const QByteArray &p_data) {
+                                             if (p_format == QStringLiteral("svg")) {
+                                                 emit graphRendered(p_id, p_format, QString::fromUtf8(p_data));
+                                             } else {
+                                                 emit graphRendered(p_id, p_format, QString::fromLatin1(p_data.toBase64()));
+                                             }
+                                         });
+}
@@ -6,15 +6,22 @@
 #include <QJsonObject>
 #include <QScopedPointer>
 #include <QJsonArray>
+#include <QImage>
+#include <QVector>
+#include <QPointer>
 
 #include <core/global.h>
 
 namespace vnotex
 {
+    class PreviewDataServer;
+
     // Adapter and interface between CPP and JS.
     class MarkdownViewerAdapter : public QObject
     {
         Q_OBJECT
+        // URL prefix for web side to post preview data in binary. Empty if not available.
+        Q_PROPERTY(QString previewDataUrl READ getPreviewDataUrl CONSTANT)
     public:
         struct Position
         {
@@ -61,6 +68,9 @@ namespace vnotex
             QByteArray m_data;
 
             bool m_needScale = false;
+
+            // Decoded image of @m_data in background if available.
+            QImage m_image;
         };
 
         struct Heading
@@ -78,6 +88,27 @@ namespace vnotex
             QString m_anchor;
         };
 
+        // Time cost of one round of rendering in read mode.
+        struct RenderStats
+        {
+            struct Stage
+            {
+                QString m_name;
+
+                // In ms.
+                int m_time = 0;
+            };
+
+            // Web side reports the parse and DOM stages of markdown-it, the heading scan,
+            // and the time from the start of the round to the finish of each worker.
+            static RenderStats fromJson(const QJsonObject &p_obj, qint64 p_sentTime);
+
+            // From sending the text to finishing all the workers.
+            int m_totalTime = 0;
+
+            QVector<Stage> m_stages;
+        };
+
         struct FindOption
         {
             QJsonObject toJson() const;
@@ -102,6 +133,13 @@ namespace vnotex
 
         void scrollToPosition(const Position &p_pos);
 
+        // Resolve relative URLs against @p_url instead of the page URL.
+        // Used when the page is reused for another note without reloading.
+        void setBaseUrl(const QString &p_url);
+
+        // Clear the content for the page to be reused.
+        void clear();
+
         int getTopLineNumber() const;
 
         bool isViewerReady() const;
@@ -119,6 +157,8 @@ namespace vnotex
 
         void findText(const QString &p_text, FindOptions p_options);
 
+        const QString &getPreviewDataUrl() const;
+
         // Functions to be called from web side.
     public slots:
         void setReady(bool p_ready);
@@ -161,14 +201,29 @@ namespace vnotex
 
         void setFindText(const QString &p_text, int p_totalMatches, int p_currentMatchIndex);
 
+        // Timings of last round of rendering.
+        void setRenderStats(const QJsonObject &p_stats);
+
+        // Render PlantUML or Graphviz with local programs.
+        // Result will be sent back via graphRendered().
+        void renderGraph(quint64 p_id, const QString &p_lang, const QString &p_format, const QString &p_text);
+
         // Signals to be connected at web side.
     signals:
         // Current Markdown text is updated.
         void textUpdated(const QString &p_text);
 
+        // Lines [@p_firstLine, @p_firstLine + @p_removedLineCount) of the text last sent
+        // are replaced by @p_insertedLines.
+        void textPatched(int p_firstLine, int p_removedLineCount, const QStringList &p_insertedLines);
+
         // Current editor line number is updated.
         void editLineNumberUpdated(int p_lineNumber);
 
+        void baseUrlUpdated(const QString &p_url);
+
+        void renderStatsUpdated(const MarkdownViewerAdapter::RenderStats &p_stats);
+
         // Request to preview graph.
         void graphPreviewRequested(quint64 p_id,
                                    quint64 p_timeStamp,
@@ -194,6 +249,9 @@ namespace vnotex
 
         void findTextRequested(const QString &p_text, const QJsonObject &p_options);
 
+        // @p_data is empty on failure and in Base64 if @p_format is not svg.
+        void graphRendered(quint64 p_id, const QString &p_format, const QString &p_data);
+
     // Signals to be connected at cpp side.
     signals:
         void graphPreviewDataReady(const PreviewData &p_data);
@@ -219,6 +277,9 @@ namespace vnotex
     private:
         void scrollToLine(int p_lineNumber);
 
+        // Send the whole text for the first time and then only the changed lines.
+        void updateViewerText(const QString &p_text);
+
         void scrollToAnchor(const QString &p_anchor);
 
         int m_revision = 0;
@@ -229,6 +290,16 @@ namespace vnotex
         // Pending Markdown data for the viewer once it is ready.
         QScopedPointer<MarkdownData> m_pendingData;
 
+        // Text the web side holds.
+        QString m_viewerText;
+
+        bool m_viewerTextSynced = false;
+
+        QString m_baseUrl;
+
+        // Time in ms since epoch when the text was last sent to web side.
+        qint64 m_textSentTime = 0;
+
         // Source line number of the top element node at web side.
         int m_topLineNumber = -1;
 
@@ -239,6 +310,11 @@ namespace vnotex
 
         // Targets supported by cross copy. Set by web.
         QStringList m_crossCopyTargets;
+
+        QString m_previewDataUrl;
+
+        // Null once the server is destructed, which may happen before this on quit.
+        QPointer<PreviewDataServer> m_previewDataServer;
     };
 }
 
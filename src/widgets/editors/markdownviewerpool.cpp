@@ -0,0 +1,185 @@
+#include "markdownviewerpool.h"
+
+#include <QWebEnginePage>
+#include <QWebChannel>
+#include <QTimer>
+
+#include <core/configmgr.h>
+#include <core/editorconfig.h>
+#include <core/markdowneditorconfig.h>
+#include <core/htmltemplatehelper.h>
+#include <core/vnotex.h>
+#include <core/thememgr.h>
+#include <utils/pathutils.h>
+
+#include "../webpage.h"
+#include "editormarkdownvieweradapter.h"
+
+using namespace vnotex;
+
+// Idle pages kept in the pool.
+static const int c_maxEntryCount = 2;
+
+// Delay before loading a page to leave the CPU to the viewers in use.
+static const int c_warmUpDelay = 3000;
+
+MarkdownViewerPool &MarkdownViewerPool::getInst()
+{
+    static MarkdownViewerPool inst;
+    return inst;
+}
+
+MarkdownViewerPool::MarkdownViewerPool(QObject *p_parent)
+    : QObject(p_parent)
+{
+    m_warmUpTimer = new QTimer(this);
+    m_warmUpTimer->setSingleShot(true);
+    m_warmUpTimer->setInterval(c_warmUpDelay);
+    connect(m_warmUpTimer, &QTimer::timeout,
+            this, &MarkdownViewerPool::loadEntry);
+}
+
+MarkdownViewerPool::~MarkdownViewerPool()
+{
+    close();
+}
+
+void MarkdownViewerPool::warmUp()
+{
+    if (!m_closed && m_entries.size() < c_maxEntryCount && !m_warmUpTimer->isActive()) {
+        m_warmUpTimer->start();
+    }
+}
+
+void MarkdownViewerPool::loadEntry()
+{
+    updateTemplate();
+    if (m_closed || m_entries.size() >= c_maxEntryCount) {
+        return;
+    }
+
+    Entry entry;
+    entry.m_page = new WebPage();
+    entry.m_page->setBackgroundColor(VNoteX::getInst().getThemeMgr().getBaseBackground());
+
+    entry.m_adapter = new EditorMarkdownViewerAdapter(nullptr, entry.m_page);
+    auto channel = new QWebChannel(entry.m_page);
+    channel->registerObject(QStringLiteral("vxAdapter"), entry.m_adapter);
+    entry.m_page->setWebChannel(channel);
+
+    // Any local file URL will do to let the page load local scripts.
+    // The viewer taking it will set the base URL of the note.
+    entry.m_template = m_template;
+    const auto baseFile = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                         QStringLiteral("markdown_viewer.html"));
+    entry.m_page->setHtml(m_template, PathUtils::pathToUrl(baseFile));
+
+    addEntry(entry);
+
+    // Load one page at a time.
+    warmUp();
+}
+
+void MarkdownViewerPool::addEntry(const Entry &p_entry)
+{
+    auto page = p_entry.m_page;
+    page->setParent(this);
+    connect(page, &QWebEnginePage::renderProcessTerminated,
+            this, [this, page]() {
+                removeEntry(page);
+                warmUp();
+            });
+    m_entries.push_back(p_entry);
+}
+
+bool MarkdownViewerPool::take(QWebEnginePage *&p_page, EditorMarkdownViewerAdapter *&p_adapter)
+{
+    updateTemplate();
+    if (m_entries.isEmpty()) {
+        warmUp();
+        return false;
+    }
+
+    // Prefer the ones loaded.
+    int idx = 0;
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].m_adapter->isViewerReady()) {
+            idx = i;
+            break;
+        }
+    }
+
+    const auto entry = m_entries.takeAt(idx);
+    disconnect(entry.m_page, nullptr, this, nullptr);
+    entry.m_page->setParent(nullptr);
+    p_page = entry.m_page;
+    p_adapter = entry.m_adapter;
+
+    warmUp();
+    return true;
+}
+
+bool MarkdownViewerPool::recycle(QWebEnginePage *p_page,
+                                 EditorMarkdownViewerAdapter *p_adapter,
+                                 const QString &p_template)
+{
+    if (m_closed) {
+        return false;
+    }
+
+    updateTemplate();
+    if (p_template != m_template || m_entries.size() >= c_maxEntryCount) {
+        return false;
+    }
+
+    Q_ASSERT(p_adapter->parent() == p_page);
+    p_adapter->setBuffer(nullptr);
+    p_adapter->clear();
+
+    Entry entry;
+    entry.m_page = p_page;
+    entry.m_adapter = p_adapter;
+    entry.m_template = p_template;
+    addEntry(entry);
+    return true;
+}
+
+void MarkdownViewerPool::updateTemplate()
+{
+    const auto &markdownEditorConfig = ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig();
+    HtmlTemplateHelper::updateMarkdownViewerTemplate(markdownEditorConfig);
+
+    const auto &tmpl = HtmlTemplateHelper::getMarkdownViewerTemplate();
+    if (tmpl == m_template) {
+        return;
+    }
+
+    m_template = tmpl;
+    for (int i = m_entries.size() - 1; i >= 0; --i) {
+        if (m_entries[i].m_template != m_template) {
+            delete m_entries[i].m_page;
+            m_entries.remove(i);
+        }
+    }
+}
+
+void MarkdownViewerPool::removeEntry(QWebEnginePage *p_page)
+{
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries[i].m_page == p_page) {
+            m_entries.remove(i);
+            p_page->deleteLater();
+            return;
+        }
+    }
+}
+
+void MarkdownViewerPool::close()
+{
+    m_closed = true;
+    m_warmUpTimer->stop();
+    for (const auto &entry : m_entries) {
+        delete entry.m_page;
+    }
+    m_entries.clear();
+}
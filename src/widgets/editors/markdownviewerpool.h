@@ -0,0 +1,77 @@
+#ifndef MARKDOWNVIEWERPOOL_H
+#define MARKDOWNVIEWERPOOL_H
+
+#include <QObject>
+#include <QVector>
+
+class QWebEnginePage;
+class QTimer;
+
+namespace vnotex
+{
+    class EditorMarkdownViewerAdapter;
+
+    // Pool of viewer pages loaded with the viewer template ahead of time, so that
+    // a MarkdownViewer could skip the page boot and just switch the content and
+    // base URL. Pages are loaded at idle time and given back by closed viewers.
+    class MarkdownViewerPool : public QObject
+    {
+        Q_OBJECT
+    public:
+        static MarkdownViewerPool &getInst();
+
+        // Schedule to fill the pool at idle time.
+        void warmUp();
+
+        // Take a page loaded with current template, with @p_adapter registered in
+        // its web channel and managed by the page. It may be still loading.
+        // Return false if none is available.
+        bool take(QWebEnginePage *&p_page, EditorMarkdownViewerAdapter *&p_adapter);
+
+        // Give back @p_page loaded with @p_template for reuse.
+        // Return false if it is not accepted and the caller should release it.
+        bool recycle(QWebEnginePage *p_page,
+                     EditorMarkdownViewerAdapter *p_adapter,
+                     const QString &p_template);
+
+        // Release all the pages. Called on quit.
+        void close();
+
+    private:
+        struct Entry
+        {
+            QWebEnginePage *m_page = nullptr;
+
+            // Managed by QObject.
+            EditorMarkdownViewerAdapter *m_adapter = nullptr;
+
+            // Template loaded in the page.
+            QString m_template;
+        };
+
+        explicit MarkdownViewerPool(QObject *p_parent = nullptr);
+
+        ~MarkdownViewerPool();
+
+        // Load one page if the pool is not full.
+        void loadEntry();
+
+        void addEntry(const Entry &p_entry);
+
+        // Drop pages loaded with stale template.
+        void updateTemplate();
+
+        void removeEntry(QWebEnginePage *p_page);
+
+        QVector<Entry> m_entries;
+
+        // Template of the pages.
+        QString m_template;
+
+        QTimer *m_warmUpTimer = nullptr;
+
+        bool m_closed = false;
+    };
+} // ns vnotex
+
+#endif // MARKDOWNVIEWERPOOL_H
@@ -0,0 +1,259 @@
+#include "previewdataserver.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QHostAddress>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QImage>
+#include <QRandomGenerator>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QDebug>
+
+#include "markdownvieweradapter.h"
+
+using namespace vnotex;
+
+// Larger requests are rejected.
+static const qint64 c_maxBodySize = 64 * 1024 * 1024;
+
+static const qint64 c_maxHeaderSize = 8 * 1024;
+
+// Close the connection if no data is received within this time in milliseconds.
+static const int c_idleTimeout = 10 * 1000;
+
+struct PreviewDataServer::Request
+{
+    QByteArray m_buffer;
+
+    // Whether the header has been parsed.
+    bool m_headerReady = false;
+
+    QByteArray m_method;
+
+    QUrl m_url;
+
+    qint64 m_bodyOffset = 0;
+
+    qint64 m_contentLength = 0;
+};
+
+PreviewDataServer &PreviewDataServer::getInst()
+{
+    static PreviewDataServer inst;
+    return inst;
+}
+
+PreviewDataServer::PreviewDataServer(QObject *p_parent)
+    : QObject(p_parent)
+{
+    m_token = QString::number(QRandomGenerator::global()->generate64(), 16);
+}
+
+bool PreviewDataServer::listen()
+{
+    if (m_server) {
+        return true;
+    } else if (m_listenFailed) {
+        return false;
+    }
+
+    m_server = new QTcpServer(this);
+    if (!m_server->listen(QHostAddress::LocalHost)) {
+        qWarning() << "failed to listen for preview data" << m_server->errorString();
+        delete m_server;
+        m_server = nullptr;
+        m_listenFailed = true;
+        return false;
+    }
+
+    connect(m_server, &QTcpServer::newConnection,
+            this, &PreviewDataServer::handleNewConnection);
+    return true;
+}
+
+QString PreviewDataServer::registerAdapter(MarkdownViewerAdapter *p_adapter)
+{
+    if (!listen()) {
+        return QString();
+    }
+
+    const int id = ++m_lastAdapterId;
+    m_adapters.insert(id, p_adapter);
+    return QString("http://127.0.0.1:%1/%2/%3/").arg(QString::number(m_server->serverPort()),
+                                                     m_token,
+                                                     QString::number(id));
+}
+
+void PreviewDataServer::unregisterAdapter(const MarkdownViewerAdapter *p_adapter)
+{
+    for (auto it = m_adapters.begin(); it != m_adapters.end(); ++it) {
+        if (it.value() == p_adapter) {
+            m_adapters.erase(it);
+            return;
+        }
+    }
+}
+
+void PreviewDataServer::handleNewConnection()
+{
+    while (auto socket = m_server->nextPendingConnection()) {
+        m_requests.insert(socket, QSharedPointer<Request>::create());
+
+        // Drop stalled clients, including the ones not closing after the reply.
+        auto idleTimer = new QTimer(socket);
+        idleTimer->setSingleShot(true);
+        idleTimer->setInterval(c_idleTimeout);
+        connect(idleTimer, &QTimer::timeout,
+                this, [this, socket]() {
+                    qWarning() << "close idle preview data connection";
+                    m_requests.remove(socket);
+                    socket->abort();
+                    socket->deleteLater();
+                });
+        idleTimer->start();
+
+        connect(socket, &QTcpSocket::readyRead,
+                this, [this, socket, idleTimer]() {
+                    idleTimer->start();
+                    handleReadyRead(socket);
+                });
+        connect(socket, &QTcpSocket::disconnected,
+                this, [this, socket]() {
+                    m_requests.remove(socket);
+                    socket->deleteLater();
+                });
+    }
+}
+
+void PreviewDataServer::handleReadyRead(QTcpSocket *p_socket)
+{
+    auto request = m_requests.value(p_socket);
+    if (!request) {
+        return;
+    }
+
+    request->m_buffer += p_socket->readAll();
+
+    if (!request->m_headerReady) {
+        const int idx = request->m_buffer.indexOf("\r\n\r\n");
+        if (idx == -1) {
+            if (request->m_buffer.size() > c_maxHeaderSize) {
+                reply(p_socket, 400, "Bad Request");
+                m_requests.remove(p_socket);
+            }
+            return;
+        }
+
+        request->m_bodyOffset = idx + 4;
+        if (!parseHeader(*request)) {
+            reply(p_socket, 400, "Bad Request");
+            m_requests.remove(p_socket);
+            return;
+        }
+        request->m_headerReady = true;
+    }
+
+    if (request->m_buffer.size() - request->m_bodyOffset < request->m_contentLength) {
+        return;
+    }
+
+    m_requests.remove(p_socket);
+    handleRequest(p_socket, *request);
+}
+
+bool PreviewDataServer::parseHeader(Request &p_request)
+{
+    const auto lines = p_request.m_buffer.left(p_request.m_bodyOffset - 4).split('\n');
+    const auto requestLine = lines[0].trimmed().split(' ');
+    if (requestLine.size() < 2) {
+        return false;
+    }
+
+    p_request.m_method = requestLine[0];
+    p_request.m_url = QUrl(QString::fromLatin1(requestLine[1]));
+
+    for (int i = 1; i < lines.size(); ++i) {
+        const auto &line = lines[i];
+        const int idx = line.indexOf(':');
+        if (idx > 0 && line.left(idx).trimmed().toLower() == "content-length") {
+            bool ok = false;
+            p_request.m_contentLength = line.mid(idx + 1).trimmed().toLongLong(&ok);
+            if (!ok || p_request.m_contentLength < 0 || p_request.m_contentLength > c_maxBodySize) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void PreviewDataServer::handleRequest(QTcpSocket *p_socket, const Request &p_request)
+{
+    if (p_request.m_method == "OPTIONS") {
+        // CORS preflight from the file:// page.
+        reply(p_socket, 204, "No Content");
+        return;
+    }
+
+    // /<token>/<adapter ID>/<graph|math>.
+    const auto parts = p_request.m_url.path().split(QLatin1Char('/'), QString::SkipEmptyParts);
+    if (p_request.m_method != "POST" || parts.size() != 3 || parts[0] != m_token) {
+        reply(p_socket, 404, "Not Found");
+        return;
+    }
+
+    const QPointer<MarkdownViewerAdapter> adapter = m_adapters.value(parts[1].toInt());
+    const bool isMath = parts[2] == QStringLiteral("math");
+    if (!adapter || (!isMath && parts[2] != QStringLiteral("graph"))) {
+        reply(p_socket, 404, "Not Found");
+        return;
+    }
+
+    reply(p_socket, 204, "No Content");
+
+    const QUrlQuery query(p_request.m_url);
+    MarkdownViewerAdapter::PreviewData data(query.queryItemValue(QStringLiteral("id")).toULongLong(),
+                                            query.queryItemValue(QStringLiteral("timeStamp")).toULongLong(),
+                                            query.queryItemValue(QStringLiteral("format")),
+                                            p_request.m_buffer.mid(p_request.m_bodyOffset, p_request.m_contentLength),
+                                            query.queryItemValue(QStringLiteral("needScale")) == QStringLiteral("1"));
+
+    // Decode raster images in background. SVG is left to the consumer since it depends on the scale.
+    auto watcher = new QFutureWatcher<MarkdownViewerAdapter::PreviewData>(this);
+    connect(watcher, &QFutureWatcher<MarkdownViewerAdapter::PreviewData>::finished,
+            this, [watcher, adapter, isMath]() {
+                const auto data = watcher->result();
+                watcher->deleteLater();
+                if (!adapter) {
+                    return;
+                }
+
+                if (isMath) {
+                    emit adapter->mathPreviewDataReady(data);
+                } else {
+                    emit adapter->graphPreviewDataReady(data);
+                }
+            });
+    watcher->setFuture(QtConcurrent::run([](MarkdownViewerAdapter::PreviewData p_data) {
+        if (!p_data.m_data.isEmpty() && p_data.m_format != QStringLiteral("svg")) {
+            p_data.m_image.loadFromData(p_data.m_data, p_data.m_format.toLatin1().constData());
+        }
+        return p_data;
+    }, data));
+}
+
+void PreviewDataServer::reply(QTcpSocket *p_socket, int p_status, const QByteArray &p_reason)
+{
+    QByteArray resp("HTTP/1.1 ");
+    resp += QByteArray::number(p_status) + ' ' + p_reason + "\r\n";
+    resp += "Access-Control-Allow-Origin: *\r\n"
+            "Access-Control-Allow-Methods: POST\r\n"
+            "Access-Control-Allow-Headers: Content-Type\r\n"
+            "Content-Length: 0\r\n"
+            "Connection: close\r\n\r\n";
+    p_socket->write(resp);
+    p_socket->disconnectFromHost();
+}
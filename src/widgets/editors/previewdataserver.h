@@ -0,0 +1,65 @@
+#ifndef PREVIEWDATASERVER_H
+#define PREVIEWDATASERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QSharedPointer>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace vnotex
+{
+    class MarkdownViewerAdapter;
+
+    // Local HTTP endpoint for the web side to post rendered preview data as raw
+    // bytes instead of strings through the web channel.
+    // Raster images are decoded in background before being handed to the adapter.
+    // Request: POST <adapter URL><graph|math>?id=&timeStamp=&format=&needScale= with the data as body.
+    class PreviewDataServer : public QObject
+    {
+        Q_OBJECT
+    public:
+        static PreviewDataServer &getInst();
+
+        // Return the URL prefix for @p_adapter to post data to. Empty if not available.
+        QString registerAdapter(MarkdownViewerAdapter *p_adapter);
+
+        void unregisterAdapter(const MarkdownViewerAdapter *p_adapter);
+
+    private:
+        struct Request;
+
+        explicit PreviewDataServer(QObject *p_parent = nullptr);
+
+        bool listen();
+
+        void handleNewConnection();
+
+        void handleReadyRead(QTcpSocket *p_socket);
+
+        // Return false if @p_request is invalid.
+        bool parseHeader(Request &p_request);
+
+        void handleRequest(QTcpSocket *p_socket, const Request &p_request);
+
+        static void reply(QTcpSocket *p_socket, int p_status, const QByteArray &p_reason);
+
+        QTcpServer *m_server = nullptr;
+
+        bool m_listenFailed = false;
+
+        // Random path prefix to keep other local clients out.
+        QString m_token;
+
+        int m_lastAdapterId = 0;
+
+        QHash<int, QPointer<MarkdownViewerAdapter>> m_adapters;
+
+        // Requests being received.
+        QHash<QTcpSocket *, QSharedPointer<Request>> m_requests;
+    };
+} // ns vnotex
+
+#endif // PREVIEWDATASERVER_H
@@ -3,18 +3,33 @@
 #include <QDebug>
 #include <QTextDocument>
 #include <QTextBlock>
+#include <QTextEdit>
+#include <QHash>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 #include <vtextedit/pegmarkdownhighlighterdata.h>
 #include <vtextedit/texteditorconfig.h>
 #include <vtextedit/previewmgr.h>
+#include <vtextedit/vtextedit.h>
 
 #include <utils/textutils.h>
 #include <utils/utils.h>
+#include <core/previewdiskcache.h>
+#include <core/vnotex.h>
+#include <core/thememgr.h>
 
 #include "markdowneditor.h"
+#include "previewrenderer.h"
 
 using namespace vnotex;
 
+// Language used as the disk cache key of math blocks.
+static const QString c_mathLang = QStringLiteral("math");
+
+// Requests of each kind sent to PreviewRenderer at the same time.
+static const int c_maxInflightRequests = 4;
+
 PreviewHelper::CodeBlockPreviewData::CodeBlockPreviewData(const vte::peg::FencedCodeBlock &p_codeBlock)
     : m_startBlock(p_codeBlock.m_startBlock),
       m_endBlock(p_codeBlock.m_endBlock),
@@ -45,6 +60,33 @@ void PreviewHelper::CodeBlockPreviewData::updateInplacePreview(QTextDocument *p_
     }
 }
 
+bool PreviewHelper::CodeBlockPreviewData::moveTo(const vte::peg::FencedCodeBlock &p_codeBlock,
+                                                 QTextDocument *p_doc,
+                                                 int p_tabStopWidth)
+{
+    m_startBlock = p_codeBlock.m_startBlock;
+    m_endBlock = p_codeBlock.m_endBlock;
+    if (!m_inplacePreview) {
+        return false;
+    }
+
+    const auto block = p_doc->findBlockByNumber(m_endBlock);
+    if (block.isValid()
+        && m_inplacePreview->m_blockNumber == m_endBlock
+        && m_inplacePreview->m_blockPos == block.position()) {
+        return false;
+    }
+
+    // Items may be held by the editor. Create a new one.
+    const auto oldPreview = m_inplacePreview;
+    updateInplacePreview(p_doc,
+                         oldPreview->m_image,
+                         oldPreview->m_name,
+                         oldPreview->m_backgroundColor,
+                         p_tabStopWidth);
+    return true;
+}
+
 PreviewHelper::MathBlockPreviewData::MathBlockPreviewData(const vte::peg::MathBlock &p_mathBlock)
     : m_blockNumber(p_mathBlock.m_blockNumber),
       m_previewedAsBlock(p_mathBlock.m_previewedAsBlock),
@@ -74,39 +116,81 @@ void PreviewHelper::MathBlockPreviewData::updateInplacePreview(QTextDocument *p_
     }
 }
 
+bool PreviewHelper::MathBlockPreviewData::moveTo(const vte::peg::MathBlock &p_mathBlock,
+                                                 QTextDocument *p_doc,
+                                                 int p_tabStopWidth)
+{
+    m_blockNumber = p_mathBlock.m_blockNumber;
+    m_previewedAsBlock = p_mathBlock.m_previewedAsBlock;
+    m_index = p_mathBlock.m_index;
+    m_length = p_mathBlock.m_length;
+    if (!m_inplacePreview) {
+        return false;
+    }
+
+    const auto block = p_doc->findBlockByNumber(m_blockNumber);
+    if (block.isValid()
+        && m_inplacePreview->m_blockNumber == m_blockNumber
+        && m_inplacePreview->m_blockPos == block.position()
+        && m_inplacePreview->m_startPos == block.position() + m_index
+        && m_inplacePreview->m_endPos == m_inplacePreview->m_startPos + m_length
+        && m_inplacePreview->m_isBlockwise == m_previewedAsBlock) {
+        return false;
+    }
+
+    const auto oldPreview = m_inplacePreview;
+    updateInplacePreview(p_doc, oldPreview->m_image, oldPreview->m_name, p_tabStopWidth);
+    return true;
+}
+
+void PreviewHelper::PreviewQueue::push(quint64 p_id)
+{
+    if (m_pending.isEmpty() && m_inflight == 0) {
+        m_timer.start();
+        m_visiblePreviewed = false;
+    }
+
+    m_pending.push_back(p_id);
+}
+
 int PreviewHelper::GraphPreviewData::s_imageIndex = 0;
 
-PreviewHelper::GraphPreviewData::GraphPreviewData(TimeStamp p_timeStamp,
-                                                  const QString &p_format,
-                                                  const QByteArray &p_data,
-                                                  QRgb p_background,
-                                                  qreal p_scaleFactor)
-    : m_timeStamp(p_timeStamp),
+PreviewHelper::GraphPreviewData::GraphPreviewData(const QImage &p_image, QRgb p_background)
+    : m_image(p_image),
       m_background(p_background)
 {
-    if (p_data.isEmpty()) {
-        return;
+    if (!m_image.isNull()) {
+        m_name = QString::number(++s_imageIndex);
     }
+}
 
-    m_name = QString::number(++s_imageIndex);
-
-    bool needScale = p_scaleFactor > 1.01;
-    if (needScale) {
-        if (p_format == QStringLiteral("svg")) {
-            m_image = Utils::svgToPixmap(p_data, p_background, p_scaleFactor);
-        } else {
-            QPixmap tmpImg;
-            tmpImg.loadFromData(p_data, p_format.toLocal8Bit().data());
-            m_image = tmpImg.scaledToWidth(tmpImg.width() * p_scaleFactor, Qt::SmoothTransformation);
-        }
-    } else {
-        m_image.loadFromData(p_data, p_format.toLocal8Bit().data());
+const QPixmap &PreviewHelper::GraphPreviewData::getPixmap()
+{
+    if (m_pixmap.isNull() && !m_image.isNull()) {
+        m_pixmap = QPixmap::fromImage(m_image);
     }
+    return m_pixmap;
 }
 
-bool PreviewHelper::GraphPreviewData::isNull() const
+QImage PreviewHelper::GraphPreviewData::decode(const MarkdownViewerAdapter::PreviewData &p_data, qreal p_scaleFactor)
 {
-    return m_timeStamp == 0;
+    if (p_data.m_data.isEmpty()) {
+        return QImage();
+    }
+
+    const bool needScale = p_scaleFactor > 1.01;
+    if (p_data.m_format == QStringLiteral("svg")) {
+        return Utils::svgToImage(p_data.m_data, 0x0, needScale ? p_scaleFactor : 1);
+    }
+
+    auto image = p_data.m_image;
+    if (image.isNull()) {
+        image.loadFromData(p_data.m_data, p_data.m_format.toLocal8Bit().data());
+    }
+    if (needScale && !image.isNull()) {
+        image = image.scaledToWidth(image.width() * p_scaleFactor, Qt::SmoothTransformation);
+    }
+    return image;
 }
 
 PreviewHelper::PreviewHelper(MarkdownEditor *p_editor, QObject *p_parent)
@@ -131,10 +215,20 @@ void PreviewHelper::codeBlocksUpdated(vte::TimeStamp p_timeStamp,
         return;
     }
 
-    ++m_codeBlockTimeStamp;
-    m_codeBlocksData.clear();
+    // Diff against previous blocks by text so that unchanged blocks keep their
+    // previews and requests.
+    QVector<CodeBlockPreviewData> oldBlocksData;
+    oldBlocksData.swap(m_codeBlocksData);
+    m_codeBlocksData.reserve(p_codeBlocks.size());
+
+    // Text -> indexes of old blocks not matched yet, in descending order.
+    QHash<QString, QVector<int>> oldBlocks;
+    for (int i = oldBlocksData.size() - 1; i >= 0; --i) {
+        oldBlocks[oldBlocksData[i].m_text].push_back(i);
+    }
 
-    bool needUpdateEditorInplacePreview = true;
+    bool changed = false;
+    bool hasPendingBlocks = false;
 
     for (const auto &cb : p_codeBlocks) {
         const auto needPreview = isLangNeedPreview(cb.m_lang);
@@ -142,32 +236,49 @@ void PreviewHelper::codeBlocksUpdated(vte::TimeStamp p_timeStamp,
             continue;
         }
 
+        auto it = oldBlocks.find(cb.m_text);
+        if (it != oldBlocks.end() && !it.value().isEmpty()) {
+            m_codeBlocksData.append(oldBlocksData[it.value().takeLast()]);
+            if (m_codeBlocksData.last().moveTo(cb, m_document, m_tabStopWidth)) {
+                changed = true;
+            }
+            continue;
+        }
+
+        changed = true;
         m_codeBlocksData.append(CodeBlockPreviewData(cb));
-        const int blockPreviewIdx = m_codeBlocksData.size() - 1;
+        auto &blockData = m_codeBlocksData.last();
+        blockData.m_id = ++m_lastBlockId;
+        blockData.m_text = cb.m_text;
 
-        bool cacheHit = false;
-        auto &cachedData = m_codeBlockCache.get(cb.m_text);
+        auto cachedData = m_codeBlockCache.get(cb.m_text);
         if (cachedData) {
-            cacheHit = true;
-            cachedData->m_timeStamp = m_codeBlockTimeStamp;
-            m_codeBlocksData[blockPreviewIdx].updateInplacePreview(m_document,
-                                                                   cachedData->m_image,
-                                                                   cachedData->m_name,
-                                                                   cachedData->m_background,
-                                                                   m_tabStopWidth);
+            blockData.updateInplacePreview(m_document,
+                                           cachedData->getPixmap(),
+                                           cachedData->m_name,
+                                           cachedData->m_background,
+                                           m_tabStopWidth);
+        } else if (needPreview.first) {
+            // No need to update in-place preview for now.
+            hasPendingBlocks = true;
+
+            loadDiskCache(false, cb.m_lang, cb.m_text, blockData.m_id);
         }
+    }
 
-        if (m_inplacePreviewEnabled && needPreview.first && !cacheHit) {
-            // No need to update in-place preview for now.
-            needUpdateEditorInplacePreview = false;
-            m_codeBlocksData[blockPreviewIdx].m_text = cb.m_text;
-            inplacePreviewCodeBlock(blockPreviewIdx);
+    // Drop requests of removed blocks not sent yet.
+    for (const auto &idxes : oldBlocks) {
+        for (int idx : idxes) {
+            changed = true;
+            m_codeBlockQueue.m_pending.removeOne(oldBlocksData[idx].m_id);
         }
     }
 
-    if (needUpdateEditorInplacePreview) {
+    if (changed && !hasPendingBlocks) {
         updateEditorInplacePreviewCodeBlock();
     }
+
+    requestPendingPreviews();
 }
 
 bool PreviewHelper::checkPreviewSourceLang(SourceFlag p_flag, const QString &p_lang) const
@@ -224,39 +335,33 @@ void PreviewHelper::inplacePreviewCodeBlock(int p_blockPreviewIdx)
         || checkPreviewSourceLang(SourceFlag::PlantUml, blockData.m_lang)
         || checkPreviewSourceLang(SourceFlag::Graphviz, blockData.m_lang)
         || checkPreviewSourceLang(SourceFlag::Math, blockData.m_lang)) {
-        emit graphPreviewRequested(p_blockPreviewIdx,
-                                   m_codeBlockTimeStamp,
-                                   blockData.m_lang,
-                                   TextUtils::removeCodeBlockFence(blockData.m_text));
+        PreviewRenderer::getInst().requestGraphPreview(this,
+                                                       blockData.m_id,
+                                                       blockData.m_lang,
+                                                       TextUtils::removeCodeBlockFence(blockData.m_text));
     }
 }
 
 void PreviewHelper::handleGraphPreviewData(const MarkdownViewerAdapter::PreviewData &p_data)
 {
-    if (p_data.m_timeStamp != m_codeBlockTimeStamp) {
+    // Keep the renderer busy while handling this result.
+    --m_codeBlockQueue.m_inflight;
+    requestPendingPreviews();
+
+    const int idx = indexOfCodeBlock(p_data.m_id);
+    if (idx == -1) {
         return;
     }
-    if (p_data.m_id >= static_cast<quint64>(m_codeBlocksData.size()) || p_data.m_data.isEmpty()) {
+
+    if (p_data.m_data.isEmpty()) {
         updateEditorInplacePreviewCodeBlock();
         return;
     }
 
-    auto &blockData = m_codeBlocksData[p_data.m_id];
-    auto previewData = QSharedPointer<GraphPreviewData>::create(p_data.m_timeStamp,
-                                                                p_data.m_format,
-                                                                p_data.m_data,
-                                                                0,
-                                                                p_data.m_needScale ? getEditorScaleFactor() : 1);
-    m_codeBlockCache.set(blockData.m_text, previewData);
-    blockData.m_text.clear();
-
-    blockData.updateInplacePreview(m_document,
-                                   previewData->m_image,
-                                   previewData->m_name,
-                                   previewData->m_background,
-                                   m_tabStopWidth);
+    const auto &blockData = m_codeBlocksData[idx];
+    writeDiskCache(blockData.m_lang, blockData.m_text, p_data);
 
-    updateEditorInplacePreviewCodeBlock();
+    decodePreviewData(false, p_data);
 }
 
 void PreviewHelper::updateEditorInplacePreviewCodeBlock()
@@ -298,53 +403,82 @@ void PreviewHelper::setMarkdownEditor(MarkdownEditor *p_editor)
     if (m_editor) {
         m_document = m_editor->document();
         m_tabStopWidth = m_editor->getConfig().m_tabStopWidth;
+
+        PreviewRenderer::getInst().warmUp();
     }
 }
 
+void PreviewHelper::setInplacePreviewEnabled(bool p_enabled)
+{
+    m_inplacePreviewEnabled = p_enabled;
+}
+
 void PreviewHelper::mathBlocksUpdated(const QVector<vte::peg::MathBlock> &p_mathBlocks)
 {
     if (!m_inplacePreviewEnabled || !isInplacePreviewSourceEnabled(SourceFlag::Math)) {
         return;
     }
 
-    ++m_mathBlockTimeStamp;
-    m_mathBlocksData.clear();
+    QVector<MathBlockPreviewData> oldBlocksData;
+    oldBlocksData.swap(m_mathBlocksData);
     m_mathBlocksData.reserve(p_mathBlocks.size());
 
-    bool needUpdateEditorInplacePreview = true;
+    QHash<QString, QVector<int>> oldBlocks;
+    for (int i = oldBlocksData.size() - 1; i >= 0; --i) {
+        oldBlocks[oldBlocksData[i].m_text].push_back(i);
+    }
+
+    bool changed = false;
+    bool hasPendingBlocks = false;
 
     for (const auto &mb : p_mathBlocks) {
+        auto it = oldBlocks.find(mb.m_text);
+        if (it != oldBlocks.end() && !it.value().isEmpty()) {
+            m_mathBlocksData.append(oldBlocksData[it.value().takeLast()]);
+            if (m_mathBlocksData.last().moveTo(mb, m_document, m_tabStopWidth)) {
+                changed = true;
+            }
+            continue;
+        }
+
+        changed = true;
         m_mathBlocksData.append(MathBlockPreviewData(mb));
-        const int blockPreviewIdx = m_mathBlocksData.size() - 1;
+        auto &blockData = m_mathBlocksData.last();
+        blockData.m_id = ++m_lastBlockId;
+        blockData.m_text = mb.m_text;
 
-        bool cacheHit = false;
-        auto &cachedData = m_mathBlockCache.get(mb.m_text);
+        auto cachedData = m_mathBlockCache.get(mb.m_text);
         if (cachedData) {
-            cacheHit = true;
-            cachedData->m_timeStamp = m_mathBlockTimeStamp;
-            m_mathBlocksData[blockPreviewIdx].updateInplacePreview(m_document,
-                                                                   cachedData->m_image,
-                                                                   cachedData->m_name,
-                                                                   m_tabStopWidth);
+            blockData.updateInplacePreview(m_document,
+                                           cachedData->getPixmap(),
+                                           cachedData->m_name,
+                                           m_tabStopWidth);
+        } else {
+            hasPendingBlocks = true;
+
+            loadDiskCache(true, c_mathLang, mb.m_text, blockData.m_id);
         }
+    }
 
-        if (!cacheHit) {
-            needUpdateEditorInplacePreview = false;
-            m_mathBlocksData[blockPreviewIdx].m_text = mb.m_text;
-            inplacePreviewMathBlock(blockPreviewIdx);
+    for (const auto &idxes : oldBlocks) {
+        for (int idx : idxes) {
+            changed = true;
+            m_mathBlockQueue.m_pending.removeOne(oldBlocksData[idx].m_id);
         }
     }
 
-    if (needUpdateEditorInplacePreview) {
+    if (changed && !hasPendingBlocks) {
         updateEditorInplacePreviewMathBlock();
     }
+
+    requestPendingPreviews();
 }
 
 void PreviewHelper::inplacePreviewMathBlock(int p_blockPreviewIdx)
 {
     const auto &blockData = m_mathBlocksData[p_blockPreviewIdx];
     Q_ASSERT(!blockData.m_text.isEmpty());
-    emit mathPreviewRequested(p_blockPreviewIdx, m_mathBlockTimeStamp, blockData.m_text);
+    PreviewRenderer::getInst().requestMathPreview(this, blockData.m_id, blockData.m_text);
 }
 
 void PreviewHelper::updateEditorInplacePreviewMathBlock()
@@ -381,29 +515,209 @@ void PreviewHelper::updateEditorInplacePreviewMathBlock()
 
 void PreviewHelper::handleMathPreviewData(const MarkdownViewerAdapter::PreviewData &p_data)
 {
-    if (p_data.m_timeStamp != m_mathBlockTimeStamp) {
+    --m_mathBlockQueue.m_inflight;
+    requestPendingPreviews();
+
+    const int idx = indexOfMathBlock(p_data.m_id);
+    if (idx == -1) {
         return;
     }
-    if (p_data.m_id >= static_cast<quint64>(m_mathBlocksData.size()) || p_data.m_data.isEmpty()) {
+
+    if (p_data.m_data.isEmpty()) {
         updateEditorInplacePreviewMathBlock();
         return;
     }
 
-    auto &blockData = m_mathBlocksData[p_data.m_id];
-    auto previewData = QSharedPointer<GraphPreviewData>::create(p_data.m_timeStamp,
-                                                                p_data.m_format,
-                                                                p_data.m_data,
-                                                                0,
-                                                                p_data.m_needScale ? getEditorScaleFactor() : 1);
-    m_mathBlockCache.set(blockData.m_text, previewData);
-    blockData.m_text.clear();
+    writeDiskCache(c_mathLang, m_mathBlocksData[idx].m_text, p_data);
 
-    blockData.updateInplacePreview(m_document,
-                                   previewData->m_image,
-                                   previewData->m_name,
-                                   m_tabStopWidth);
+    decodePreviewData(true, p_data);
+}
 
-    updateEditorInplacePreviewMathBlock();
+void PreviewHelper::decodePreviewData(bool p_isMath, const MarkdownViewerAdapter::PreviewData &p_data)
+{
+    const qreal scaleFactor = p_data.m_needScale ? getEditorScaleFactor() : 1;
+
+    auto watcher = new QFutureWatcher<DecodedImage>(this);
+    connect(watcher, &QFutureWatcher<DecodedImage>::finished,
+            this, [this, watcher, p_isMath, p_data]() {
+                const auto decoded = watcher->result();
+                watcher->deleteLater();
+                handleDecodedPreviewData(p_isMath, p_data, decoded, false);
+            });
+    watcher->setFuture(QtConcurrent::run([p_data, scaleFactor]() {
+        QElapsedTimer timer;
+        timer.start();
+
+        DecodedImage decoded;
+        decoded.m_image = GraphPreviewData::decode(p_data, scaleFactor);
+        decoded.m_elapsedMsecs = timer.elapsed();
+        return decoded;
+    }));
+}
+
+void PreviewHelper::handleDecodedPreviewData(bool p_isMath,
+                                             const MarkdownViewerAdapter::PreviewData &p_data,
+                                             const DecodedImage &p_decoded,
+                                             bool p_fromDiskCache)
+{
+    // The block may be gone or changed meanwhile.
+    const int idx = p_isMath ? indexOfMathBlock(p_data.m_id) : indexOfCodeBlock(p_data.m_id);
+    if (idx == -1) {
+        return;
+    }
+
+    if (p_decoded.m_image.isNull() && p_fromDiskCache) {
+        // Render it again.
+        (p_isMath ? m_mathBlockQueue : m_codeBlockQueue).push(p_data.m_id);
+        requestPendingPreviews();
+        return;
+    }
+
+    auto previewData = QSharedPointer<GraphPreviewData>::create(p_decoded.m_image);
+    const auto range = getVisibleBlockRange();
+    if (p_isMath) {
+        checkVisiblePreviewed(m_mathBlockQueue,
+                              QStringLiteral("math block"),
+                              distanceToVisibleMathBlock(idx, range));
+
+        auto &blockData = m_mathBlocksData[idx];
+        m_mathBlockCache.set(blockData.m_text, previewData);
+
+        blockData.updateInplacePreview(m_document,
+                                       previewData->getPixmap(),
+                                       previewData->m_name,
+                                       m_tabStopWidth);
+
+        updateEditorInplacePreviewMathBlock();
+    } else {
+        checkVisiblePreviewed(m_codeBlockQueue,
+                              QStringLiteral("code block"),
+                              distanceToVisibleCodeBlock(idx, range));
+
+        auto &blockData = m_codeBlocksData[idx];
+        m_codeBlockCache.set(blockData.m_text, previewData);
+
+        blockData.updateInplacePreview(m_document,
+                                       previewData->getPixmap(),
+                                       previewData->m_name,
+                                       previewData->m_background,
+                                       m_tabStopWidth);
+
+        updateEditorInplacePreviewCodeBlock();
+    }
+}
+
+void PreviewHelper::requestPendingPreviews()
+{
+    if (m_codeBlockQueue.m_pending.isEmpty() && m_mathBlockQueue.m_pending.isEmpty()) {
+        return;
+    }
+
+    const auto range = getVisibleBlockRange();
+
+    while (m_codeBlockQueue.m_inflight < c_maxInflightRequests && !m_codeBlockQueue.m_pending.isEmpty()) {
+        const auto id = takeClosestPending(m_codeBlockQueue, [this, &range](quint64 p_id) {
+            return distanceToVisibleCodeBlock(indexOfCodeBlock(p_id), range);
+        });
+        ++m_codeBlockQueue.m_inflight;
+        inplacePreviewCodeBlock(indexOfCodeBlock(id));
+    }
+
+    while (m_mathBlockQueue.m_inflight < c_maxInflightRequests && !m_mathBlockQueue.m_pending.isEmpty()) {
+        const auto id = takeClosestPending(m_mathBlockQueue, [this, &range](quint64 p_id) {
+            return distanceToVisibleMathBlock(indexOfMathBlock(p_id), range);
+        });
+        ++m_mathBlockQueue.m_inflight;
+        inplacePreviewMathBlock(indexOfMathBlock(id));
+    }
+}
+
+quint64 PreviewHelper::takeClosestPending(PreviewQueue &p_queue, const std::function<int(quint64)> &p_distanceFunc)
+{
+    Q_ASSERT(!p_queue.m_pending.isEmpty());
+    int closest = 0;
+    int minDistance = p_distanceFunc(p_queue.m_pending[0]);
+    for (int i = 1; i < p_queue.m_pending.size() && minDistance > 0; ++i) {
+        const int distance = p_distanceFunc(p_queue.m_pending[i]);
+        if (distance < minDistance) {
+            minDistance = distance;
+            closest = i;
+        }
+    }
+
+    const auto id = p_queue.m_pending[closest];
+    p_queue.m_pending.remove(closest);
+    return id;
+}
+
+void PreviewHelper::checkVisiblePreviewed(PreviewQueue &p_queue, const QString &p_name, int p_distance)
+{
+    if (p_queue.m_visiblePreviewed || p_distance > 0) {
+        return;
+    }
+
+    p_queue.m_visiblePreviewed = true;
+    if (!p_queue.m_timer.isValid()) {
+        // No request sent in this round.
+        return;
+    }
+
+    qDebug() << "first visible" << p_name << "preview in" << p_queue.m_timer.elapsed() << "ms"
+             << p_queue.m_pending.size() << "pending";
+}
+
+QPair<int, int> PreviewHelper::getVisibleBlockRange() const
+{
+    if (!m_editor) {
+        return qMakePair(0, 0);
+    }
+
+    auto textEdit = m_editor->getTextEdit();
+    const auto rect = textEdit->viewport()->rect();
+    return qMakePair(textEdit->cursorForPosition(rect.topLeft()).blockNumber(),
+                     textEdit->cursorForPosition(rect.bottomLeft()).blockNumber());
+}
+
+int PreviewHelper::distanceToRange(int p_first, int p_last, const QPair<int, int> &p_range)
+{
+    if (p_last < p_range.first) {
+        return p_range.first - p_last;
+    } else if (p_first > p_range.second) {
+        return p_first - p_range.second;
+    }
+    return 0;
+}
+
+int PreviewHelper::distanceToVisibleCodeBlock(int p_blockPreviewIdx, const QPair<int, int> &p_range) const
+{
+    const auto &blockData = m_codeBlocksData[p_blockPreviewIdx];
+    return distanceToRange(blockData.m_startBlock, blockData.m_endBlock, p_range);
+}
+
+int PreviewHelper::distanceToVisibleMathBlock(int p_blockPreviewIdx, const QPair<int, int> &p_range) const
+{
+    const int blockNumber = m_mathBlocksData[p_blockPreviewIdx].m_blockNumber;
+    return distanceToRange(blockNumber, blockNumber, p_range);
+}
+
+int PreviewHelper::indexOfCodeBlock(quint64 p_id) const
+{
+    for (int i = 0; i < m_codeBlocksData.size(); ++i) {
+        if (m_codeBlocksData[i].m_id == p_id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int PreviewHelper::indexOfMathBlock(quint64 p_id) const
+{
+    for (int i = 0; i < m_mathBlocksData.size(); ++i) {
+        if (m_mathBlocksData[i].m_id == p_id) {
+            return i;
+        }
+    }
+    return -1;
 }
 
 qreal PreviewHelper::getEditorScaleFactor() const
@@ -414,3 +728,71 @@ qreal PreviewHelper::getEditorScaleFactor() const
 
     return 1;
 }
+
+QString PreviewHelper::generateDiskCacheKey(const QString &p_lang, const QString &p_text) const
+{
+    const auto &themeMgr = VNoteX::getInst().getThemeMgr();
+    return PreviewDiskCache::generateKey(p_lang,
+                                         p_text,
+                                         getEditorScaleFactor(),
+                                         themeMgr.getCurrentTheme().name(),
+                                         themeMgr.getBaseBackground().rgba());
+}
+
+void PreviewHelper::loadDiskCache(bool p_isMath, const QString &p_lang, const QString &p_text, quint64 p_id)
+{
+    const auto key = generateDiskCacheKey(p_lang, p_text);
+    const qreal scaleFactor = getEditorScaleFactor();
+    auto cache = &PreviewDiskCache::getInst();
+
+    auto watcher = new QFutureWatcher<DiskCacheResult>(this);
+    connect(watcher, &QFutureWatcher<DiskCacheResult>::finished,
+            this, [this, watcher, p_isMath]() {
+                const auto result = watcher->result();
+                watcher->deleteLater();
+                if (result.m_hit) {
+                    handleDecodedPreviewData(p_isMath, result.m_data, result.m_decoded, true);
+                    return;
+                }
+
+                // The block may be gone meanwhile.
+                const int idx = p_isMath ? indexOfMathBlock(result.m_data.m_id) : indexOfCodeBlock(result.m_data.m_id);
+                if (idx == -1) {
+                    return;
+                }
+
+                (p_isMath ? m_mathBlockQueue : m_codeBlockQueue).push(result.m_data.m_id);
+                requestPendingPreviews();
+            });
+    watcher->setFuture(QtConcurrent::run([cache, key, scaleFactor, p_id]() {
+        DiskCacheResult result;
+        result.m_data.m_id = p_id;
+
+        PreviewDiskCache::Entry entry;
+        if (!cache->get(key, entry)) {
+            return result;
+        }
+
+        result.m_hit = true;
+        result.m_data.m_format = entry.m_format;
+        result.m_data.m_data = entry.m_data;
+        result.m_data.m_needScale = entry.m_needScale;
+
+        QElapsedTimer timer;
+        timer.start();
+        result.m_decoded.m_image = GraphPreviewData::decode(result.m_data, entry.m_needScale ? scaleFactor : 1);
+        result.m_decoded.m_elapsedMsecs = timer.elapsed();
+        return result;
+    }));
+}
+
+void PreviewHelper::writeDiskCache(const QString &p_lang,
+                                   const QString &p_text,
+                                   const MarkdownViewerAdapter::PreviewData &p_data) const
+{
+    PreviewDiskCache::Entry entry;
+    entry.m_format = p_data.m_format;
+    entry.m_data = p_data.m_data;
+    entry.m_needScale = p_data.m_needScale;
+    PreviewDiskCache::getInst().set(generateDiskCacheKey(p_lang, p_text), entry);
+}
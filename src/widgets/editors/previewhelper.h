@@ -3,10 +3,12 @@
 
 #include <QObject>
 #include <QPixmap>
+#include <QElapsedTimer>
+
+#include <functional>
 
 #include <vtextedit/global.h>
 #include <vtextedit/lrucache.h>
-#include <core/global.h>
 #include "markdownvieweradapter.h"
 
 class QTimer;
@@ -47,30 +49,20 @@ namespace vnotex
 
         void setMarkdownEditor(MarkdownEditor *p_editor);
 
+        void setInplacePreviewEnabled(bool p_enabled);
+
     public slots:
         void codeBlocksUpdated(vte::TimeStamp p_timeStamp,
                                const QVector<vte::peg::FencedCodeBlock> &p_codeBlocks);
 
         void mathBlocksUpdated(const QVector<vte::peg::MathBlock> &p_mathBlocks);
 
+        // Called by PreviewRenderer with the result of a graph preview request.
         void handleGraphPreviewData(const MarkdownViewerAdapter::PreviewData &p_data);
 
         void handleMathPreviewData(const MarkdownViewerAdapter::PreviewData &p_data);
 
     signals:
-        // Request to preview graph.
-        // There must be a corresponding call to handleGraphPreviewData().
-        void graphPreviewRequested(quint64 p_id,
-                                   TimeStamp p_timeStamp,
-                                   const QString &p_lang,
-                                   const QString &p_text);
-
-        // Request to preview math.
-        // There must be a corresponding call to handleMathPreviewData().
-        void mathPreviewRequested(quint64 p_id,
-                                  TimeStamp p_timeStamp,
-                                  const QString &p_text);
-
         // Request to do in-place preview for @p_previewItems.
         void inplacePreviewCodeBlockUpdated(const QVector<QSharedPointer<vte::PreviewItem>> &p_previewItems);
 
@@ -93,6 +85,15 @@ namespace vnotex
                                       QRgb p_background,
                                       int p_tabStopWidth);
 
+            // Update the position to the one of @p_codeBlock with the same text.
+            // Return true if the in-place preview is changed.
+            bool moveTo(const vte::peg::FencedCodeBlock &p_codeBlock,
+                        QTextDocument *p_doc,
+                        int p_tabStopWidth);
+
+            // Identify the block across updates.
+            quint64 m_id = 0;
+
             // Start and end block of the fenced code block.
             int m_startBlock = 0;
             int m_endBlock = 0;
@@ -100,7 +101,6 @@ namespace vnotex
             QString m_lang;
 
             // Including the fence text.
-            // Will be filled only when preview is needed.
             QString m_text;
 
             QSharedPointer<vte::PreviewItem> m_inplacePreview;
@@ -117,6 +117,14 @@ namespace vnotex
                                       const QString &p_imageName,
                                       int p_tabStopWidth);
 
+            // Update the position to the one of @p_mathBlock with the same text.
+            // Return true if the in-place preview is changed.
+            bool moveTo(const vte::peg::MathBlock &p_mathBlock,
+                        QTextDocument *p_doc,
+                        int p_tabStopWidth);
+
+            quint64 m_id = 0;
+
             // Block number for in-place preview.
             int m_blockNumber = -1;
 
@@ -130,7 +138,6 @@ namespace vnotex
             int m_length = -1;
 
             // Including the guarding marks.
-            // Will be filled only when preview is needed.
             QString m_text;
 
             QSharedPointer<vte::PreviewItem> m_inplacePreview;
@@ -141,17 +148,18 @@ namespace vnotex
         {
             GraphPreviewData() = default;
 
-            GraphPreviewData(TimeStamp p_timeStamp,
-                             const QString &p_format,
-                             const QByteArray &p_data,
-                             QRgb p_background = 0x0,
-                             qreal p_scaleFactor = 1);
+            GraphPreviewData(const QImage &p_image, QRgb p_background = 0x0);
+
+            // Convert to pixmap on first use.
+            const QPixmap &getPixmap();
 
-            bool isNull() const;
+            // Decode and scale the image of @p_data.
+            // Called in non-GUI threads.
+            static QImage decode(const MarkdownViewerAdapter::PreviewData &p_data, qreal p_scaleFactor);
 
-            TimeStamp m_timeStamp = 0;
+            QImage m_image;
 
-            QPixmap m_image;
+            QPixmap m_pixmap;
 
             // Name of the image for identification in resource manager.
             QString m_name;
@@ -164,6 +172,41 @@ namespace vnotex
             static int s_imageIndex;
         };
 
+        struct DecodedImage
+        {
+            QImage m_image;
+
+            qint64 m_elapsedMsecs = 0;
+        };
+
+        struct DiskCacheResult
+        {
+            bool m_hit = false;
+
+            // Only m_id is valid if missed.
+            MarkdownViewerAdapter::PreviewData m_data;
+
+            DecodedImage m_decoded;
+        };
+
+        // Preview requests waiting to be sent to PreviewRenderer.
+        struct PreviewQueue
+        {
+            // A new round starts if the queue is idle.
+            void push(quint64 p_id);
+
+            // IDs of blocks in m_codeBlocksData or m_mathBlocksData.
+            QVector<quint64> m_pending;
+
+            // Requests sent and not finished yet.
+            int m_inflight = 0;
+
+            // Elapsed time since the round started.
+            QElapsedTimer m_timer;
+
+            bool m_visiblePreviewed = false;
+        };
+
         // Return <InplacePreview, FocusPreview>.
         QPair<bool, bool> isLangNeedPreview(const QString &p_lang) const;
 
@@ -176,12 +219,53 @@ namespace vnotex
 
         void inplacePreviewMathBlock(int p_blockPreviewIdx);
 
+        // Send pending requests, the ones closest to the visible blocks first.
+        void requestPendingPreviews();
+
+        // Take the pending block with the smallest distance given by @p_distanceFunc.
+        static quint64 takeClosestPending(PreviewQueue &p_queue, const std::function<int(quint64)> &p_distanceFunc);
+
+        // Log the time of the first preview within the visible blocks of current round.
+        void checkVisiblePreviewed(PreviewQueue &p_queue, const QString &p_name, int p_distance);
+
+        // Return the first and last visible block number.
+        QPair<int, int> getVisibleBlockRange() const;
+
+        static int distanceToRange(int p_first, int p_last, const QPair<int, int> &p_range);
+
+        int distanceToVisibleCodeBlock(int p_blockPreviewIdx, const QPair<int, int> &p_range) const;
+
+        int distanceToVisibleMathBlock(int p_blockPreviewIdx, const QPair<int, int> &p_range) const;
+
+        // Return -1 if the block with @p_id is gone.
+        int indexOfCodeBlock(quint64 p_id) const;
+
+        int indexOfMathBlock(quint64 p_id) const;
+
+        // Decode @p_data in background and then update the preview of the block.
+        void decodePreviewData(bool p_isMath, const MarkdownViewerAdapter::PreviewData &p_data);
+
+        void handleDecodedPreviewData(bool p_isMath,
+                                      const MarkdownViewerAdapter::PreviewData &p_data,
+                                      const DecodedImage &p_decoded,
+                                      bool p_fromDiskCache);
+
         void updateEditorInplacePreviewCodeBlock();
 
         void updateEditorInplacePreviewMathBlock();
 
         qreal getEditorScaleFactor() const;
 
+        QString generateDiskCacheKey(const QString &p_lang, const QString &p_text) const;
+
+        // Read and decode the disk cache of block @p_id in background, and then
+        // update its preview, or queue it to render if missed.
+        void loadDiskCache(bool p_isMath, const QString &p_lang, const QString &p_text, quint64 p_id);
+
+        void writeDiskCache(const QString &p_lang,
+                            const QString &p_text,
+                            const MarkdownViewerAdapter::PreviewData &p_data) const;
+
         MarkdownEditor *m_editor = nullptr;
 
         QTextDocument *m_document = nullptr;
@@ -191,15 +275,17 @@ namespace vnotex
 
         bool m_inplacePreviewEnabled = true;
 
-        TimeStamp m_codeBlockTimeStamp = 0;
-
-        TimeStamp m_mathBlockTimeStamp = 0;
+        quint64 m_lastBlockId = 0;
 
         // Sorted by startBlock in ascending order.
         QVector<CodeBlockPreviewData> m_codeBlocksData;
 
         QVector<MathBlockPreviewData> m_mathBlocksData;
 
+        PreviewQueue m_codeBlockQueue;
+
+        PreviewQueue m_mathBlockQueue;
+
         // Tab stop width of the editor, used for block margin calculation.
         int m_tabStopWidth = 4;
 
@@ -0,0 +1,265 @@
+#include "previewrenderer.h"
+
+#include <QWebEnginePage>
+#include <QWebChannel>
+#include <QThread>
+#include <QDebug>
+
+#include <core/configmgr.h>
+#include <core/editorconfig.h>
+#include <core/markdowneditorconfig.h>
+#include <core/htmltemplatehelper.h>
+#include <core/vnotex.h>
+#include <core/thememgr.h>
+#include <utils/pathutils.h>
+
+#include "previewhelper.h"
+
+using namespace vnotex;
+
+// Jobs rendered at the same time in one page.
+static const int c_maxJobsPerWorker = 4;
+
+// Pages in the pool.
+static const int c_maxWorkerCount = qBound(1, QThread::idealThreadCount() / 2, 4);
+
+PreviewRenderer &PreviewRenderer::getInst()
+{
+    static PreviewRenderer inst;
+    return inst;
+}
+
+PreviewRenderer::PreviewRenderer(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+PreviewRenderer::~PreviewRenderer()
+{
+    close();
+}
+
+void PreviewRenderer::warmUp()
+{
+    if (m_workers.isEmpty()) {
+        updateTemplate();
+        createWorker();
+    }
+}
+
+void PreviewRenderer::requestGraphPreview(PreviewHelper *p_helper,
+                                          quint64 p_id,
+                                          const QString &p_lang,
+                                          const QString &p_text)
+{
+    Job job;
+    job.m_helper = p_helper;
+    job.m_type = JobType::Graph;
+    job.m_id = p_id;
+    job.m_lang = p_lang;
+    job.m_text = p_text;
+    enqueue(job);
+}
+
+void PreviewRenderer::requestMathPreview(PreviewHelper *p_helper,
+                                         quint64 p_id,
+                                         const QString &p_text)
+{
+    Job job;
+    job.m_helper = p_helper;
+    job.m_type = JobType::Math;
+    job.m_id = p_id;
+    job.m_text = p_text;
+    enqueue(job);
+}
+
+void PreviewRenderer::enqueue(const Job &p_job)
+{
+    // Helpers keep track of their own requests. Just drop the ones of closed helpers.
+    for (int i = m_pendingJobs.size() - 1; i >= 0; --i) {
+        if (!m_pendingJobs[i].m_helper) {
+            m_pendingJobs.remove(i);
+        }
+    }
+
+    m_pendingJobs.push_back(p_job);
+    dispatch();
+}
+
+void PreviewRenderer::dispatch()
+{
+    updateTemplate();
+
+    while (!m_pendingJobs.isEmpty()) {
+        auto worker = pickWorker();
+        if (!worker) {
+            break;
+        }
+
+        const auto job = m_pendingJobs.takeFirst();
+        if (!job.m_helper) {
+            continue;
+        }
+
+        // Job ID is unique within the page so time stamp is not used.
+        const auto jobId = ++m_lastJobId;
+        worker->m_jobs.insert(jobId, job);
+        if (job.m_type == JobType::Graph) {
+            worker->m_adapter->graphPreviewRequested(jobId, 0, job.m_lang, job.m_text);
+        } else {
+            worker->m_adapter->mathPreviewRequested(jobId, 0, job.m_text);
+        }
+    }
+}
+
+PreviewRenderer::Worker *PreviewRenderer::pickWorker()
+{
+    Worker *candidate = nullptr;
+    bool loading = false;
+    for (const auto &worker : m_workers) {
+        if (!worker->m_adapter->isViewerReady()) {
+            loading = true;
+            continue;
+        }
+
+        if (worker->m_template != m_template) {
+            // Wait for it to be reloaded.
+            continue;
+        }
+
+        if (worker->m_jobs.size() < c_maxJobsPerWorker
+            && (!candidate || worker->m_jobs.size() < candidate->m_jobs.size())) {
+            candidate = worker.data();
+        }
+    }
+
+    if (candidate && candidate->m_jobs.isEmpty()) {
+        return candidate;
+    }
+
+    // Prefer a new page to sharing a busy one.
+    if (!loading && m_workers.size() < c_maxWorkerCount) {
+        createWorker();
+    }
+
+    return candidate;
+}
+
+PreviewRenderer::Worker *PreviewRenderer::createWorker()
+{
+    auto worker = QSharedPointer<Worker>::create();
+    m_workers.push_back(worker);
+
+    auto wk = worker.data();
+    wk->m_page = new QWebEnginePage(this);
+    wk->m_page->setBackgroundColor(VNoteX::getInst().getThemeMgr().getBaseBackground());
+
+    wk->m_adapter = new MarkdownViewerAdapter(wk->m_page);
+    auto channel = new QWebChannel(wk->m_page);
+    channel->registerObject(QStringLiteral("vxAdapter"), wk->m_adapter);
+    wk->m_page->setWebChannel(channel);
+
+    connect(wk->m_adapter, &MarkdownViewerAdapter::viewerReady,
+            this, &PreviewRenderer::dispatch);
+    connect(wk->m_adapter, &MarkdownViewerAdapter::graphPreviewDataReady,
+            this, [this, wk](const MarkdownViewerAdapter::PreviewData &p_data) {
+                handlePreviewData(wk, p_data);
+            });
+    connect(wk->m_adapter, &MarkdownViewerAdapter::mathPreviewDataReady,
+            this, [this, wk](const MarkdownViewerAdapter::PreviewData &p_data) {
+                handlePreviewData(wk, p_data);
+            });
+    connect(wk->m_page, &QWebEnginePage::renderProcessTerminated,
+            this, [this, wk]() {
+                handleRenderProcessTerminated(wk);
+            });
+
+    loadWorker(wk);
+    return wk;
+}
+
+void PreviewRenderer::loadWorker(Worker *p_worker)
+{
+    Q_ASSERT(p_worker->m_jobs.isEmpty());
+    p_worker->m_adapter->setReady(false);
+    p_worker->m_template = m_template;
+
+    // Any local file URL will do to let the page load local scripts.
+    const auto baseFile = PathUtils::concatenateFilePath(ConfigMgr::getInst().getUserCacheFolder(),
+                                                         QStringLiteral("preview_renderer.html"));
+    p_worker->m_page->setHtml(m_template, PathUtils::pathToUrl(baseFile));
+}
+
+void PreviewRenderer::updateTemplate()
+{
+    const auto &markdownEditorConfig = ConfigMgr::getInst().getEditorConfig().getMarkdownEditorConfig();
+    HtmlTemplateHelper::updateMarkdownViewerTemplate(markdownEditorConfig);
+
+    const auto &tmpl = HtmlTemplateHelper::getMarkdownViewerTemplate();
+    if (tmpl == m_template) {
+        return;
+    }
+
+    m_template = tmpl;
+    for (const auto &worker : m_workers) {
+        if (worker->m_jobs.isEmpty()) {
+            loadWorker(worker.data());
+        }
+    }
+}
+
+void PreviewRenderer::handlePreviewData(Worker *p_worker, const MarkdownViewerAdapter::PreviewData &p_data)
+{
+    auto it = p_worker->m_jobs.find(p_data.m_id);
+    if (it == p_worker->m_jobs.end()) {
+        return;
+    }
+
+    const auto job = it.value();
+    p_worker->m_jobs.erase(it);
+
+    auto data = p_data;
+    data.m_id = job.m_id;
+    finishJob(job, data);
+
+    if (p_worker->m_jobs.isEmpty() && p_worker->m_template != m_template) {
+        loadWorker(p_worker);
+    }
+
+    dispatch();
+}
+
+void PreviewRenderer::handleRenderProcessTerminated(Worker *p_worker)
+{
+    qWarning() << "preview render process terminated with" << p_worker->m_jobs.size() << "jobs";
+
+    const auto jobs = p_worker->m_jobs;
+    p_worker->m_jobs.clear();
+    for (const auto &job : jobs) {
+        finishJob(job, MarkdownViewerAdapter::PreviewData(job.m_id, 0, QString(), QByteArray(), false));
+    }
+
+    loadWorker(p_worker);
+}
+
+void PreviewRenderer::finishJob(const Job &p_job, const MarkdownViewerAdapter::PreviewData &p_data)
+{
+    if (!p_job.m_helper) {
+        return;
+    }
+
+    if (p_job.m_type == JobType::Graph) {
+        p_job.m_helper->handleGraphPreviewData(p_data);
+    } else {
+        p_job.m_helper->handleMathPreviewData(p_data);
+    }
+}
+
+void PreviewRenderer::close()
+{
+    m_pendingJobs.clear();
+    for (const auto &worker : m_workers) {
+        delete worker->m_page;
+    }
+    m_workers.clear();
+}
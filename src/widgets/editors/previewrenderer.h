@@ -0,0 +1,115 @@
+#ifndef PREVIEWRENDERER_H
+#define PREVIEWRENDERER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "markdownvieweradapter.h"
+
+class QWebEnginePage;
+
+namespace vnotex
+{
+    class PreviewHelper;
+
+    // Pool of hidden web pages rendering graph and math previews for all the
+    // PreviewHelpers, independent of whether any read mode viewer is loaded.
+    // Each page renders several jobs at a time and pages are added on demand.
+    class PreviewRenderer : public QObject
+    {
+        Q_OBJECT
+    public:
+        static PreviewRenderer &getInst();
+
+        // Load one page ahead so that the first preview does not wait for the boot.
+        void warmUp();
+
+        // Result will be sent back via PreviewHelper::handleGraphPreviewData().
+        void requestGraphPreview(PreviewHelper *p_helper,
+                                 quint64 p_id,
+                                 const QString &p_lang,
+                                 const QString &p_text);
+
+        // Result will be sent back via PreviewHelper::handleMathPreviewData().
+        void requestMathPreview(PreviewHelper *p_helper,
+                                quint64 p_id,
+                                const QString &p_text);
+
+        // Release all the pages. Called on quit.
+        void close();
+
+    private:
+        enum class JobType
+        {
+            Graph,
+            Math
+        };
+
+        struct Job
+        {
+            QPointer<PreviewHelper> m_helper;
+
+            JobType m_type = JobType::Graph;
+
+            quint64 m_id = 0;
+
+            QString m_lang;
+
+            QString m_text;
+        };
+
+        struct Worker
+        {
+            QWebEnginePage *m_page = nullptr;
+
+            // Managed by QObject.
+            MarkdownViewerAdapter *m_adapter = nullptr;
+
+            // Template loaded in the page.
+            QString m_template;
+
+            // Job ID -> job being rendered in this page.
+            QHash<quint64, Job> m_jobs;
+        };
+
+        explicit PreviewRenderer(QObject *p_parent = nullptr);
+
+        ~PreviewRenderer();
+
+        void enqueue(const Job &p_job);
+
+        void dispatch();
+
+        // Return null if all pages are busy or loading.
+        Worker *pickWorker();
+
+        Worker *createWorker();
+
+        void loadWorker(Worker *p_worker);
+
+        // Check the template against current config.
+        void updateTemplate();
+
+        void handlePreviewData(Worker *p_worker, const MarkdownViewerAdapter::PreviewData &p_data);
+
+        // Fail all jobs in @p_worker and reload it.
+        void handleRenderProcessTerminated(Worker *p_worker);
+
+        static void finishJob(const Job &p_job, const MarkdownViewerAdapter::PreviewData &p_data);
+
+        QVector<QSharedPointer<Worker>> m_workers;
+
+        // Jobs waiting for a free page in request order.
+        QVector<Job> m_pendingJobs;
+
+        // Template of the pages.
+        QString m_template;
+
+        quint64 m_lastJobId = 0;
+    };
+} // ns vnotex
+
+#endif // PREVIEWRENDERER_H
@@ -0,0 +1,66 @@
+#include "renderstatsmgr.h"
+
+#include <QDebug>
+#include <QStringList>
+
+using namespace vnotex;
+
+void RenderStatsMgr::StageStats::add(int p_time)
+{
+    ++m_count;
+    m_totalTime += p_time;
+    m_maxTime = qMax(m_maxTime, p_time);
+    m_lastTime = p_time;
+}
+
+int RenderStatsMgr::StageStats::averageTime() const
+{
+    return m_count > 0 ? static_cast<int>(m_totalTime / m_count) : 0;
+}
+
+RenderStatsMgr &RenderStatsMgr::getInst()
+{
+    static RenderStatsMgr inst;
+    return inst;
+}
+
+RenderStatsMgr::RenderStatsMgr(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void RenderStatsMgr::addStats(const QString &p_notePath, const MarkdownViewerAdapter::RenderStats &p_stats)
+{
+    auto &noteStats = m_stats[p_notePath];
+    noteStats.m_total.add(p_stats.m_totalTime);
+
+    QStringList stages;
+    for (const auto &stage : p_stats.m_stages) {
+        stages << QString("%1:%2").arg(stage.m_name, QString::number(stage.m_time));
+
+        bool found = false;
+        for (auto &stageStats : noteStats.m_stages) {
+            if (stageStats.m_name == stage.m_name) {
+                stageStats.add(stage.m_time);
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            StageStats stageStats;
+            stageStats.m_name = stage.m_name;
+            stageStats.add(stage.m_time);
+            noteStats.m_stages.push_back(stageStats);
+        }
+    }
+
+    qDebug() << "read mode rendered" << p_notePath << p_stats.m_totalTime << "ms" << stages.join(QLatin1Char(' '));
+
+    emit statsUpdated(p_notePath);
+}
+
+RenderStatsMgr::NoteStats RenderStatsMgr::getNoteStats(const QString &p_notePath) const
+{
+    return m_stats.value(p_notePath);
+}
@@ -0,0 +1,61 @@
+#ifndef RENDERSTATSMGR_H
+#define RENDERSTATSMGR_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+
+#include "markdownvieweradapter.h"
+
+namespace vnotex
+{
+    // Aggregate timings of read mode rendering per note to find out the stages
+    // dominating the latency. Each round is logged, too.
+    class RenderStatsMgr : public QObject
+    {
+        Q_OBJECT
+    public:
+        struct StageStats
+        {
+            void add(int p_time);
+
+            int averageTime() const;
+
+            QString m_name;
+
+            int m_count = 0;
+
+            qint64 m_totalTime = 0;
+
+            int m_maxTime = 0;
+
+            int m_lastTime = 0;
+        };
+
+        struct NoteStats
+        {
+            // Time of the whole round.
+            StageStats m_total;
+
+            // In the order of first appearance.
+            QVector<StageStats> m_stages;
+        };
+
+        static RenderStatsMgr &getInst();
+
+        void addStats(const QString &p_notePath, const MarkdownViewerAdapter::RenderStats &p_stats);
+
+        NoteStats getNoteStats(const QString &p_notePath) const;
+
+    signals:
+        void statsUpdated(const QString &p_notePath);
+
+    private:
+        explicit RenderStatsMgr(QObject *p_parent = nullptr);
+
+        // Note path -> stats.
+        QHash<QString, NoteStats> m_stats;
+    };
+} // ns vnotex
+
+#endif // RENDERSTATSMGR_H
@@ -0,0 +1,135 @@
+#include "sectionnumberupdater.h"
+
+#include <QTextDocument>
+#include <QTextCursor>
+#include <QTextBlock>
+
+#include <vtextedit/markdownutils.h>
+
+#include <utils/textutils.h>
+
+using namespace vnotex;
+
+static bool updateHeadingSectionNumber(QTextCursor &p_cursor,
+                                       const QTextBlock &p_block,
+                                       const QString &p_sectionNumber,
+                                       bool p_endingDot)
+{
+    if (!p_block.isValid()) {
+        return false;
+    }
+
+    QString text = p_block.text();
+    auto match = vte::MarkdownUtils::matchHeader(text);
+    Q_ASSERT(match.m_matched);
+
+    bool isSequence = false;
+    if (!match.m_sequence.isEmpty()) {
+        // Check if this sequence is the real sequence matching current style.
+        if (match.m_sequence.endsWith('.')) {
+            isSequence = p_endingDot;
+        } else {
+            isSequence = !p_endingDot;
+        }
+    }
+
+    int start = match.m_level + 1;
+    int end = match.m_level + match.m_spacesAfterMarker;
+    if (isSequence) {
+        end += match.m_sequence.size() + match.m_spacesAfterSequence;
+    }
+
+    Q_ASSERT(start <= end);
+
+    p_cursor.setPosition(p_block.position() + start);
+    if (start != end) {
+        p_cursor.setPosition(p_block.position() + end, QTextCursor::KeepAnchor);
+    }
+
+    if (p_sectionNumber.isEmpty()) {
+        p_cursor.removeSelectedText();
+    } else {
+        p_cursor.insertText(p_sectionNumber + ' ');
+    }
+    return true;
+}
+
+bool SectionNumberUpdater::update(QTextDocument *p_doc,
+                                  const QVector<Heading> &p_headings,
+                                  bool p_enabled,
+                                  int p_baseLevel,
+                                  bool p_endingDot)
+{
+    // Headings before the first changed one since last update are numbered already.
+    int first = 0;
+    if (m_enabled == p_enabled
+        && m_baseLevel == p_baseLevel
+        && m_endingDot == p_endingDot) {
+        const int cnt = qMin(p_headings.size(), m_levels.size());
+        while (first < cnt
+               && p_headings[first].m_level == m_levels[first]
+               && p_headings[first].m_sectionNumber == m_sectionNumbers[first]) {
+            ++first;
+        }
+
+        if (first == p_headings.size() && first == m_levels.size()) {
+            return false;
+        }
+    }
+
+    QVector<int> levels;
+    levels.reserve(p_headings.size());
+    for (const auto &heading : p_headings) {
+        levels.push_back(heading.m_level);
+    }
+
+    QStringList sectionStrs;
+    if (p_enabled) {
+        sectionStrs = TextUtils::generateSectionNumbers(levels, p_baseLevel, p_endingDot, first);
+    }
+
+    m_enabled = p_enabled;
+    m_baseLevel = p_baseLevel;
+    m_endingDot = p_endingDot;
+    m_levels = levels;
+    m_sectionNumbers.resize(p_headings.size());
+
+    // Number of leading headings numbered or already correct.
+    int numberedCnt = p_headings.size();
+
+    bool changed = false;
+    bool inEditBlock = false;
+    QTextCursor cursor(p_doc);
+    for (int i = first; i < p_headings.size(); ++i) {
+        const auto &heading = p_headings[i];
+        const auto sectionStr = p_enabled ? sectionStrs[i - first] : QString();
+        m_sectionNumbers[i] = heading.m_sectionNumber;
+        if (heading.m_blockNumber > -1 && sectionStr != heading.m_sectionNumber) {
+            // Open the edit block only when some block needs update.
+            if (!inEditBlock) {
+                cursor.beginEditBlock();
+                inEditBlock = true;
+            }
+
+            if (updateHeadingSectionNumber(cursor,
+                                           p_doc->findBlockByNumber(heading.m_blockNumber),
+                                           sectionStr,
+                                           p_endingDot)) {
+                changed = true;
+                m_sectionNumbers[i] = sectionStr;
+            } else {
+                numberedCnt = qMin(numberedCnt, i);
+            }
+        }
+    }
+
+    if (inEditBlock) {
+        cursor.endEditBlock();
+    }
+
+    // Forget the headings since the first failed one so that they will be retried.
+    m_levels.resize(numberedCnt);
+    m_sectionNumbers.resize(numberedCnt);
+
+    return changed;
+}
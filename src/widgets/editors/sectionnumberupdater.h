@@ -0,0 +1,49 @@
+#ifndef SECTIONNUMBERUPDATER_H
+#define SECTIONNUMBERUPDATER_H
+
+#include <QString>
+#include <QVector>
+
+class QTextDocument;
+
+namespace vnotex
+{
+    // Update the section numbers within the heading blocks of a document.
+    // Headings numbered by last update and unchanged since then are skipped.
+    class SectionNumberUpdater
+    {
+    public:
+        struct Heading
+        {
+            int m_level = -1;
+
+            // Section number in the heading text.
+            QString m_sectionNumber;
+
+            int m_blockNumber = -1;
+        };
+
+        // Return true if there is change.
+        // @p_enabled: false to remove all the section numbers.
+        bool update(QTextDocument *p_doc,
+                    const QVector<Heading> &p_headings,
+                    bool p_enabled,
+                    int p_baseLevel,
+                    bool p_endingDot);
+
+    private:
+        bool m_enabled = false;
+
+        int m_baseLevel = -1;
+
+        bool m_endingDot = false;
+
+        // Levels of the headings numbered by last update.
+        QVector<int> m_levels;
+
+        // Section number in the text of each heading after last update.
+        QVector<QString> m_sectionNumbers;
+    };
+} // ns vnotex
+
+#endif // SECTIONNUMBERUPDATER_H
@@ -23,12 +23,14 @@
 #include "vnotex.h"
 #include "notebookmgr.h"
 #include "buffermgr.h"
+#include <core/search/searchindexmgr.h>
 #include "viewarea.h"
 #include <core/configmgr.h>
 #include <core/sessionconfig.h>
 #include <core/coreconfig.h>
 #include <core/events.h>
 #include <core/fileopenparameters.h>
+#include <core/localgraphrenderer.h>
 #include <widgets/dialogs/scrolldialog.h>
 #include "viewwindow.h"
 #include "outlineviewer.h"
@@ -37,6 +39,8 @@
 #include "messageboxhelper.h"
 #include "systemtrayhelper.h"
 #include "titletoolbar.h"
+#include "editors/previewrenderer.h"
+#include "editors/markdownviewerpool.h"
 
 using namespace vnotex;
 
@@ -74,6 +78,9 @@ void MainWindow::kickOffOnStart()
 
     emit layoutChanged();
 
+    // Load viewer pages at idle time ahead of the first read mode.
+    MarkdownViewerPool::getInst().warmUp();
+
     demoWidget();
 }
 
@@ -476,6 +483,16 @@ void MainWindow::closeOnQuit()
 {
     // No user interaction is available.
     emit mainWindowClosedOnQuit();
+
+    VNoteX::getInst().getNotebookMgr().close();
+
+    VNoteX::getInst().getSearchIndexMgr().close();
+
+    PreviewRenderer::getInst().close();
+
+    MarkdownViewerPool::getInst().close();
+
+    LocalGraphRenderer::getInst().close();
 }
 
 void MainWindow::setupShortcuts()
@@ -7,6 +7,8 @@
 #include <QCoreApplication>
 #include <QScrollBar>
 #include <QLabel>
+#include <QHBoxLayout>
+#include <QToolButton>
 
 #include <core/fileopenparameters.h>
 #include <core/editorconfig.h>
@@ -24,11 +26,14 @@
 #include "editors/markdownviewer.h"
 #include "editors/editormarkdownvieweradapter.h"
 #include "editors/previewhelper.h"
+#include "editors/markdownviewerpool.h"
+#include "editors/renderstatsmgr.h"
 #include "dialogs/deleteconfirmdialog.h"
 #include "outlineprovider.h"
 #include "toolbarhelper.h"
 #include "findandreplacewidget.h"
 #include "editors/statuswidget.h"
+#include "renderstatspopup.h"
 
 using namespace vnotex;
 
@@ -50,6 +55,10 @@ MarkdownViewWindow::MarkdownViewWindow(const QSharedPointer<FileOpenParameters>
 
 MarkdownViewWindow::~MarkdownViewWindow()
 {
+    if (m_viewer && !m_viewerTemplate.isEmpty()) {
+        MarkdownViewerPool::getInst().recycle(m_viewer->page(), adapter(), m_viewerTemplate);
+    }
+
     if (m_textEditorStatusWidget) {
         getMainStatusWidget()->removeWidget(m_textEditorStatusWidget.get());
         m_textEditorStatusWidget->setParent(nullptr);
@@ -112,6 +121,8 @@ void MarkdownViewWindow::setModeInternal(Mode p_mode)
             if (m_initialized) {
                 syncViewerFromBuffer(true);
             }
+        } else if (m_viewerSyncDeferred) {
+            syncViewerFromBuffer(true);
         }
 
         // Avoid focus glitch.
@@ -232,6 +243,19 @@ void MarkdownViewWindow::doSyncEditorFromBufferContent(bool p_syncPosition)
     }
 }
 
+void MarkdownViewWindow::handleBufferLargeFileChanged()
+{
+    auto buffer = getBuffer();
+    Q_ASSERT(buffer);
+    if (buffer->isLargeFile()) {
+        // Markdown highlighting parses the whole file on each change. Reopen it as plain text.
+        m_previewHelper->setInplacePreviewEnabled(false);
+        emit reopenRequested();
+    } else {
+        m_previewHelper->setInplacePreviewEnabled(true);
+    }
+}
+
 void MarkdownViewWindow::handleBufferChangedInternal()
 {
     TextViewWindowHelper::handleBufferChanged(this);
@@ -391,8 +415,16 @@ void MarkdownViewWindow::setupViewer()
 
     HtmlTemplateHelper::updateMarkdownViewerTemplate(markdownEditorConfig);
 
-    auto adapter = new EditorMarkdownViewerAdapter(nullptr, this);
+    // Take a loaded page if possible to skip the page boot.
+    QWebEnginePage *page = nullptr;
+    EditorMarkdownViewerAdapter *adapter = nullptr;
+    if (MarkdownViewerPool::getInst().take(page, adapter)) {
+        m_viewerTemplate = HtmlTemplateHelper::getMarkdownViewerTemplate();
+    } else {
+        adapter = new EditorMarkdownViewerAdapter(nullptr, this);
+    }
     m_viewer = new MarkdownViewer(adapter,
+                                  page,
                                   VNoteX::getInst().getThemeMgr().getBaseBackground(),
                                   markdownEditorConfig.getZoomFactorInReadMode(),
                                   this);
@@ -401,14 +433,44 @@ void MarkdownViewWindow::setupViewer()
     // Status widget.
     {
         // TODO: implement a real status widget for viewer.
-        auto label = new QLabel(tr("Markdown Viewer"), this);
-        label->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        m_viewerStatusWidget.reset(label);
+        auto widget = new QWidget(this);
+        auto layout = new QHBoxLayout(widget);
+        layout->setContentsMargins(0, 0, 0, 0);
+        layout->addStretch();
+
+        auto label = new QLabel(tr("Markdown Viewer"), widget);
+        layout->addWidget(label);
+
+        // Time of last round of rendering with the timings of the note by stage.
+        m_renderStatsButton = new QToolButton(widget);
+        m_renderStatsButton->setToolTip(tr("Render Timings"));
+        m_renderStatsButton->setPopupMode(QToolButton::InstantPopup);
+        auto popup = new RenderStatsPopup(m_renderStatsButton);
+        connect(popup, &QMenu::aboutToShow,
+                this, [this, popup]() {
+                    auto buffer = getBuffer();
+                    popup->setNotePath(buffer ? buffer->getPath() : QString());
+                });
+        m_renderStatsButton->setMenu(popup);
+        m_renderStatsButton->hide();
+        layout->addWidget(m_renderStatsButton);
+
+        m_viewerStatusWidget.reset(widget);
         getMainStatusWidget()->addWidget(m_viewerStatusWidget.get());
         m_viewerStatusWidget->show();
     }
 
-    m_viewer->setPreviewHelper(m_previewHelper);
+    connect(adapter, &MarkdownViewerAdapter::renderStatsUpdated,
+            this, [this](const MarkdownViewerAdapter::RenderStats &p_stats) {
+                auto buffer = getBuffer();
+                if (!buffer) {
+                    return;
+                }
+
+                RenderStatsMgr::getInst().addStats(buffer->getPath(), p_stats);
+                m_renderStatsButton->setText(tr("%1 ms").arg(p_stats.m_totalTime));
+                m_renderStatsButton->show();
+            });
 
     connect(m_viewer, &MarkdownViewer::zoomFactorChanged,
             this, [this](qreal p_factor) {
@@ -458,6 +520,7 @@ void MarkdownViewWindow::syncTextEditorFromBuffer(bool p_syncPositionFromReadMod
 
     auto buffer = getBuffer();
     m_editor->setBuffer(buffer);
+    m_previewHelper->setInplacePreviewEnabled(!buffer || !buffer->isLargeFile());
     if (buffer) {
         m_editor->setReadOnly(buffer->isReadOnly());
         m_editor->setBasePath(buffer->getResourcePath());
@@ -487,6 +550,13 @@ void MarkdownViewWindow::syncViewerFromBuffer(bool p_syncPositionFromEditMode)
     }
 
     auto buffer = getBuffer();
+    if (buffer && buffer->isLargeFile() && m_mode != Mode::Read) {
+        // Render large file only when it is read.
+        m_viewerSyncDeferred = true;
+        return;
+    }
+    m_viewerSyncDeferred = false;
+
     adapter()->setBuffer(buffer);
     if (buffer) {
         int lineNumber = -1;
@@ -497,11 +567,21 @@ void MarkdownViewWindow::syncViewerFromBuffer(bool p_syncPositionFromEditMode)
         // TODO: Check buffer for last position recover.
 
         // Use getPath() instead of getBasePath() to make in-page anchor work.
-        m_viewer->setHtml(HtmlTemplateHelper::getMarkdownViewerTemplate(),
-                          PathUtils::pathToUrl(buffer->getContentPath()));
+        const auto url = PathUtils::pathToUrl(buffer->getContentPath());
+        const auto &tmpl = HtmlTemplateHelper::getMarkdownViewerTemplate();
+        if (m_viewerTemplate == tmpl) {
+            // The page is loaded already. Just switch the content.
+            adapter()->setBaseUrl(url.toString());
+        } else {
+            // Hold the text until the new page is ready.
+            adapter()->setReady(false);
+            m_viewer->setHtml(tmpl, url);
+            m_viewerTemplate = tmpl;
+        }
         adapter()->setText(m_bufferRevision, buffer->getContent(), lineNumber);
     } else {
         m_viewer->setHtml("");
+        m_viewerTemplate.clear();
         adapter()->setText(0, "", -1);
     }
     m_viewerBufferRevision = m_bufferRevision;
@@ -522,7 +602,12 @@ void MarkdownViewWindow::syncTextEditorFromBufferContent(bool p_syncPosition)
 
     auto buffer = getBuffer();
     Q_ASSERT(buffer);
-    m_editor->setText(buffer->getContent());
+    // Apply only the edits since last sync if possible to keep the undo history.
+    QVector<Buffer::ContentDelta> deltas;
+    if (!buffer->getContentDeltas(m_textEditorBufferRevision, deltas)
+        || !TextViewWindowHelper::applyContentDeltas(m_editor->getTextEdit()->document(), deltas)) {
+        m_editor->setText(buffer->getContent());
+    }
     m_editor->setModified(buffer->isModified());
 
     m_textEditorBufferRevision = m_bufferRevision;
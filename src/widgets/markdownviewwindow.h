@@ -7,6 +7,7 @@
 
 class QSplitter;
 class QStackedWidget;
+class QToolButton;
 
 namespace vte
 {
@@ -47,6 +48,8 @@ namespace vnotex
 
         void handleBufferChangedInternal() Q_DECL_OVERRIDE;
 
+        void handleBufferLargeFileChanged() Q_DECL_OVERRIDE;
+
         void handleTypeAction(TypeAction p_action) Q_DECL_OVERRIDE;
 
         void handleSectionNumberOverride(OverrideState p_state) Q_DECL_OVERRIDE;
@@ -147,6 +150,9 @@ namespace vnotex
 
         QSharedPointer<QWidget> m_viewerStatusWidget;
 
+        // Managed by QObject.
+        QToolButton *m_renderStatsButton = nullptr;
+
         QSharedPointer<QStackedWidget> m_mainStatusWidget;
 
         // Managed by QObject.
@@ -159,6 +165,12 @@ namespace vnotex
 
         int m_viewerBufferRevision = 0;
 
+        // Whether syncViewerFromBuffer() is deferred until read mode.
+        bool m_viewerSyncDeferred = false;
+
+        // Template loaded in the viewer page.
+        QString m_viewerTemplate;
+
         int m_markdownEditorConfigRevision = 0;
 
         Mode m_previousMode = Mode::Invalid;
@@ -11,6 +11,7 @@
 
 #include "listwidget.h"
 #include "treewidget.h"
+#include "treeview.h"
 
 namespace vnotex
 {
@@ -95,6 +96,62 @@ namespace vnotex
     {
         return ListWidget::getVisibleItems(m_widget);
     }
+
+    // Navigation over the visible indexes of a QTreeView.
+    template <>
+    class NavigationModeWrapper<QTreeView, QModelIndex> : public NavigationMode
+    {
+    public:
+        NavigationModeWrapper(QTreeView *p_widget)
+            : NavigationMode(NavigationMode::Type::DoubleKeys, p_widget),
+              m_widget(p_widget)
+        {
+        }
+
+    // NavigationMode.
+    protected:
+        QVector<void *> getVisibleNavigationItems() Q_DECL_OVERRIDE
+        {
+            m_visibleIndexes = TreeView::getVisibleIndexes(m_widget);
+
+            QVector<void *> items;
+            items.reserve(m_visibleIndexes.size());
+            for (auto &idx : m_visibleIndexes) {
+                items.push_back(&idx);
+            }
+            return items;
+        }
+
+        void placeNavigationLabel(int p_idx, void *p_item, QLabel *p_label) Q_DECL_OVERRIDE
+        {
+            Q_UNUSED(p_idx);
+            Q_ASSERT(p_item);
+
+            int extraWidth = p_label->width() + 2;
+            auto vbar = m_widget->verticalScrollBar();
+            if (vbar && vbar->minimum() != vbar->maximum()) {
+                extraWidth += vbar->width();
+            }
+
+            const auto rt = m_widget->visualRect(*static_cast<QModelIndex *>(p_item));
+            const int x = rt.x() + m_widget->width() - extraWidth;
+            const int y = rt.y();
+            p_label->move(x, y);
+        }
+
+        void handleTargetHit(void *p_item) Q_DECL_OVERRIDE
+        {
+            Q_ASSERT(p_item);
+            m_widget->setCurrentIndex(*static_cast<QModelIndex *>(p_item));
+            m_widget->setFocus();
+        }
+
+    private:
+        QTreeView *m_widget = nullptr;
+
+        // Items handed out by getVisibleNavigationItems() point into it.
+        QVector<QModelIndex> m_visibleIndexes;
+    };
 }
 
 #endif // NAVIGATIONMODEWRAPPER_H
@@ -12,6 +12,7 @@
 #include "dialogs/importnotebookdialog.h"
 #include "dialogs/importfolderdialog.h"
 #include "dialogs/importlegacynotebookdialog.h"
+#include "dialogs/searchdialog.h"
 #include "vnotex.h"
 #include "mainwindow.h"
 #include "notebook/notebook.h"
@@ -27,6 +28,7 @@
 #include <core/events.h>
 #include <core/exception.h>
 #include <core/fileopenparameters.h>
+#include <core/search/searchindexmgr.h>
 #include "navigationmodemgr.h"
 
 using namespace vnotex;
@@ -86,6 +88,28 @@ TitleBar *NotebookExplorer::setupTitleBar(QWidget *p_parent)
                                 dialog.exec();
                             });
 
+    titleBar->addMenuSeparator();
+
+    titleBar->addMenuAction(tr("&Search In Notebook"),
+                            titleBar,
+                            [this]() {
+                                if (!m_currentNotebook) {
+                                    return;
+                                }
+                                SearchDialog dialog(m_currentNotebook.data(), VNoteX::getInst().getMainWindow());
+                                dialog.exec();
+                            });
+
+    titleBar->addMenuAction(tr("&Rebuild Search Index"),
+                            titleBar,
+                            [this]() {
+                                if (!m_currentNotebook) {
+                                    return;
+                                }
+                                VNoteX::getInst().getSearchIndexMgr().rebuild(m_currentNotebook.data());
+                                VNoteX::getInst().showStatusMessageShort(tr("Rebuilding search index of notebook (%1)").arg(m_currentNotebook->getName()));
+                            });
+
     return titleBar;
 }
 
@@ -9,7 +9,8 @@
 #include "vnotex.h"
 #include "mainwindow.h"
 #include <utils/iconutils.h>
-#include "treewidget.h"
+#include "treeview.h"
+#include "notebooknodemodel.h"
 #include "dialogs/notepropertiesdialog.h"
 #include "dialogs/folderpropertiesdialog.h"
 #include "dialogs/deleteconfirmdialog.h"
@@ -25,164 +26,12 @@
 
 using namespace vnotex;
 
-const QString NotebookNodeExplorer::c_nodeIconForegroundName = "widgets#notebookexplorer#node_icon#fg";
-
-QIcon NotebookNodeExplorer::s_folderNodeIcon;
-
-QIcon NotebookNodeExplorer::s_fileNodeIcon;
-
-QIcon NotebookNodeExplorer::s_recycleBinNodeIcon;
-
-NotebookNodeExplorer::NodeData::NodeData()
-{
-}
-
-NotebookNodeExplorer::NodeData::NodeData(Node *p_node, bool p_loaded)
-    : m_type(NodeType::Node),
-      m_node(p_node),
-      m_loaded(p_loaded)
-{
-}
-
-NotebookNodeExplorer::NodeData::NodeData(const QString &p_name)
-    : m_type(NodeType::Attachment),
-      m_name(p_name),
-      m_loaded(true)
-{
-}
-
-NotebookNodeExplorer::NodeData::NodeData(const NodeData &p_other)
-{
-    m_type = p_other.m_type;
-    switch (m_type) {
-    case NodeType::Node:
-        m_node = p_other.m_node;
-        break;
-
-    case NodeType::Attachment:
-        m_name = p_other.m_name;
-        break;
-
-    default:
-        m_node = p_other.m_node;
-        m_name = p_other.m_name;
-        break;
-    }
-
-    m_loaded = p_other.m_loaded;
-}
-
-NotebookNodeExplorer::NodeData::~NodeData()
-{
-}
-
-NotebookNodeExplorer::NodeData &NotebookNodeExplorer::NodeData::operator=(const NodeData &p_other)
-{
-    if (&p_other == this) {
-        return *this;
-    }
-
-    m_type = p_other.m_type;
-    switch (m_type) {
-    case NodeType::Node:
-        m_node = p_other.m_node;
-        break;
-
-    case NodeType::Attachment:
-        m_name = p_other.m_name;
-        break;
-
-    default:
-        m_node = p_other.m_node;
-        m_name = p_other.m_name;
-        break;
-    }
-
-    m_loaded = p_other.m_loaded;
-
-    return *this;
-}
-
-bool NotebookNodeExplorer::NodeData::isValid() const
-{
-    return m_type != NodeType::Invalid;
-}
-
-bool NotebookNodeExplorer::NodeData::isNode() const
-{
-    return m_type == NodeType::Node;
-}
-
-bool NotebookNodeExplorer::NodeData::isAttachment() const
-{
-    return m_type == NodeType::Attachment;
-}
-
-NotebookNodeExplorer::NodeData::NodeType NotebookNodeExplorer::NodeData::getType() const
-{
-    return m_type;
-}
-
-Node *NotebookNodeExplorer::NodeData::getNode() const
-{
-    Q_ASSERT(isNode());
-    return m_node;
-}
-
-const QString &NotebookNodeExplorer::NodeData::getName() const
-{
-    Q_ASSERT(isAttachment());
-    return m_name;
-}
-
-void NotebookNodeExplorer::NodeData::clear()
-{
-    m_type = NodeType::Invalid;
-    m_node = nullptr;
-    m_name.clear();
-    m_loaded = false;
-}
-
-bool NotebookNodeExplorer::NodeData::matched(const Node *p_node) const
-{
-    if (isNode() && m_node == p_node) {
-        return true;
-    }
-
-    return false;
-}
-
-bool NotebookNodeExplorer::NodeData::isLoaded() const
-{
-    return m_loaded;
-}
-
-
 NotebookNodeExplorer::NotebookNodeExplorer(QWidget *p_parent)
     : QWidget(p_parent)
 {
-    initNodeIcons();
-
     setupUI();
 }
 
-void NotebookNodeExplorer::initNodeIcons() const
-{
-    if (!s_folderNodeIcon.isNull()) {
-        return;
-    }
-
-    const auto &themeMgr = VNoteX::getInst().getThemeMgr();
-    const auto fg = themeMgr.paletteColor(c_nodeIconForegroundName);
-    const QString folderIconName("folder_node.svg");
-    const QString fileIconName("file_node.svg");
-    const QString recycleBinIconName("recycle_bin.svg");
-
-    s_folderNodeIcon = IconUtils::fetchIcon(themeMgr.getIconFile(folderIconName), fg);
-    s_fileNodeIcon = IconUtils::fetchIcon(themeMgr.getIconFile(fileIconName), fg);
-    s_recycleBinNodeIcon = IconUtils::fetchIcon(themeMgr.getIconFile(recycleBinIconName), fg);
-}
-
 void NotebookNodeExplorer::setupUI()
 {
     auto mainLayout = new QVBoxLayout(this);
@@ -199,46 +48,33 @@ void NotebookNodeExplorer::setupUI()
 
 void NotebookNodeExplorer::setupMasterExplorer(QWidget *p_parent)
 {
-    m_masterExplorer = new TreeWidget(TreeWidget::ClickSpaceToClearSelection, p_parent);
-    TreeWidget::setupSingleColumnHeaderlessTree(m_masterExplorer, true, true);
-    TreeWidget::showHorizontalScrollbar(m_masterExplorer);
+    m_masterExplorer = new TreeView(TreeView::ClickSpaceToClearSelection, p_parent);
+    TreeView::setupSingleColumnHeaderlessTree(m_masterExplorer, true, true);
+    m_masterExplorer->setUniformRowHeights(true);
 
-    m_navigationWrapper.reset(new NavigationModeWrapper<QTreeWidget, QTreeWidgetItem>(m_masterExplorer));
-    NavigationModeMgr::getInst().registerNavigationTarget(m_navigationWrapper.data());
+    m_model = new NotebookNodeModel(this);
+    m_masterExplorer->setModel(m_model);
+    TreeView::showHorizontalScrollbar(m_masterExplorer);
 
-    connect(m_masterExplorer, &QTreeWidget::itemExpanded,
-            this, [this](QTreeWidgetItem *p_item) {
-                auto cnt = p_item->childCount();
-                for (int i = 0; i < cnt; ++i) {
-                    auto child = p_item->child(i);
-                    auto data = getItemNodeData(child);
-                    if (data.isNode() && !data.isLoaded()) {
-                        loadNode(child, data.getNode(), 1);
-                    }
-                }
-            });
+    m_navigationWrapper.reset(new NavigationModeWrapper<QTreeView, QModelIndex>(m_masterExplorer));
+    NavigationModeMgr::getInst().registerNavigationTarget(m_navigationWrapper.data());
 
-    connect(m_masterExplorer, &QTreeWidget::customContextMenuRequested,
+    connect(m_masterExplorer, &QTreeView::customContextMenuRequested,
             this, [this](const QPoint &p_pos) {
                 if (!m_notebook) {
                     return;
                 }
 
-                auto item = m_masterExplorer->itemAt(p_pos);
-                auto data = getItemNodeData(item);
+                auto node = m_model->nodeFromIndex(m_masterExplorer->indexAt(p_pos));
                 QScopedPointer<QMenu> menu(WidgetsFactory::createMenu());
-                if (!data.isValid()) {
+                if (!node) {
                     createContextMenuOnRoot(menu.data());
                 } else {
                     if (!allSelectedItemsSameType()) {
                         return;
                     }
 
-                    if (data.isNode()) {
-                        createContextMenuOnNode(menu.data(), data.getNode());
-                    } else if (data.isAttachment()) {
-                        createContextMenuOnAttachment(menu.data(), data.getName());
-                    }
+                    createContextMenuOnNode(menu.data(), node);
                 }
 
                 if (!menu->isEmpty()) {
@@ -246,18 +82,11 @@ void NotebookNodeExplorer::setupMasterExplorer(QWidget *p_parent)
                 }
             });
 
-    connect(m_masterExplorer, &QTreeWidget::itemActivated,
-            this, [this](QTreeWidgetItem *p_item, int p_column) {
-                Q_UNUSED(p_column);
-                auto data = getItemNodeData(p_item);
-                if (!data.isValid()) {
-                    return;
-                }
-
-                if (data.isNode()) {
-                    emit nodeActivated(data.getNode(), QSharedPointer<FileOpenParameters>::create());
-                } else if (data.isAttachment()) {
-                    // TODO.
+    connect(m_masterExplorer, &QTreeView::activated,
+            this, [this](const QModelIndex &p_index) {
+                auto node = m_model->nodeFromIndex(p_index);
+                if (node) {
+                    emit nodeActivated(node, QSharedPointer<FileOpenParameters>::create());
                 }
             });
 }
@@ -288,7 +117,7 @@ void NotebookNodeExplorer::setNotebook(const QSharedPointer<Notebook> &p_noteboo
 
 void NotebookNodeExplorer::clearExplorer()
 {
-    m_masterExplorer->clear();
+    m_model->setRootNode(nullptr);
 }
 
 void NotebookNodeExplorer::generateNodeTree()
@@ -302,7 +131,8 @@ void NotebookNodeExplorer::generateNodeTree()
     try {
         auto rootNode = m_notebook->getRootNode();
 
-        loadRootNode(rootNode.data());
+        m_model->setRootNode(rootNode);
+        m_model->fetchMore(QModelIndex());
     } catch (Exception &p_e) {
         QString msg = tr("Failed to load nodes of notebook (%1) (%2).")
                         .arg(m_notebook->getName(), p_e.what());
@@ -310,162 +140,45 @@ void NotebookNodeExplorer::generateNodeTree()
         MessageBoxHelper::notify(MessageBoxHelper::Critical, msg, VNoteX::getInst().getMainWindow());
     }
 
-    // Restore current item.
-    auto currentNode = stateCache()->getCurrentItem();
+    const auto state = m_stateCache.value(m_notebook.data());
+    restoreExpansion(QModelIndex(), state.m_expandedNodes);
 
-    if (currentNode) {
-        setCurrentNode(currentNode);
+    // Restore current item.
+    if (state.m_currentNode) {
+        setCurrentNode(state.m_currentNode);
     } else {
         // Do not focus the recycle bin.
         focusNormalNode();
     }
 
-    stateCache()->clear();
+    clearStateCache(m_notebook.data());
 }
 
-void NotebookNodeExplorer::loadRootNode(const Node *p_node) const
+void NotebookNodeExplorer::restoreExpansion(const QModelIndex &p_parent, const QSet<const Node *> &p_expandedNodes)
 {
-    Q_ASSERT(p_node->isLoaded());
-
-    // Render recycle bin node first.
-    auto recycleBinNode = m_notebook->getRecycleBinNode();
-    if (recycleBinNode) {
-        loadRecycleBinNode(recycleBinNode.data());
+    if (p_expandedNodes.isEmpty()) {
+        return;
     }
 
-    for (auto &child : p_node->getChildren()) {
-        if (recycleBinNode == child) {
+    const int cnt = m_model->rowCount(p_parent);
+    for (int i = 0; i < cnt; ++i) {
+        const auto idx = m_model->index(i, 0, p_parent);
+        if (!p_expandedNodes.contains(m_model->nodeFromIndex(idx))) {
             continue;
         }
 
-        auto item = new QTreeWidgetItem(m_masterExplorer);
-        loadNode(item, child.data(), 1);
-    }
-}
-
-static void clearTreeWigetItemChildren(QTreeWidgetItem *p_item)
-{
-    auto children = p_item->takeChildren();
-    for (auto &child : children) {
-        delete child;
-    }
-}
-
-void NotebookNodeExplorer::loadNode(QTreeWidgetItem *p_item, Node *p_node, int p_level) const
-{
-    if (!p_node->isLoaded()) {
-        p_node->load();
-    }
-
-    clearTreeWigetItemChildren(p_item);
-
-    fillTreeItem(p_item, p_node, p_level > 0);
-
-    loadChildren(p_item, p_node, p_level - 1);
-
-    if (stateCache()->contains(p_item)) {
-        p_item->setExpanded(true);
-    }
-}
-
-void NotebookNodeExplorer::loadChildren(QTreeWidgetItem *p_item, Node *p_node, int p_level) const
-{
-    if (p_level < 0) {
-        return;
-    }
-
-    for (auto &child : p_node->getChildren()) {
-        auto item = new QTreeWidgetItem(p_item);
-        loadNode(item, child.data(), p_level);
-    }
-}
-
-void NotebookNodeExplorer::loadRecycleBinNode(Node *p_node) const
-{
-    auto item = new QTreeWidgetItem();
-    item->setWhatsThis(Column::Name,
-                       tr("Recycle bin of this notebook. Deleted files could be found here. "
-                          "It is organized in folders named by date. Nodes could be moved to "
-                          "other folders by Cut and Paste."));
-    m_masterExplorer->insertTopLevelItem(0, item);
-
-    loadRecycleBinNode(item, p_node, 1);
-}
-
-void NotebookNodeExplorer::loadRecycleBinNode(QTreeWidgetItem *p_item, Node *p_node, int p_level) const
-{
-    if (!p_node->isLoaded()) {
-        p_node->load();
-    }
-
-    clearTreeWigetItemChildren(p_item);
-
-    setItemNodeData(p_item, NodeData(p_node, true));
-    p_item->setText(Column::Name, tr("Recycle Bin"));
-    p_item->setIcon(Column::Name, getNodeItemIcon(p_node));
-
-    loadChildren(p_item, p_node, p_level - 1);
-
-    // No need to restore state.
-}
-
-void NotebookNodeExplorer::fillTreeItem(QTreeWidgetItem *p_item, Node *p_node, bool p_loaded) const
-{
-    setItemNodeData(p_item, NodeData(p_node, p_loaded));
-    p_item->setText(Column::Name, p_node->getName());
-    p_item->setIcon(Column::Name, getNodeItemIcon(p_node));
-    p_item->setToolTip(Column::Name, p_node->getName());
-}
-
-QIcon NotebookNodeExplorer::getNodeItemIcon(const Node *p_node) const
-{
-    if (p_node->hasContent()) {
-        return s_fileNodeIcon;
-    } else {
-        if (p_node->getUse() == Node::Use::RecycleBin) {
-            return s_recycleBinNodeIcon;
+        if (m_model->canFetchMore(idx)) {
+            m_model->fetchMore(idx);
         }
+        m_masterExplorer->expand(idx);
 
-        return s_folderNodeIcon;
+        restoreExpansion(idx, p_expandedNodes);
     }
-
-    return QIcon();
 }
 
 Node *NotebookNodeExplorer::getCurrentNode() const
 {
-    auto item = m_masterExplorer->currentItem();
-    if (item) {
-        auto data = getItemNodeData(item);
-        while (data.isAttachment()) {
-            item = item->parent();
-            if (item) {
-                data = getItemNodeData(item);
-            } else {
-                data.clear();
-            }
-        }
-
-        if (data.isNode()) {
-            return data.getNode();
-        }
-    }
-
-    return nullptr;
-}
-
-void NotebookNodeExplorer::setItemNodeData(QTreeWidgetItem *p_item, const NodeData &p_data)
-{
-    p_item->setData(Column::Name, Qt::UserRole, QVariant::fromValue(p_data));
-}
-
-NotebookNodeExplorer::NodeData NotebookNodeExplorer::getItemNodeData(const QTreeWidgetItem *p_item)
-{
-    if (!p_item) {
-        return NodeData();
-    }
-
-    return p_item->data(Column::Name, Qt::UserRole).value<NotebookNodeExplorer::NodeData>();
+    return m_model->nodeFromIndex(m_masterExplorer->currentIndex());
 }
 
 void NotebookNodeExplorer::updateNode(Node *p_node)
@@ -474,180 +187,74 @@ void NotebookNodeExplorer::updateNode(Node *p_node)
         return;
     }
 
-    auto item = findNode(p_node);
-    if (item) {
-        bool expanded = item->isExpanded();
-        item->setExpanded(false);
-
-        if (m_notebook->isRecycleBinNode(p_node)) {
-            loadRecycleBinNode(item, p_node, 1);
-        } else {
-            loadNode(item, p_node, 1);
-        }
-
-        item->setExpanded(expanded);
-    } else {
+    if (!p_node) {
         saveNotebookTreeState(false);
 
         generateNodeTree();
-    }
-}
-
-QTreeWidgetItem *NotebookNodeExplorer::findNode(const Node *p_node) const
-{
-    if (!p_node) {
-        return nullptr;
-    }
-
-    auto cnt = m_masterExplorer->topLevelItemCount();
-    for (int i = 0; i < cnt; ++i) {
-        auto item = findNode(m_masterExplorer->topLevelItem(i), p_node);
-        if (item) {
-            return item;
-        }
-    }
-
-    return nullptr;
-}
-
-QTreeWidgetItem *NotebookNodeExplorer::findNode(QTreeWidgetItem *p_item, const Node *p_node) const
-{
-    auto data = getItemNodeData(p_item);
-    if (data.matched(p_node)) {
-        return p_item;
-    }
-
-    auto cnt = p_item->childCount();
-    for (int i = 0; i < cnt; ++i) {
-        auto item = findNode(p_item->child(i), p_node);
-        if (item) {
-            return item;
-        }
+        return;
     }
 
-    return nullptr;
-}
-
-QTreeWidgetItem *NotebookNodeExplorer::findNodeChild(QTreeWidgetItem *p_item, const Node *p_node) const
-{
-    auto cnt = p_item->childCount();
-    for (int i = 0; i < cnt; ++i) {
-        auto child = p_item->child(i);
-        auto data = getItemNodeData(child);
-        if (data.matched(p_node)) {
-            return child;
-        }
+    // Nodes not fetched yet will be loaded on demand.
+    const auto idx = m_model->indexFromNode(p_node);
+    if (!idx.isValid() && !m_model->isFetched(p_node)) {
+        return;
     }
 
-    return nullptr;
-}
+    // Keep the expansion of descendants.
+    QSet<const Node *> expandedNodes;
+    saveNotebookTreeState(idx, expandedNodes);
 
-QTreeWidgetItem *NotebookNodeExplorer::findNodeTopLevelItem(QTreeWidget *p_tree, const Node *p_node) const
-{
-    auto cnt = p_tree->topLevelItemCount();
-    for (int i = 0; i < cnt; ++i) {
-        auto child = p_tree->topLevelItem(i);
-        auto data = getItemNodeData(child);
-        if (data.matched(p_node)) {
-            return child;
-        }
-    }
+    m_model->reloadNode(p_node);
 
-    return nullptr;
+    restoreExpansion(idx, expandedNodes);
 }
 
 void NotebookNodeExplorer::setCurrentNode(Node *p_node)
 {
     if (!p_node || !p_node->getParent()) {
-        m_masterExplorer->setCurrentItem(nullptr);
+        m_masterExplorer->setCurrentIndex(QModelIndex());
         return;
     }
 
     Q_ASSERT(p_node->getNotebook() == m_notebook);
 
-    // Nodes from root to p_node.
-    QList<Node *> nodes;
-    auto node = p_node;
-    while (node->getParent()) {
-        nodes.push_front(node);
-        node = node->getParent();
-    }
-
-    QList<QTreeWidgetItem *> items;
-    auto nodeIt = nodes.constBegin();
-    auto item = findNodeTopLevelItem(m_masterExplorer, *nodeIt);
-    if (!item) {
+    const auto idx = m_model->locateNode(p_node);
+    if (!idx.isValid()) {
         return;
     }
-    items.push_back(item);
-
-    ++nodeIt;
-    while (nodeIt != nodes.constEnd()) {
-        if (!item) {
-            return;
-        }
-
-        // Find *nodeIt in children of item.
-        auto data = getItemNodeData(item);
-        Q_ASSERT(data.isNode());
-        if (!data.isLoaded()) {
-            loadNode(item, data.getNode(), 1);
-        }
-
-        auto childItem = findNodeChild(item, *nodeIt);
-        if (!childItem) {
-            return;
-        }
-        items.push_back(childItem);
-
-        item = childItem;
-        ++nodeIt;
-    }
-
-    Q_ASSERT(getItemNodeData(item).getNode() == p_node);
 
-    for (auto &it : items) {
-        it->setExpanded(true);
+    for (auto pa = idx; pa.isValid(); pa = pa.parent()) {
+        m_masterExplorer->expand(pa);
     }
 
-    m_masterExplorer->setCurrentItem(item);
+    m_masterExplorer->setCurrentIndex(idx);
 }
 
 void NotebookNodeExplorer::saveNotebookTreeState(bool p_saveCurrentItem)
 {
     if (m_notebook) {
-        stateCache()->save(m_masterExplorer, p_saveCurrentItem);
+        auto &state = m_stateCache[m_notebook.data()];
+        state.m_expandedNodes.clear();
+        saveNotebookTreeState(QModelIndex(), state.m_expandedNodes);
+        state.m_currentNode = p_saveCurrentItem ? getCurrentNode() : nullptr;
     }
 }
 
-QSharedPointer<QTreeWidgetStateCache<Node *>> NotebookNodeExplorer::stateCache() const
+void NotebookNodeExplorer::saveNotebookTreeState(const QModelIndex &p_parent, QSet<const Node *> &p_expandedNodes) const
 {
-    Q_ASSERT(m_notebook);
-    auto it = m_stateCache.find(m_notebook.data());
-    if (it == m_stateCache.end()) {
-        auto keyFunc = [](const QTreeWidgetItem *p_item, bool &p_ok) {
-                           auto data = NotebookNodeExplorer::getItemNodeData(p_item);
-                           if (data.isNode()) {
-                               p_ok = true;
-                               return data.getNode();
-                           }
-
-                           p_ok = false;
-                           return static_cast<Node *>(nullptr);
-                       };
-        auto cache = QSharedPointer<QTreeWidgetStateCache<Node *>>::create(keyFunc);
-        it = const_cast<NotebookNodeExplorer *>(this)->m_stateCache.insert(m_notebook.data(), cache);
+    const int cnt = m_model->rowCount(p_parent);
+    for (int i = 0; i < cnt; ++i) {
+        const auto idx = m_model->index(i, 0, p_parent);
+        if (m_masterExplorer->isExpanded(idx)) {
+            p_expandedNodes.insert(m_model->nodeFromIndex(idx));
+            saveNotebookTreeState(idx, p_expandedNodes);
+        }
     }
-
-    return it.value();
 }
 
 void NotebookNodeExplorer::clearStateCache(const Notebook *p_notebook)
 {
-    auto it = m_stateCache.find(p_notebook);
-    if (it != m_stateCache.end()) {
-        it.value()->clear();
-    }
+    m_stateCache.remove(p_notebook);
 }
 
 void NotebookNodeExplorer::createContextMenuOnRoot(QMenu *p_menu)
@@ -672,7 +279,7 @@ void NotebookNodeExplorer::createContextMenuOnRoot(QMenu *p_menu)
 
 void NotebookNodeExplorer::createContextMenuOnNode(QMenu *p_menu, const Node *p_node)
 {
-    const int selectedSize = m_masterExplorer->selectedItems().size();
+    const int selectedSize = m_masterExplorer->selectionModel()->selectedRows().size();
     QAction *act = nullptr;
 
     if (m_notebook->isRecycleBinNode(p_node)) {
@@ -742,12 +349,6 @@ void NotebookNodeExplorer::createContextMenuOnNode(QMenu *p_menu, const Node *p_
     }
 }
 
-void NotebookNodeExplorer::createContextMenuOnAttachment(QMenu *p_menu, const QString &p_name)
-{
-    Q_UNUSED(p_menu);
-    Q_UNUSED(p_name);
-}
-
 static QIcon generateMenuActionIcon(const QString &p_name)
 {
     const auto &themeMgr = VNoteX::getInst().getThemeMgr();
@@ -945,11 +546,11 @@ QVector<Node *> NotebookNodeExplorer::getSelectedNodes() const
 {
     QVector<Node *> nodes;
 
-    auto items = m_masterExplorer->selectedItems();
-    for (auto &item : items) {
-        auto data = getItemNodeData(item);
-        if (data.isNode()) {
-            nodes.push_back(data.getNode());
+    const auto indexes = m_masterExplorer->selectionModel()->selectedRows();
+    for (const auto &idx : indexes) {
+        auto node = m_model->nodeFromIndex(idx);
+        if (node) {
+            nodes.push_back(node);
         }
     }
 
@@ -1101,9 +702,9 @@ void NotebookNodeExplorer::pasteNodesFromClipboard()
 
 void NotebookNodeExplorer::setNodeExpanded(const Node *p_node, bool p_expanded)
 {
-    auto item = findNode(p_node);
-    if (item) {
-        item->setExpanded(p_expanded);
+    const auto idx = m_model->indexFromNode(p_node);
+    if (idx.isValid()) {
+        m_masterExplorer->setExpanded(idx, p_expanded);
     }
 }
 
@@ -1111,10 +712,10 @@ void NotebookNodeExplorer::selectNodes(const QVector<const Node *> &p_nodes)
 {
     bool firstItem = true;
     for (auto node : p_nodes) {
-        auto item = findNode(node);
-        if (item) {
+        const auto idx = m_model->locateNode(node);
+        if (idx.isValid()) {
             auto flags = firstItem ? QItemSelectionModel::ClearAndSelect : QItemSelectionModel::Select;
-            m_masterExplorer->setCurrentItem(item, 0, flags);
+            m_masterExplorer->selectionModel()->setCurrentIndex(idx, flags);
             firstItem = false;
         }
     }
@@ -1148,7 +749,7 @@ QVector<Node *> NotebookNodeExplorer::confirmSelectedNodes(const QString &p_titl
 
     QVector<ConfirmItemInfo> items;
     for (const auto &node : nodes) {
-        items.push_back(ConfirmItemInfo(getNodeItemIcon(node),
+        items.push_back(ConfirmItemInfo(NotebookNodeModel::getNodeIcon(node),
                                         node->getName(),
                                         node->fetchAbsolutePath(),
                                         node->fetchAbsolutePath(),
@@ -1259,39 +860,28 @@ void NotebookNodeExplorer::updateAndExpandNode(Node *p_node)
 
 bool NotebookNodeExplorer::allSelectedItemsSameType() const
 {
-    auto items = m_masterExplorer->selectedItems();
-    if (items.size() < 2) {
+    const auto nodes = getSelectedNodes();
+    if (nodes.size() < 2) {
         return true;
     }
 
-    auto type = getItemNodeData(items.first()).getType();
-    for (int i = 1; i < items.size(); ++i) {
-        auto itype = getItemNodeData(items[i]).getType();
-        if (itype != type) {
+    bool hasNormalNode = false;
+    bool hasNodeInRecycleBin = false;
+    for (auto node : nodes) {
+        if (m_notebook->isRecycleBinNode(node)) {
             return false;
-        }
-    }
-
-    if (type == NodeData::NodeType::Node) {
-        bool hasNormalNode = false;
-        bool hasNodeInRecycleBin = false;
-        for (auto &item : items) {
-            auto node = getItemNodeData(item).getNode();
-            if (m_notebook->isRecycleBinNode(node)) {
+        } else if (m_notebook->isNodeInRecycleBin(node)) {
+            if (hasNormalNode) {
                 return false;
-            } else if (m_notebook->isNodeInRecycleBin(node)) {
-                if (hasNormalNode) {
-                    return false;
-                }
-
-                hasNodeInRecycleBin = true;
-            } else {
-                if (hasNodeInRecycleBin) {
-                    return false;
-                }
+            }
 
-                hasNormalNode = true;
+            hasNodeInRecycleBin = true;
+        } else {
+            if (hasNodeInRecycleBin) {
+                return false;
             }
+
+            hasNormalNode = true;
         }
     }
 
@@ -1305,14 +895,13 @@ void NotebookNodeExplorer::reload()
 
 void NotebookNodeExplorer::focusNormalNode()
 {
-    auto item = m_masterExplorer->currentItem();
-    if (item && item != m_masterExplorer->topLevelItem(0)) {
+    const auto idx = m_masterExplorer->currentIndex();
+    if (idx.isValid() && idx != m_model->index(0, 0)) {
         // Not recycle bin.
         return;
     }
 
-    auto cnt = m_masterExplorer->topLevelItemCount();
-    if (cnt > 1) {
-        m_masterExplorer->setCurrentItem(m_masterExplorer->topLevelItem(1));
+    if (m_model->rowCount() > 1) {
+        m_masterExplorer->setCurrentIndex(m_model->index(1, 0));
     }
 }
@@ -4,22 +4,21 @@
 #include <QWidget>
 #include <QSharedPointer>
 #include <QHash>
+#include <QSet>
 #include <QScopedPointer>
 
-#include "qtreewidgetstatecache.h"
 #include "clipboarddata.h"
 #include "navigationmodewrapper.h"
 
 class QSplitter;
-class QTreeWidget;
-class QTreeWidgetItem;
 class QMenu;
 
 namespace vnotex
 {
     class Notebook;
     class Node;
-    class TreeWidget;
+    class TreeView;
+    class NotebookNodeModel;
     struct FileOpenParameters;
     class Event;
 
@@ -27,55 +26,6 @@ namespace vnotex
     {
         Q_OBJECT
     public:
-        // Used for a QTreeWidgetItem to hold the info of a node.
-        // Make it public since we need to hold it in a QTreeWidgetItem.
-        class NodeData
-        {
-        public:
-            enum class NodeType { Node, Attachment, Invalid };
-
-            NodeData();
-
-            explicit NodeData(Node *p_node, bool p_loaded);
-
-            explicit NodeData(const QString &p_name);
-
-            NodeData(const NodeData &p_other);
-
-            ~NodeData();
-
-            NodeData &operator=(const NodeData &p_other);
-
-            bool isValid() const;
-
-            bool isNode() const;
-
-            bool isAttachment() const;
-
-            NodeData::NodeType getType() const;
-
-            Node *getNode() const;
-
-            const QString &getName() const;
-
-            void clear();
-
-            bool matched(const Node *p_node) const;
-
-            bool isLoaded() const;
-
-        private:
-            NodeType m_type = NodeType::Invalid;
-
-            union
-            {
-                Node *m_node = nullptr;
-                QString m_name;
-            };
-
-            bool m_loaded = false;
-        };
-
         explicit NotebookNodeExplorer(QWidget *p_parent = nullptr);
 
         void setNotebook(const QSharedPointer<Notebook> &p_notebook);
@@ -102,8 +52,6 @@ namespace vnotex
         void nodeAboutToRemove(Node *p_node, const QSharedPointer<Event> &p_event);
 
     private:
-        enum Column { Name = 0 };
-
         enum Action { NewNote, NewFolder, Properties, OpenLocation, CopyPath,
                       Copy, Cut, Paste, EmptyRecycleBin, Delete,
                       DeleteFromRecycleBin, RemoveFromConfig };
@@ -116,33 +64,12 @@ namespace vnotex
 
         void generateNodeTree();
 
-        void loadRootNode(const Node *p_node) const;
-
-        void loadNode(QTreeWidgetItem *p_item, Node *p_node, int p_level) const;
-
-        void loadChildren(QTreeWidgetItem *p_item, Node *p_node, int p_level) const;
-
-        void loadRecycleBinNode(Node *p_node) const;
-
-        void loadRecycleBinNode(QTreeWidgetItem *p_item, Node *p_node, int p_level) const;
-
-        void fillTreeItem(QTreeWidgetItem *p_item, Node *p_node, bool p_loaded) const;
-
-        QIcon getNodeItemIcon(const Node *p_node) const;
-
-        void initNodeIcons() const;
-
-        QTreeWidgetItem *findNode(const Node *p_node) const;
-
-        QTreeWidgetItem *findNode(QTreeWidgetItem *p_item, const Node *p_node) const;
-
-        QTreeWidgetItem *findNodeChild(QTreeWidgetItem *p_item, const Node *p_node) const;
-
-        QTreeWidgetItem *findNodeTopLevelItem(QTreeWidget *p_tree, const Node *p_node) const;
+        // Expand @p_expandedNodes under @p_parent.
+        void restoreExpansion(const QModelIndex &p_parent, const QSet<const Node *> &p_expandedNodes);
 
         void saveNotebookTreeState(bool p_saveCurrentItem = true);
 
-        QSharedPointer<QTreeWidgetStateCache<Node *>> stateCache() const;
+        void saveNotebookTreeState(const QModelIndex &p_parent, QSet<const Node *> &p_expandedNodes) const;
 
         void clearStateCache(const Notebook *p_notebook);
 
@@ -150,8 +77,6 @@ namespace vnotex
 
         void createContextMenuOnNode(QMenu *p_menu, const Node *p_node);
 
-        void createContextMenuOnAttachment(QMenu *p_menu, const QString &p_name);
-
         // Factory function to create action.
         QAction *createAction(Action p_act, QObject *p_parent);
 
@@ -191,29 +116,26 @@ namespace vnotex
         // Skip the recycle bin node if possible.
         void focusNormalNode();
 
-        static NotebookNodeExplorer::NodeData getItemNodeData(const QTreeWidgetItem *p_item);
+        // Expanded nodes and current node of a notebook's tree.
+        struct TreeState
+        {
+            QSet<const Node *> m_expandedNodes;
 
-        static void setItemNodeData(QTreeWidgetItem *p_item, const NodeData &p_data);
+            Node *m_currentNode = nullptr;
+        };
 
         QSplitter *m_splitter = nullptr;
 
-        TreeWidget *m_masterExplorer = nullptr;
+        TreeView *m_masterExplorer = nullptr;
 
-        QSharedPointer<Notebook> m_notebook;
-
-        QHash<const Notebook *, QSharedPointer<QTreeWidgetStateCache<Node *>>> m_stateCache;
+        NotebookNodeModel *m_model = nullptr;
 
-        QScopedPointer<NavigationModeWrapper<QTreeWidget, QTreeWidgetItem>> m_navigationWrapper;
+        QSharedPointer<Notebook> m_notebook;
 
-        static QIcon s_folderNodeIcon;
-        static QIcon s_fileNodeIcon;
-        static QIcon s_recycleBinNodeIcon;
+        QHash<const Notebook *, TreeState> m_stateCache;
 
-        static const QString c_nodeIconForegroundName;
+        QScopedPointer<NavigationModeWrapper<QTreeView, QModelIndex>> m_navigationWrapper;
     };
 }
 
-
-Q_DECLARE_METATYPE(vnotex::NotebookNodeExplorer::NodeData);
-
 #endif // NOTEBOOKNODEEXPLORER_H
@@ -0,0 +1,334 @@
+#include "notebooknodemodel.h"
+
+#include <QDebug>
+
+#include <notebook/node.h>
+#include <core/exception.h>
+#include <core/vnotex.h>
+#include <core/thememgr.h>
+#include <utils/iconutils.h>
+
+using namespace vnotex;
+
+const QString NotebookNodeModel::c_nodeIconForegroundName = "widgets#notebookexplorer#node_icon#fg";
+
+QIcon NotebookNodeModel::s_folderNodeIcon;
+
+QIcon NotebookNodeModel::s_fileNodeIcon;
+
+QIcon NotebookNodeModel::s_recycleBinNodeIcon;
+
+NotebookNodeModel::NotebookNodeModel(QObject *p_parent)
+    : QAbstractItemModel(p_parent)
+{
+}
+
+void NotebookNodeModel::setRootNode(const QSharedPointer<Node> &p_root)
+{
+    beginResetModel();
+    m_entries.clear();
+    m_root = p_root;
+    if (m_root) {
+        m_entries.insert(m_root.data(), NodeEntry());
+    }
+    endResetModel();
+}
+
+const QSharedPointer<Node> &NotebookNodeModel::getRootNode() const
+{
+    return m_root;
+}
+
+Node *NotebookNodeModel::nodeFromIndex(const QModelIndex &p_index) const
+{
+    if (!p_index.isValid()) {
+        return nullptr;
+    }
+
+    return static_cast<Node *>(p_index.internalPointer());
+}
+
+Node *NotebookNodeModel::nodeOrRoot(const QModelIndex &p_index) const
+{
+    return p_index.isValid() ? nodeFromIndex(p_index) : m_root.data();
+}
+
+QModelIndex NotebookNodeModel::indexFromNode(const Node *p_node) const
+{
+    if (!p_node || p_node == m_root) {
+        return QModelIndex();
+    }
+
+    auto it = m_entries.constFind(p_node);
+    if (it == m_entries.constEnd()) {
+        return QModelIndex();
+    }
+
+    return createIndex(it->m_row, 0, const_cast<Node *>(p_node));
+}
+
+QModelIndex NotebookNodeModel::locateNode(const Node *p_node)
+{
+    if (!m_root || !p_node) {
+        return QModelIndex();
+    }
+
+    // Nodes from root to @p_node.
+    QVector<Node *> nodes;
+    for (auto node = const_cast<Node *>(p_node); node && node != m_root; node = node->getParent()) {
+        nodes.push_front(node);
+    }
+
+    Node *parentNode = m_root.data();
+    QModelIndex idx;
+    for (auto node : nodes) {
+        if (!isFetched(parentNode)) {
+            fetchChildren(parentNode, idx);
+        }
+
+        auto it = m_entries.constFind(node);
+        if (it == m_entries.constEnd() || it->m_parent != parentNode) {
+            return QModelIndex();
+        }
+
+        idx = createIndex(it->m_row, 0, node);
+        parentNode = node;
+    }
+
+    return idx;
+}
+
+bool NotebookNodeModel::isFetched(const Node *p_node) const
+{
+    auto it = m_entries.constFind(p_node);
+    return it != m_entries.constEnd() && it->m_fetched;
+}
+
+void NotebookNodeModel::reloadNode(Node *p_node)
+{
+    if (!p_node) {
+        setRootNode(m_root);
+        return;
+    }
+
+    auto it = m_entries.constFind(p_node);
+    if (it == m_entries.constEnd()) {
+        return;
+    }
+
+    const auto idx = indexFromNode(p_node);
+    if (it->m_fetched) {
+        const int cnt = it->m_children.size();
+        if (cnt > 0) {
+            beginRemoveRows(idx, 0, cnt - 1);
+            removeChildEntries(p_node);
+            endRemoveRows();
+        } else {
+            removeChildEntries(p_node);
+        }
+
+        fetchChildren(p_node, idx);
+    }
+
+    if (idx.isValid()) {
+        // Name or children existence may change.
+        emit dataChanged(idx, idx);
+    }
+}
+
+void NotebookNodeModel::removeChildEntries(const Node *p_node)
+{
+    auto it = m_entries.find(p_node);
+    Q_ASSERT(it != m_entries.end());
+    const auto children = it->m_children;
+    it->m_children.clear();
+    it->m_fetched = false;
+
+    for (const auto &child : children) {
+        if (isFetched(child.data())) {
+            removeChildEntries(child.data());
+        }
+        m_entries.remove(child.data());
+    }
+}
+
+void NotebookNodeModel::fetchChildren(Node *p_node, const QModelIndex &p_index)
+{
+    Q_ASSERT(m_entries.contains(p_node));
+    if (!p_node->isLoaded()) {
+        try {
+            p_node->load();
+        } catch (Exception &p_e) {
+            qWarning() << "failed to load node" << p_node->fetchAbsolutePath() << p_e.what();
+            return;
+        }
+    }
+
+    QVector<QSharedPointer<Node>> children;
+    if (p_node == m_root) {
+        // Render recycle bin node first.
+        children.reserve(p_node->getChildrenCount());
+        for (const auto &child : p_node->getChildren()) {
+            if (child->getUse() == Node::Use::RecycleBin) {
+                children.push_front(child);
+            } else {
+                children.push_back(child);
+            }
+        }
+    } else {
+        children = p_node->getChildren();
+    }
+
+    m_entries[p_node].m_fetched = true;
+    if (children.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(p_index, 0, children.size() - 1);
+    for (int i = 0; i < children.size(); ++i) {
+        NodeEntry entry;
+        entry.m_parent = p_node;
+        entry.m_row = i;
+        m_entries.insert(children[i].data(), entry);
+    }
+    m_entries[p_node].m_children = children;
+    endInsertRows();
+}
+
+QModelIndex NotebookNodeModel::index(int p_row, int p_column, const QModelIndex &p_parent) const
+{
+    if (p_column != 0 || p_row < 0) {
+        return QModelIndex();
+    }
+
+    auto parentNode = nodeOrRoot(p_parent);
+    auto it = m_entries.constFind(parentNode);
+    if (it == m_entries.constEnd() || p_row >= it->m_children.size()) {
+        return QModelIndex();
+    }
+
+    return createIndex(p_row, 0, it->m_children[p_row].data());
+}
+
+QModelIndex NotebookNodeModel::parent(const QModelIndex &p_index) const
+{
+    auto it = m_entries.constFind(nodeFromIndex(p_index));
+    if (it == m_entries.constEnd()) {
+        return QModelIndex();
+    }
+
+    return indexFromNode(it->m_parent);
+}
+
+int NotebookNodeModel::rowCount(const QModelIndex &p_parent) const
+{
+    if (p_parent.column() > 0) {
+        return 0;
+    }
+
+    auto it = m_entries.constFind(nodeOrRoot(p_parent));
+    if (it == m_entries.constEnd()) {
+        return 0;
+    }
+
+    return it->m_children.size();
+}
+
+int NotebookNodeModel::columnCount(const QModelIndex &p_parent) const
+{
+    Q_UNUSED(p_parent);
+    return 1;
+}
+
+bool NotebookNodeModel::hasChildren(const QModelIndex &p_parent) const
+{
+    auto node = nodeOrRoot(p_parent);
+    if (!node || !node->isContainer()) {
+        return false;
+    }
+
+    auto it = m_entries.constFind(node);
+    if (it != m_entries.constEnd() && it->m_fetched) {
+        return !it->m_children.isEmpty();
+    }
+
+    // Unknown until loaded.
+    return !node->isLoaded() || node->getChildrenCount() > 0;
+}
+
+bool NotebookNodeModel::canFetchMore(const QModelIndex &p_parent) const
+{
+    auto node = nodeOrRoot(p_parent);
+    return node && node->isContainer() && !isFetched(node);
+}
+
+void NotebookNodeModel::fetchMore(const QModelIndex &p_parent)
+{
+    auto node = nodeOrRoot(p_parent);
+    if (node && !isFetched(node)) {
+        fetchChildren(node, p_parent);
+    }
+}
+
+QVariant NotebookNodeModel::data(const QModelIndex &p_index, int p_role) const
+{
+    auto node = nodeFromIndex(p_index);
+    if (!node) {
+        return QVariant();
+    }
+
+    const bool isRecycleBin = node->getUse() == Node::Use::RecycleBin;
+    switch (p_role) {
+    case Qt::DisplayRole:
+        return isRecycleBin ? tr("Recycle Bin") : node->getName();
+
+    case Qt::ToolTipRole:
+        return node->getName();
+
+    case Qt::DecorationRole:
+        return getNodeIcon(node);
+
+    case Qt::WhatsThisRole:
+        if (isRecycleBin) {
+            return tr("Recycle bin of this notebook. Deleted files could be found here. "
+                      "It is organized in folders named by date. Nodes could be moved to "
+                      "other folders by Cut and Paste.");
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+void NotebookNodeModel::initNodeIcons()
+{
+    if (!s_folderNodeIcon.isNull()) {
+        return;
+    }
+
+    const auto &themeMgr = VNoteX::getInst().getThemeMgr();
+    const auto fg = themeMgr.paletteColor(c_nodeIconForegroundName);
+    const QString folderIconName("folder_node.svg");
+    const QString fileIconName("file_node.svg");
+    const QString recycleBinIconName("recycle_bin.svg");
+
+    s_folderNodeIcon = IconUtils::fetchIcon(themeMgr.getIconFile(folderIconName), fg);
+    s_fileNodeIcon = IconUtils::fetchIcon(themeMgr.getIconFile(fileIconName), fg);
+    s_recycleBinNodeIcon = IconUtils::fetchIcon(themeMgr.getIconFile(recycleBinIconName), fg);
+}
+
+QIcon NotebookNodeModel::getNodeIcon(const Node *p_node)
+{
+    initNodeIcons();
+
+    if (p_node->hasContent()) {
+        return s_fileNodeIcon;
+    } else if (p_node->getUse() == Node::Use::RecycleBin) {
+        return s_recycleBinNodeIcon;
+    }
+
+    return s_folderNodeIcon;
+}
@@ -0,0 +1,96 @@
+#ifndef NOTEBOOKNODEMODEL_H
+#define NOTEBOOKNODEMODEL_H
+
+#include <QAbstractItemModel>
+#include <QSharedPointer>
+#include <QHash>
+#include <QVector>
+#include <QIcon>
+
+namespace vnotex
+{
+    class Node;
+
+    // Item model backed directly by the nodes of a notebook.
+    // Children of a folder are fetched on demand via fetchMore().
+    class NotebookNodeModel : public QAbstractItemModel
+    {
+        Q_OBJECT
+    public:
+        explicit NotebookNodeModel(QObject *p_parent = nullptr);
+
+        // Recycle bin child of @p_root will be placed at the first row.
+        void setRootNode(const QSharedPointer<Node> &p_root);
+
+        const QSharedPointer<Node> &getRootNode() const;
+
+        Node *nodeFromIndex(const QModelIndex &p_index) const;
+
+        // Return invalid index if @p_node is the root or not fetched yet.
+        QModelIndex indexFromNode(const Node *p_node) const;
+
+        // Fetch all the ancestors of @p_node if needed and return its index.
+        QModelIndex locateNode(const Node *p_node);
+
+        // Re-fetch the children of @p_node if they have been fetched.
+        // If @p_node is null, reset the whole model.
+        void reloadNode(Node *p_node);
+
+        bool isFetched(const Node *p_node) const;
+
+        QModelIndex index(int p_row, int p_column, const QModelIndex &p_parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+        QModelIndex parent(const QModelIndex &p_index) const Q_DECL_OVERRIDE;
+
+        int rowCount(const QModelIndex &p_parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+        int columnCount(const QModelIndex &p_parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+        bool hasChildren(const QModelIndex &p_parent = QModelIndex()) const Q_DECL_OVERRIDE;
+
+        QVariant data(const QModelIndex &p_index, int p_role = Qt::DisplayRole) const Q_DECL_OVERRIDE;
+
+        bool canFetchMore(const QModelIndex &p_parent) const Q_DECL_OVERRIDE;
+
+        void fetchMore(const QModelIndex &p_parent) Q_DECL_OVERRIDE;
+
+        static QIcon getNodeIcon(const Node *p_node);
+
+    private:
+        // State of one node present in the model.
+        struct NodeEntry
+        {
+            // Parent in the model. Null for the root node.
+            Node *m_parent = nullptr;
+
+            int m_row = -1;
+
+            bool m_fetched = false;
+
+            // Hold the children alive while they are rows of the model.
+            QVector<QSharedPointer<Node>> m_children;
+        };
+
+        Node *nodeOrRoot(const QModelIndex &p_index) const;
+
+        void fetchChildren(Node *p_node, const QModelIndex &p_index);
+
+        // Drop entries of all the descendants of @p_node.
+        void removeChildEntries(const Node *p_node);
+
+        static void initNodeIcons();
+
+        QSharedPointer<Node> m_root;
+
+        // Node -> entry for the root and all the fetched nodes.
+        QHash<const Node *, NodeEntry> m_entries;
+
+        static QIcon s_folderNodeIcon;
+        static QIcon s_fileNodeIcon;
+        static QIcon s_recycleBinNodeIcon;
+
+        static const QString c_nodeIconForegroundName;
+    };
+} // ns vnotex
+
+#endif // NOTEBOOKNODEMODEL_H
@@ -17,6 +17,33 @@ bool Outline::isEmpty() const
     return m_headings.isEmpty();
 }
 
+bool Outline::diff(const Outline &p_new, int &p_first, int &p_removedCount, int &p_insertedCount) const
+{
+    const auto &oldHeadings = m_headings;
+    const auto &newHeadings = p_new.m_headings;
+    const int minSize = qMin(oldHeadings.size(), newHeadings.size());
+
+    int prefix = 0;
+    while (prefix < minSize && oldHeadings[prefix] == newHeadings[prefix]) {
+        ++prefix;
+    }
+
+    if (prefix == oldHeadings.size() && prefix == newHeadings.size()) {
+        return false;
+    }
+
+    int suffix = 0;
+    while (suffix < minSize - prefix
+           && oldHeadings[oldHeadings.size() - 1 - suffix] == newHeadings[newHeadings.size() - 1 - suffix]) {
+        ++suffix;
+    }
+
+    p_first = prefix;
+    p_removedCount = oldHeadings.size() - prefix - suffix;
+    p_insertedCount = newHeadings.size() - prefix - suffix;
+    return true;
+}
+
 Outline::Heading::Heading(const QString &p_name, int p_level)
     : m_name(p_name),
       m_level(p_level)
@@ -39,6 +66,12 @@ OutlineProvider::~OutlineProvider()
 
 void OutlineProvider::setOutline(const QSharedPointer<Outline> &p_outline)
 {
+    if (m_outline && p_outline && *m_outline == *p_outline) {
+        // Keep current heading.
+        m_outline = p_outline;
+        return;
+    }
+
     m_outline = p_outline;
     m_currentHeadingIndex = -1;
     emit outlineChanged();
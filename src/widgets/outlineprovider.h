@@ -30,6 +30,10 @@ namespace vnotex
 
         bool isEmpty() const;
 
+        // Get the range of headings to replace to turn this outline into @p_new.
+        // Return false if they are the same.
+        bool diff(const Outline &p_new, int &p_first, int &p_removedCount, int &p_insertedCount) const;
+
         QVector<Heading> m_headings;
     };
 
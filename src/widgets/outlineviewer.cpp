@@ -172,25 +172,93 @@ void OutlineViewer::showEvent(QShowEvent *p_event)
 
 void OutlineViewer::updateOutline(const QSharedPointer<Outline> &p_outline)
 {
-    if (!p_outline) {
-        if (m_outline.isEmpty()) {
-            return;
-        }
-        m_outline.clear();
-    } else {
-        if (m_outline == *p_outline) {
-            return;
-        }
+    const auto oldOutline = m_outline;
+    if (p_outline) {
         m_outline = *p_outline;
+    } else {
+        m_outline.clear();
+    }
+
+    int first = 0, removedCount = 0, insertedCount = 0;
+    if (!oldOutline.diff(m_outline, first, removedCount, insertedCount)) {
+        return;
     }
 
     m_muted = true;
-    updateTreeToOutline(m_tree, m_outline);
+    if (!patchTree(oldOutline, first, removedCount, insertedCount)) {
+        updateTreeToOutline(m_tree, m_outline);
 
-    expandTree(m_autoExpandedLevel);
+        expandTree(m_autoExpandedLevel);
+    }
     m_muted = false;
 }
 
+bool OutlineViewer::patchTree(const Outline &p_oldOutline, int p_first, int p_removedCount, int p_insertedCount)
+{
+    const auto &oldHeadings = p_oldOutline.m_headings;
+    const auto &newHeadings = m_outline.m_headings;
+    if (oldHeadings.isEmpty() || newHeadings.isEmpty()) {
+        return false;
+    }
+
+    // Headings are perfect so the first one is at the base level.
+    const int baseLevel = newHeadings[0].m_level;
+    if (oldHeadings[0].m_level != baseLevel) {
+        return false;
+    }
+
+    // Extend the changed range to whole top level subtrees.
+    int start = p_first;
+    while (start > 0
+           && (start >= oldHeadings.size()
+               || start >= newHeadings.size()
+               || oldHeadings[start].m_level != baseLevel
+               || newHeadings[start].m_level != baseLevel)) {
+        --start;
+    }
+
+    // Headings after the changed range are the same.
+    int oldEnd = p_first + p_removedCount;
+    int newEnd = p_first + p_insertedCount;
+    while (newEnd < newHeadings.size() && newHeadings[newEnd].m_level != baseLevel) {
+        ++oldEnd;
+        ++newEnd;
+    }
+
+    int topIdx = 0;
+    for (int i = 0; i < start; ++i) {
+        if (newHeadings[i].m_level == baseLevel) {
+            ++topIdx;
+        }
+    }
+
+    for (int i = start; i < oldEnd; ++i) {
+        if (oldHeadings[i].m_level == baseLevel) {
+            delete m_tree->takeTopLevelItem(topIdx);
+        }
+    }
+
+    QTreeWidgetItem root;
+    int idx = 0;
+    renderTreeAtLevel(newHeadings.mid(start, newEnd - start), idx, baseLevel, m_tree, &root, nullptr);
+    const auto items = root.takeChildren();
+    m_tree->insertTopLevelItems(topIdx, items);
+
+    const int expandDepth = m_autoExpandedLevel - baseLevel;
+    for (auto item : items) {
+        shiftItemIndex(item, start);
+        expandItem(item, expandDepth);
+    }
+
+    const int delta = p_insertedCount - p_removedCount;
+    if (delta != 0) {
+        for (int i = topIdx + items.size(); i < m_tree->topLevelItemCount(); ++i) {
+            shiftItemIndex(m_tree->topLevelItem(i), delta);
+        }
+    }
+    return true;
+}
+
 void OutlineViewer::updateCurrentHeading(int p_idx)
 {
     if (m_currentHeadingIndex == p_idx) {
@@ -257,6 +325,26 @@ void OutlineViewer::fillTreeItem(QTreeWidgetItem *p_item, const Outline::Heading
     p_item->setToolTip(Column::Name, p_heading.m_name);
 }
 
+void OutlineViewer::shiftItemIndex(QTreeWidgetItem *p_item, int p_delta)
+{
+    p_item->setData(Column::Name, Qt::UserRole, p_item->data(Column::Name, Qt::UserRole).toInt() + p_delta);
+    for (int i = 0; i < p_item->childCount(); ++i) {
+        shiftItemIndex(p_item->child(i), p_delta);
+    }
+}
+
+void OutlineViewer::expandItem(QTreeWidgetItem *p_item, int p_depth)
+{
+    if (p_depth <= 0) {
+        return;
+    }
+
+    p_item->setExpanded(true);
+    for (int i = 0; i < p_item->childCount(); ++i) {
+        expandItem(p_item->child(i), p_depth - 1);
+    }
+}
+
 void OutlineViewer::highlightHeading(int p_idx)
 {
     if (p_idx == -1) {
@@ -45,6 +45,10 @@ namespace vnotex
 
         void updateOutline(const QSharedPointer<Outline> &p_outline);
 
+        // Replace the items of changed headings only. m_outline has been updated.
+        // Return false if the tree needs to be rebuilt.
+        bool patchTree(const Outline &p_oldOutline, int p_first, int p_removedCount, int p_insertedCount);
+
         void updateCurrentHeading(int p_idx);
 
         void highlightHeading(int p_idx);
@@ -65,6 +69,12 @@ namespace vnotex
 
         static void fillTreeItem(QTreeWidgetItem *p_item, const Outline::Heading &p_heading, int p_index);
 
+        // Add @p_delta to the heading index of @p_item and its children.
+        static void shiftItemIndex(QTreeWidgetItem *p_item, int p_delta);
+
+        // Expand @p_item and its children to @p_depth levels.
+        static void expandItem(QTreeWidgetItem *p_item, int p_depth);
+
         bool m_muted = false;
 
         QTimer *m_expandTimer = nullptr;
@@ -0,0 +1,77 @@
+#include "renderstatspopup.h"
+
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QHeaderView>
+
+#include "editors/renderstatsmgr.h"
+
+using namespace vnotex;
+
+RenderStatsPopup::RenderStatsPopup(QWidget *p_parent)
+    : QMenu(p_parent)
+{
+    setupUI();
+
+    connect(&RenderStatsMgr::getInst(), &RenderStatsMgr::statsUpdated,
+            this, [this](const QString &p_notePath) {
+                if (isVisible() && p_notePath == m_notePath) {
+                    updateStats();
+                }
+            });
+}
+
+void RenderStatsPopup::setupUI()
+{
+    auto mainLayout = new QVBoxLayout(this);
+
+    m_summaryLabel = new QLabel(this);
+    mainLayout->addWidget(m_summaryLabel);
+
+    m_tree = new QTreeWidget(this);
+    m_tree->setRootIsDecorated(false);
+    m_tree->setSelectionMode(QAbstractItemView::NoSelection);
+    m_tree->setHeaderLabels({tr("Stage"), tr("Last (ms)"), tr("Average (ms)"), tr("Max (ms)")});
+    m_tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    mainLayout->addWidget(m_tree);
+
+    setMinimumSize(480, 320);
+}
+
+void RenderStatsPopup::setNotePath(const QString &p_notePath)
+{
+    m_notePath = p_notePath;
+    updateStats();
+}
+
+void RenderStatsPopup::updateStats()
+{
+    m_tree->clear();
+
+    const auto stats = RenderStatsMgr::getInst().getNoteStats(m_notePath);
+    if (stats.m_total.m_count == 0) {
+        m_summaryLabel->setText(tr("Not rendered yet"));
+        return;
+    }
+
+    m_summaryLabel->setText(tr("Rendered %n time(s), %1 ms on average", "", stats.m_total.m_count)
+                            .arg(stats.m_total.averageTime()));
+
+    auto addItem = [this](const QString &p_name, const RenderStatsMgr::StageStats &p_stats) {
+        auto item = new QTreeWidgetItem(m_tree);
+        item->setText(0, p_name);
+        item->setText(1, QString::number(p_stats.m_lastTime));
+        item->setText(2, QString::number(p_stats.averageTime()));
+        item->setText(3, QString::number(p_stats.m_maxTime));
+        for (int col = 1; col < 4; ++col) {
+            item->setTextAlignment(col, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    };
+
+    // Workers are timed from the start of the round to their finish.
+    for (const auto &stage : stats.m_stages) {
+        addItem(stage.m_name, stage);
+    }
+    addItem(tr("Total"), stats.m_total);
+}
@@ -0,0 +1,35 @@
+#ifndef RENDERSTATSPOPUP_H
+#define RENDERSTATSPOPUP_H
+
+#include <QMenu>
+
+class QTreeWidget;
+class QLabel;
+
+namespace vnotex
+{
+    // Show the read mode render timings of one note by stage.
+    class RenderStatsPopup : public QMenu
+    {
+        Q_OBJECT
+    public:
+        explicit RenderStatsPopup(QWidget *p_parent = nullptr);
+
+        void setNotePath(const QString &p_notePath);
+
+    private:
+        void setupUI();
+
+        void updateStats();
+
+        QString m_notePath;
+
+        // Managed by QObject.
+        QLabel *m_summaryLabel = nullptr;
+
+        // Managed by QObject.
+        QTreeWidget *m_tree = nullptr;
+    };
+}
+
+#endif // RENDERSTATSPOPUP_H
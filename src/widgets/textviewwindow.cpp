@@ -77,6 +77,19 @@ void TextViewWindow::handleBufferChangedInternal()
     TextViewWindowHelper::handleBufferChanged(this);
 }
 
+void TextViewWindow::handleBufferLargeFileChanged()
+{
+    updateSyntax();
+}
+
+void TextViewWindow::updateSyntax()
+{
+    auto buffer = getBuffer();
+    Q_ASSERT(buffer);
+    // Skip highlighting large file.
+    m_editor->setSyntax(buffer->isLargeFile() ? QString() : QFileInfo(buffer->getPath()).suffix());
+}
+
 void TextViewWindow::syncEditorFromBuffer()
 {
     const bool old = m_propogateEditorToBuffer;
@@ -84,7 +97,7 @@ void TextViewWindow::syncEditorFromBuffer()
 
     auto buffer = getBuffer();
     if (buffer) {
-        m_editor->setSyntax(QFileInfo(buffer->getPath()).suffix());
+        updateSyntax();
         m_editor->setReadOnly(buffer->isReadOnly());
         m_editor->setText(buffer->getContent());
         m_editor->setModified(buffer->isModified());
@@ -106,7 +119,12 @@ void TextViewWindow::syncEditorFromBufferContent()
 
     auto buffer = getBuffer();
     Q_ASSERT(buffer);
-    m_editor->setText(buffer->getContent());
+    // Apply only the edits since last sync if possible to keep the undo history.
+    QVector<Buffer::ContentDelta> deltas;
+    if (!buffer->getContentDeltas(m_bufferRevision, deltas)
+        || !TextViewWindowHelper::applyContentDeltas(m_editor->getTextEdit()->document(), deltas)) {
+        m_editor->setText(buffer->getContent());
+    }
     m_editor->setModified(buffer->isModified());
 
     m_bufferRevision = buffer->getRevision();
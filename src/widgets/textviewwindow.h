@@ -33,6 +33,8 @@ namespace vnotex
 
         void handleBufferChangedInternal() Q_DECL_OVERRIDE;
 
+        void handleBufferLargeFileChanged() Q_DECL_OVERRIDE;
+
         void handleFindTextChanged(const QString &p_text, FindOptions p_options) Q_DECL_OVERRIDE;
 
         void handleFindNext(const QString &p_text, FindOptions p_options) Q_DECL_OVERRIDE;
@@ -57,6 +59,9 @@ namespace vnotex
     private:
         void setupUI();
 
+        // Set the syntax of the editor according to current buffer.
+        void updateSyntax();
+
         void setupToolBar();
 
         // When we have new changes to the buffer content from our ViewWindow,
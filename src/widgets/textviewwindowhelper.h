@@ -2,10 +2,15 @@
 #define TEXTVIEWWINDOWHELPER_H
 
 #include <QFileInfo>
+#include <QSharedPointer>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QVector>
 
 #include <vtextedit/texteditorconfig.h>
 #include <core/texteditorconfig.h>
 #include <core/configmgr.h>
+#include <core/buffer/buffer.h>
 #include <utils/widgetutils.h>
 
 namespace vnotex
@@ -18,6 +23,58 @@ namespace vnotex
     public:
         TextViewWindowHelper() = delete;
 
+        // Collect edits reported by QTextDocument::contentsChange between two contentsChanged.
+        struct EditRecorder
+        {
+            void reset(const QTextDocument *p_doc)
+            {
+                m_edits.clear();
+                m_length = plainTextLength(p_doc);
+                m_valid = true;
+            }
+
+            void record(const QTextDocument *p_doc, int p_position, int p_charsRemoved, int p_charsAdded)
+            {
+                if (!m_valid) {
+                    return;
+                }
+
+                // QTextDocument may count the last paragraph separator in.
+                const int length = plainTextLength(p_doc);
+                const int added = qMin(p_charsAdded, length - p_position);
+                const int removed = qMin(p_charsRemoved, m_length - p_position);
+                if (p_position < 0 || added < 0 || removed < 0 || m_length - removed + added != length) {
+                    m_valid = false;
+                    return;
+                }
+
+                Buffer::ContentEdit edit;
+                edit.m_position = p_position;
+                edit.m_removedCount = removed;
+                if (added > 0) {
+                    QTextCursor cursor(const_cast<QTextDocument *>(p_doc));
+                    cursor.setPosition(p_position);
+                    cursor.setPosition(p_position + added, QTextCursor::KeepAnchor);
+                    edit.m_insertedText = cursor.selectedText();
+                    edit.m_insertedText.replace(QChar::ParagraphSeparator, QLatin1Char('\n'));
+                }
+                m_edits.push_back(edit);
+                m_length = length;
+            }
+
+            bool isValid(const QTextDocument *p_doc) const
+            {
+                return m_valid && !m_edits.isEmpty() && m_length == plainTextLength(p_doc);
+            }
+
+            QVector<Buffer::ContentEdit> m_edits;
+
+            // Length of the plain text after m_edits.
+            int m_length = 0;
+
+            bool m_valid = true;
+        };
+
         template <typename _ViewWindow>
         static void connectEditor(_ViewWindow *p_win)
         {
@@ -27,18 +84,66 @@ namespace vnotex
                                emit p_win->focused(p_win);
                            });
 
+            // Record the edits of one change to let other windows apply only the deltas.
+            auto doc = editor->getTextEdit()->document();
+            auto recorder = QSharedPointer<EditRecorder>::create();
+            recorder->reset(doc);
+            p_win->connect(doc, &QTextDocument::contentsChange,
+                           p_win, [doc, recorder](int p_position, int p_charsRemoved, int p_charsAdded) {
+                               recorder->record(doc, p_position, p_charsRemoved, p_charsAdded);
+                           });
+
             p_win->connect(editor->getTextEdit(), &vte::VTextEdit::contentsChanged,
-                           p_win, [p_win, editor]() {
+                           p_win, [p_win, editor, doc, recorder]() {
                                if (p_win->m_propogateEditorToBuffer) {
                                    p_win->getBuffer()->setModified(editor->isModified());
-                                   p_win->getBuffer()->invalidateContent(
-                                       p_win, [p_win](int p_revision) {
-                                           p_win->setBufferRevisionAfterInvalidation(p_revision);
-                                       });
+                                   auto setRevision = [p_win](int p_revision) {
+                                       p_win->setBufferRevisionAfterInvalidation(p_revision);
+                                   };
+                                   if (recorder->isValid(doc)) {
+                                       p_win->getBuffer()->invalidateContent(p_win,
+                                                                             recorder->m_edits,
+                                                                             recorder->m_length,
+                                                                             setRevision);
+                                   } else {
+                                       p_win->getBuffer()->invalidateContent(p_win, setRevision);
+                                   }
                                }
+                               recorder->reset(doc);
                            });
         }
 
+        // Apply @p_deltas to @p_doc in one edit block.
+        // Return false if the result does not match and the content needs a full reload.
+        static bool applyContentDeltas(QTextDocument *p_doc, const QVector<Buffer::ContentDelta> &p_deltas)
+        {
+            QTextCursor cursor(p_doc);
+            cursor.beginEditBlock();
+            bool ok = true;
+            for (const auto &delta : p_deltas) {
+                for (const auto &edit : delta.m_edits) {
+                    const int length = plainTextLength(p_doc);
+                    if (edit.m_position < 0
+                        || edit.m_removedCount < 0
+                        || edit.m_position + edit.m_removedCount > length) {
+                        ok = false;
+                        break;
+                    }
+
+                    cursor.setPosition(edit.m_position);
+                    cursor.setPosition(edit.m_position + edit.m_removedCount, QTextCursor::KeepAnchor);
+                    cursor.insertText(edit.m_insertedText);
+                }
+
+                if (!ok || plainTextLength(p_doc) != delta.m_length) {
+                    ok = false;
+                    break;
+                }
+            }
+            cursor.endEditBlock();
+            return ok;
+        }
+
         template <typename _ViewWindow>
         static void handleBufferChanged(_ViewWindow *p_win)
         {
@@ -50,6 +155,11 @@ namespace vnotex
             emit p_win->modeChanged();
         }
 
+        static int plainTextLength(const QTextDocument *p_doc)
+        {
+            return p_doc->characterCount() - 1;
+        }
+
         static QSharedPointer<vte::TextEditorConfig> createTextEditorConfig(const TextEditorConfig &p_config,
                                                                             const QString &p_themeFile,
                                                                             const QString &p_syntaxTheme)
@@ -1,5 +1,7 @@
 #include "treeview.h"
 
+#include <QMouseEvent>
+#include <QHeaderView>
 #include <QKeyEvent>
 
 #include <utils/widgetutils.h>
@@ -11,11 +13,87 @@ TreeView::TreeView(QWidget *p_parent)
 {
 }
 
+TreeView::TreeView(TreeView::Flags p_flags, QWidget *p_parent)
+    : QTreeView(p_parent),
+      m_flags(p_flags)
+{
+}
+
+void TreeView::mousePressEvent(QMouseEvent *p_event)
+{
+    QTreeView::mousePressEvent(p_event);
+
+    if (m_flags & Flag::ClickSpaceToClearSelection) {
+        auto idx = indexAt(p_event->pos());
+        if (!idx.isValid()) {
+            clearSelection();
+            setCurrentIndex(QModelIndex());
+        }
+    }
+}
+
 void TreeView::keyPressEvent(QKeyEvent *p_event)
 {
     if (WidgetUtils::processKeyEventLikeVi(this, p_event)) {
         return;
     }
 
+    switch (p_event->key()) {
+    case Qt::Key_Return:
+        Q_FALLTHROUGH();
+    case Qt::Key_Enter:
+    {
+        auto idx = currentIndex();
+        if (idx.isValid() && model()->hasChildren(idx)) {
+            setExpanded(idx, !isExpanded(idx));
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+
     QTreeView::keyPressEvent(p_event);
 }
+
+void TreeView::setupSingleColumnHeaderlessTree(QTreeView *p_view, bool p_contextMenu, bool p_extendedSelection)
+{
+    p_view->setHeaderHidden(true);
+    if (p_contextMenu) {
+        p_view->setContextMenuPolicy(Qt::CustomContextMenu);
+    }
+    if (p_extendedSelection) {
+        p_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    }
+}
+
+void TreeView::showHorizontalScrollbar(QTreeView *p_view)
+{
+    p_view->header()->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    p_view->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    p_view->header()->setStretchLastSection(false);
+}
+
+QVector<QModelIndex> TreeView::getVisibleIndexes(const QTreeView *p_view)
+{
+    QVector<QModelIndex> indexes;
+
+    auto idx = p_view->indexAt(QPoint(0, 0));
+    if (!idx.isValid()) {
+        return indexes;
+    }
+
+    const auto lastIdx = p_view->indexAt(p_view->viewport()->rect().bottomLeft());
+    while (idx.isValid()) {
+        indexes.append(idx);
+        if (idx == lastIdx) {
+            break;
+        }
+
+        idx = p_view->indexBelow(idx);
+    }
+
+    return indexes;
+}
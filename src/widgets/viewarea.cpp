@@ -210,6 +210,13 @@ ViewSplit *ViewArea::createViewSplit(QWidget *p_parent)
             this, [this](ViewWindow *p_win) {
                 closeViewWindow(p_win, false, true);
             });
+    connect(split, &ViewSplit::viewWindowReopenRequested,
+            this, [this](ViewWindow *p_win) {
+                // Do not delete @p_win within its own call stack.
+                QTimer::singleShot(0, p_win, [this, p_win]() {
+                    reopenViewWindow(p_win);
+                });
+            });
     connect(split, &ViewSplit::verticalSplitRequested,
             this, [this](ViewSplit *p_split) {
                 splitViewSplit(p_split, SplitType::Vertical);
@@ -447,6 +454,30 @@ bool ViewArea::closeViewWindow(ViewWindow *p_win, bool p_force, bool p_removeSpl
     return true;
 }
 
+void ViewArea::reopenViewWindow(ViewWindow *p_win)
+{
+    auto split = p_win->getViewSplit();
+    auto buffer = p_win->getBuffer();
+    if (!split || !buffer) {
+        return;
+    }
+
+    auto curWin = getCurrentViewWindow();
+
+    auto paras = QSharedPointer<FileOpenParameters>::create();
+    auto win = buffer->createViewWindow(paras, nullptr);
+    split->addViewWindow(win, split->indexOf(p_win) + 1);
+
+    // The buffer is kept by the new window.
+    closeViewWindow(p_win, true, false);
+
+    if (curWin == p_win) {
+        setCurrentViewWindow(win);
+    } else if (curWin) {
+        setCurrentViewWindow(curWin);
+    }
+}
+
 QSharedPointer<ViewWorkspace> ViewArea::createWorkspace()
 {
     // Get the id of the workspace.
@@ -113,6 +113,9 @@ namespace vnotex
         // @p_removeSplitIfEmpty: whether remove the workspace and split if @p_win is that only ViewWindow left.
         bool closeViewWindow(ViewWindow *p_win, bool p_force, bool p_removeSplitIfEmpty);
 
+        // Replace @p_win with a new ViewWindow of its buffer at the same place.
+        void reopenViewWindow(ViewWindow *p_win);
+
         void maximizeViewSplit(ViewSplit *p_split);
 
         void distributeViewSplits();
@@ -303,9 +303,9 @@ int ViewSplit::getViewWindowCount() const
     return count();
 }
 
-void ViewSplit::addViewWindow(ViewWindow *p_win)
+void ViewSplit::addViewWindow(ViewWindow *p_win, int p_idx)
 {
-    int idx = addTab(p_win, p_win->getIcon(), p_win->getName());
+    int idx = insertTab(p_idx, p_win, p_win->getIcon(), p_win->getName());
     setTabToolTip(idx, p_win->getTitle());
 
     p_win->setViewSplit(this);
@@ -331,6 +331,12 @@ void ViewSplit::addViewWindow(ViewWindow *p_win)
                 Q_ASSERT(idx != -1);
                 setTabText(idx, win->getName());
             });
+
+    connect(p_win, &ViewWindow::reopenRequested,
+            this, [this]() {
+                auto win = dynamic_cast<ViewWindow *>(sender());
+                emit viewWindowReopenRequested(win);
+            });
 }
 
 ViewWindow *ViewSplit::getCurrentViewWindow() const
@@ -40,7 +40,8 @@ namespace vnotex
 
         int getViewWindowCount() const;
 
-        void addViewWindow(ViewWindow *p_win);
+        // @p_idx: index of the tab to insert at. Append if -1.
+        void addViewWindow(ViewWindow *p_win, int p_idx = -1);
 
         ViewWindow *getCurrentViewWindow() const;
         void setCurrentViewWindow(ViewWindow *p_win);
@@ -65,6 +66,8 @@ namespace vnotex
     signals:
         void viewWindowCloseRequested(ViewWindow *p_win);
 
+        void viewWindowReopenRequested(ViewWindow *p_win);
+
         void verticalSplitRequested(ViewSplit *p_split);
 
         void horizontalSplitRequested(ViewSplit *p_split);
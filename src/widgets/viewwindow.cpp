@@ -88,6 +88,9 @@ ViewWindow::ViewWindow(QWidget *p_parent)
                     connect(buffer, &Buffer::nameChanged,
                             this, &ViewWindow::nameChanged);
 
+                    connect(buffer, &Buffer::largeFileChanged,
+                            this, &ViewWindow::handleBufferLargeFileChanged);
+
                     connect(buffer, &Buffer::attachmentChanged,
                             this, &ViewWindow::attachmentChanged);
                 }
@@ -603,6 +606,10 @@ bool ViewWindow::inModeCanInsert() const
     return m_mode == Mode::Edit || m_mode == Mode::FocusPreview || m_mode == Mode::FullPreview;
 }
 
+void ViewWindow::handleBufferLargeFileChanged()
+{
+}
+
 void ViewWindow::handleTypeAction(TypeAction p_action)
 {
     Q_UNUSED(p_action);
@@ -792,6 +799,12 @@ int ViewWindow::checkFileMissingOrChangedOutside()
 void ViewWindow::checkFileMissingOrChangedOutsidePeriodically()
 {
     if (m_fileChangeCheckEnabled) {
+        if (m_buffer->isFileWatched()
+            && !(m_buffer->state() & (Buffer::StateFlag::FileMissingOnDisk | Buffer::StateFlag::FileChangedOutside))) {
+            // FileWatcher will update the state once the file changes.
+            return;
+        }
+
         // Disable it first.
         m_fileChangeCheckEnabled = false;
         int ret = checkFileMissingOrChangedOutside();
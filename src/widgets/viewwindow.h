@@ -102,6 +102,10 @@ namespace vnotex
 
         void attachmentChanged();
 
+        // Emit to replace this ViewWindow with a new one created by the buffer,
+        // which may be of another type.
+        void reopenRequested();
+
     protected:
         enum TypeAction
         {
@@ -136,6 +140,9 @@ namespace vnotex
         // Handle current buffer change.
         virtual void handleBufferChangedInternal() = 0;
 
+        // Handle the switch of large file mode of current buffer.
+        virtual void handleBufferLargeFileChanged();
+
         // Handle all kinds of type action.
         virtual void handleTypeAction(TypeAction p_action);
 
@@ -9,11 +9,24 @@ using namespace vnotex;
 WebViewer::WebViewer(const QColor &p_background,
                      qreal p_zoomFactor,
                      QWidget *p_parent)
+    : WebViewer(nullptr, p_background, p_zoomFactor, p_parent)
+{
+}
+
+WebViewer::WebViewer(QWebEnginePage *p_page,
+                     const QColor &p_background,
+                     qreal p_zoomFactor,
+                     QWidget *p_parent)
     : QWebEngineView(p_parent)
 {
     setAcceptDrops(false);
 
-    auto viewPage = new WebPage(this);
+    auto viewPage = p_page;
+    if (viewPage) {
+        viewPage->setParent(this);
+    } else {
+        viewPage = new WebPage(this);
+    }
     setPage(viewPage);
 
     connect(viewPage, &QWebEnginePage::linkHovered,
@@ -23,7 +36,8 @@ WebViewer::WebViewer(const QColor &p_background,
     // Setting Qt::transparent will force GrayScale antialias rendering.
     viewPage->setBackgroundColor(p_background);
 
-    if (!Utils::fuzzyEqual(p_zoomFactor, 1.0)) {
+    // A reused page may have been zoomed.
+    if (p_page || !Utils::fuzzyEqual(p_zoomFactor, 1.0)) {
         setZoomFactor(p_zoomFactor);
     }
 }
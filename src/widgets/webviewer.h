@@ -13,6 +13,12 @@ namespace vnotex
                            qreal p_zoomFactor,
                            QWidget *p_parent = nullptr);
 
+        // Use @p_page loaded already. @p_page will be managed by WebViewer.
+        WebViewer(QWebEnginePage *p_page,
+                  const QColor &p_background,
+                  qreal p_zoomFactor,
+                  QWidget *p_parent = nullptr);
+
         virtual ~WebViewer();
 
     signals:
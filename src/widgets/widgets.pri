@@ -30,7 +30,12 @@ SOURCES += \
     $$PWD/editors/markdowntablehelper.cpp \
     $$PWD/editors/markdownviewer.cpp \
     $$PWD/editors/markdownvieweradapter.cpp \
+    $$PWD/editors/markdownviewerpool.cpp \
+    $$PWD/editors/previewdataserver.cpp \
     $$PWD/editors/previewhelper.cpp \
+    $$PWD/editors/previewrenderer.cpp \
+    $$PWD/editors/renderstatsmgr.cpp \
+    $$PWD/editors/sectionnumberupdater.cpp \
     $$PWD/editors/statuswidget.cpp \
     $$PWD/editors/texteditor.cpp \
     $$PWD/editreaddiscardaction.cpp \
@@ -47,6 +52,7 @@ SOURCES += \
     $$PWD/outlinepopup.cpp \
     $$PWD/outlineprovider.cpp \
     $$PWD/outlineviewer.cpp \
+    $$PWD/renderstatspopup.cpp \
     $$PWD/propertydefs.cpp \
     $$PWD/systemtrayhelper.cpp \
     $$PWD/textviewwindow.cpp \
@@ -66,6 +72,7 @@ SOURCES += \
     $$PWD/dialogs/scrolldialog.cpp \
     $$PWD/notebookselector.cpp \
     $$PWD/notebooknodeexplorer.cpp \
+    $$PWD/notebooknodemodel.cpp \
     $$PWD/messageboxhelper.cpp \
     $$PWD/dialogs/newfolderdialog.cpp \
     $$PWD/treewidget.cpp \
@@ -79,6 +86,8 @@ SOURCES += \
     $$PWD/statusbarhelper.cpp \
     $$PWD/dialogs/deleteconfirmdialog.cpp \
     $$PWD/dialogs/importfolderutils.cpp \
+    $$PWD/dialogs/folderimporter.cpp \
+    $$PWD/dialogs/searchdialog.cpp \
     $$PWD/titletoolbar.cpp \
     $$PWD/viewarea.cpp
 
@@ -89,6 +98,8 @@ HEADERS += \
     $$PWD/combobox.h \
     $$PWD/dialogs/dialog.h \
     $$PWD/dialogs/importfolderutils.h \
+    $$PWD/dialogs/folderimporter.h \
+    $$PWD/dialogs/searchdialog.h \
     $$PWD/dialogs/filepropertiesdialog.h \
     $$PWD/dialogs/imageinsertdialog.h \
     $$PWD/dialogs/importfolderdialog.h \
@@ -115,7 +126,12 @@ HEADERS += \
     $$PWD/editors/markdowntablehelper.h \
     $$PWD/editors/markdownviewer.h \
     $$PWD/editors/markdownvieweradapter.h \
+    $$PWD/editors/markdownviewerpool.h \
+    $$PWD/editors/previewdataserver.h \
     $$PWD/editors/previewhelper.h \
+    $$PWD/editors/previewrenderer.h \
+    $$PWD/editors/renderstatsmgr.h \
+    $$PWD/editors/sectionnumberupdater.h \
     $$PWD/editors/statuswidget.h \
     $$PWD/editors/texteditor.h \
     $$PWD/editreaddiscardaction.h \
@@ -133,6 +149,7 @@ HEADERS += \
     $$PWD/outlinepopup.h \
     $$PWD/outlineprovider.h \
     $$PWD/outlineviewer.h \
+    $$PWD/renderstatspopup.h \
     $$PWD/propertydefs.h \
     $$PWD/systemtrayhelper.h \
     $$PWD/textviewwindow.h \
@@ -153,6 +170,7 @@ HEADERS += \
     $$PWD/dialogs/scrolldialog.h \
     $$PWD/notebookselector.h \
     $$PWD/notebooknodeexplorer.h \
+    $$PWD/notebooknodemodel.h \
     $$PWD/messageboxhelper.h \
     $$PWD/dialogs/newfolderdialog.h \
     $$PWD/qtreewidgetstatecache.h \
@@ -0,0 +1,126 @@
+#include "test_buffercontent.h"
+
+#include <QRandomGenerator>
+
+#include <buffer/buffercontent.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+// Size in characters of the chunks of BufferContent.
+static const int c_chunkSize = 64 * 1024;
+
+static QString generateText(int p_size)
+{
+    QString text;
+    text.reserve(p_size);
+    for (int i = 0; i < p_size; ++i) {
+        text.append(QChar('a' + i % 26));
+    }
+    return text;
+}
+
+// Return content of @p_text split into chunks by an edit.
+static BufferContent createChunkedContent(const QString &p_text)
+{
+    BufferContent content(p_text);
+    content.replace(0, 1, p_text.left(1));
+    return content;
+}
+
+TestBufferContent::TestBufferContent(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestBufferContent::testReplace_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("position");
+    QTest::addColumn<int>("removedCount");
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("insert_at_chunk_edge") << 3 * c_chunkSize << c_chunkSize << 0 << "vnotex";
+    QTest::newRow("replace_at_chunk_edge") << 3 * c_chunkSize << c_chunkSize << 3 << "vnotex";
+    QTest::newRow("remove_before_chunk_edge") << 3 * c_chunkSize << c_chunkSize - 3 << 3 << "";
+    QTest::newRow("remove_across_chunks") << 3 * c_chunkSize << c_chunkSize - 10 << 20 << "";
+    QTest::newRow("remove_across_all_chunks") << 3 * c_chunkSize << 1 << 3 * c_chunkSize - 2 << "";
+    QTest::newRow("replace_across_chunks") << 3 * c_chunkSize << c_chunkSize - 10 << c_chunkSize + 20 << "vnotex";
+    QTest::newRow("remove_all") << 3 * c_chunkSize << 0 << 3 * c_chunkSize << "";
+    QTest::newRow("insert_at_start") << 3 * c_chunkSize << 0 << 0 << "vnotex";
+    QTest::newRow("append") << 3 * c_chunkSize << 3 * c_chunkSize << 0 << "vnotex";
+    QTest::newRow("append_large") << 100 << 100 << 0 << generateText(2 * c_chunkSize + 1);
+    QTest::newRow("replace_small") << 100 << 10 << 5 << "vnotex";
+}
+
+void TestBufferContent::testReplace()
+{
+    QFETCH(int, size);
+    QFETCH(int, position);
+    QFETCH(int, removedCount);
+    QFETCH(QString, text);
+
+    auto expected = generateText(size);
+    auto content = createChunkedContent(expected);
+    const auto snapshot = content;
+
+    QVERIFY(content.replace(position, removedCount, text));
+    expected.replace(position, removedCount, text);
+    QCOMPARE(content.size(), expected.size());
+    QCOMPARE(content.toString(), expected);
+
+    // Copies are not affected.
+    QCOMPARE(snapshot.toString(), generateText(size));
+}
+
+void TestBufferContent::testInsertIntoEmpty()
+{
+    BufferContent content;
+    QVERIFY(content.isEmpty());
+
+    QVERIFY(content.replace(0, 0, "vnotex"));
+    QCOMPARE(content.size(), 6);
+    QCOMPARE(content.toString(), QString("vnotex"));
+
+    BufferContent emptyContent((QString()));
+    const auto text = generateText(c_chunkSize + 1);
+    QVERIFY(emptyContent.replace(0, 0, text));
+    QCOMPARE(emptyContent.toString(), text);
+}
+
+void TestBufferContent::testOutOfBound()
+{
+    auto content = createChunkedContent(generateText(100));
+    QVERIFY(!content.replace(-1, 0, "v"));
+    QVERIFY(!content.replace(101, 0, "v"));
+    QVERIFY(!content.replace(90, 11, "v"));
+    QVERIFY(!content.replace(0, -1, "v"));
+    QCOMPARE(content.toString(), generateText(100));
+}
+
+void TestBufferContent::testRandomEdits()
+{
+    QRandomGenerator rand(2021);
+
+    auto expected = generateText(4 * c_chunkSize);
+    BufferContent content(expected);
+    for (int i = 0; i < 2000; ++i) {
+        // Mostly small edits with some large ones to split and merge chunks.
+        const int maxCount = rand.bounded(10) == 0 ? 2 * c_chunkSize : 16;
+        const int position = rand.bounded(expected.size() + 1);
+        const int removedCount = rand.bounded(qMin(expected.size() - position, maxCount) + 1);
+        const auto text = generateText(rand.bounded(maxCount + 1));
+
+        QVERIFY(content.replace(position, removedCount, text));
+        expected.replace(position, removedCount, text);
+        QCOMPARE(content.size(), expected.size());
+        if (i % 100 == 0) {
+            QCOMPARE(content.toString(), expected);
+        }
+    }
+
+    QCOMPARE(content.toString(), expected);
+}
+
+QTEST_MAIN(tests::TestBufferContent)
@@ -0,0 +1,27 @@
+#ifndef TEST_BUFFERCONTENT_H
+#define TEST_BUFFERCONTENT_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestBufferContent : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestBufferContent(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testReplace_data();
+        void testReplace();
+
+        void testInsertIntoEmpty();
+
+        void testOutOfBound();
+
+        void testRandomEdits();
+    };
+} // ns tests
+
+#endif // TEST_BUFFERCONTENT_H
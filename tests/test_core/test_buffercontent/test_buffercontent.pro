@@ -0,0 +1,18 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_buffercontent
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+BUFFER_FOLDER = $$SRC_FOLDER/core/buffer
+
+INCLUDEPATH *= $$SRC_FOLDER
+INCLUDEPATH *= $$SRC_FOLDER/core
+
+SOURCES += \
+    test_buffercontent.cpp \
+    $$BUFFER_FOLDER/buffercontent.cpp
+
+HEADERS += \
+    test_buffercontent.h \
+    $$BUFFER_FOLDER/buffercontent.h
@@ -2,4 +2,6 @@ TEMPLATE = subdirs
 
 SUBDIRS = \
     test_notebook \
-    test_theme
+    test_theme \
+    test_buffercontent \
+    test_sectionnumber
@@ -3,6 +3,7 @@
 #include <QDebug>
 #include <QTemporaryDir>
 #include <QFileInfo>
+#include <QRandomGenerator>
 
 #include <versioncontroller/dummyversioncontrollerfactory.h>
 #include <versioncontroller/iversioncontroller.h>
@@ -14,7 +15,10 @@
 #include <notebook/bundlenotebookfactory.h>
 #include <notebook/notebook.h>
 #include <notebook/notebookparameters.h>
+#include <notebook/vxnode.h>
 #include <utils/pathutils.h>
+#include <search/searchindex.h>
+#include <widgets/notebooknodemodel.h>
 
 using namespace tests;
 
@@ -111,6 +115,174 @@ void TestNotebook::testBundleNotebookFactoryNewNotebook()
     QVERIFY(QFileInfo::exists(notebookConfigPath));
 }
 
+void TestNotebook::prepareSyntheticNotebook()
+{
+    if (m_syntheticNotebook) {
+        return;
+    }
+
+    auto nbFactory = m_nbServer->getItem("bundle.vnotex");
+
+    NotebookParameters para;
+    para.m_name = "synthetic_notebook";
+    para.m_rootFolderPath = PathUtils::concatenateFilePath(getTestFolderPath(), "synthetic");
+    para.m_notebookBackend = m_backendServer->getItem("local.vnotex")
+                                            ->createNotebookBackend(para.m_rootFolderPath);
+    para.m_versionController = m_vcServer->getItem("dummy.vnotex")->createVersionController();
+    para.m_notebookConfigMgr = m_ncmServer->getItem("vx.vnotex")->createNotebookConfigMgr(para.m_notebookBackend);
+    m_syntheticNotebook = nbFactory->newNotebook(para);
+
+    // 100 folders * 10 sub-folders * 100 files, without touching the disk.
+    auto nb = m_syntheticNotebook.data();
+    auto root = nb->getRootNode();
+    const auto now = QDateTime::currentDateTimeUtc();
+    ID id = 1000;
+    for (int i = 0; i < 100; ++i) {
+        auto folder = QSharedPointer<VXNode>::create(QString("folder_%1").arg(i), nb, root.data());
+        QVector<QSharedPointer<Node>> subFolders;
+        for (int j = 0; j < 10; ++j) {
+            auto subFolder = QSharedPointer<VXNode>::create(QString("sub_%1").arg(j), nb, folder.data());
+            QVector<QSharedPointer<Node>> files;
+            for (int k = 0; k < 100; ++k) {
+                auto file = QSharedPointer<VXNode>::create(++id,
+                                                           QString("note_%1.md").arg(k),
+                                                           now,
+                                                           now,
+                                                           QStringList(),
+                                                           QString(),
+                                                           nb,
+                                                           subFolder.data());
+                files.push_back(file);
+                m_syntheticFiles.push_back(file.data());
+            }
+            subFolder->loadCompleteInfo(++id, now, now, QStringList(), files);
+            subFolders.push_back(subFolder);
+        }
+        folder->loadCompleteInfo(++id, now, now, QStringList(), subFolders);
+        root->addChild(folder);
+    }
+
+    QCOMPARE(m_syntheticFiles.size(), 100000);
+}
+
+void TestNotebook::benchmarkNodeModelExpand()
+{
+    prepareSyntheticNotebook();
+    auto root = m_syntheticNotebook->getRootNode();
+
+    // Expand all the folders.
+    NotebookNodeModel model;
+    QBENCHMARK {
+        model.setRootNode(root);
+        model.fetchMore(QModelIndex());
+        const int cnt = model.rowCount();
+        for (int i = 0; i < cnt; ++i) {
+            const auto idx = model.index(i, 0);
+            model.fetchMore(idx);
+            const int subCnt = model.rowCount(idx);
+            for (int j = 0; j < subCnt; ++j) {
+                model.fetchMore(model.index(j, 0, idx));
+            }
+        }
+    }
+
+    QVERIFY(model.rowCount() >= 100);
+}
+
+void TestNotebook::benchmarkNodeModelLocate()
+{
+    prepareSyntheticNotebook();
+    auto root = m_syntheticNotebook->getRootNode();
+
+    // Locate 1k files scattered over the notebook from a collapsed tree.
+    NotebookNodeModel model;
+    QBENCHMARK {
+        model.setRootNode(root);
+        for (int i = 0; i < m_syntheticFiles.size(); i += 100) {
+            auto node = m_syntheticFiles[i];
+            const auto idx = model.locateNode(node);
+            QCOMPARE(model.nodeFromIndex(idx), node);
+            QCOMPARE(model.indexFromNode(node), idx);
+        }
+    }
+}
+
+QString TestNotebook::generateSyntheticNote(QRandomGenerator &p_rand)
+{
+    static const QString cjkChars = QStringLiteral("中文搜索索引笔记测试性能数据结构文档标题内容");
+
+    QString text;
+    for (int i = 0; i < 150; ++i) {
+        // Skew to frequent words.
+        const double r = p_rand.generateDouble();
+        text += QString("w%1 ").arg(static_cast<int>(r * r * r * 20000));
+    }
+    for (int i = 0; i < 30; ++i) {
+        text += cjkChars[p_rand.bounded(cjkChars.size())];
+    }
+    return text;
+}
+
+QString TestNotebook::prepareSearchIndexFile()
+{
+    const auto filePath = PathUtils::concatenateFilePath(getTestFolderPath(), "search_index.bin");
+    if (QFileInfo::exists(filePath)) {
+        return filePath;
+    }
+
+    QRandomGenerator rand(2021);
+    SearchIndex index(filePath);
+    for (int i = 0; i < 50000; ++i) {
+        index.updateDocument(QString("folder_%1/note_%2.md").arg(i / 100).arg(i), 0,
+                             SearchIndex::analyze(generateSyntheticNote(rand)));
+    }
+    index.save();
+    return filePath;
+}
+
+void TestNotebook::benchmarkSearchIndexBuild()
+{
+    QRandomGenerator rand(2021);
+    QVector<QString> notes;
+    notes.reserve(50000);
+    for (int i = 0; i < 50000; ++i) {
+        notes.push_back(generateSyntheticNote(rand));
+    }
+
+    const auto filePath = PathUtils::concatenateFilePath(getTestFolderPath(), "search_index_build.bin");
+    QBENCHMARK_ONCE {
+        SearchIndex index(filePath);
+        for (int i = 0; i < notes.size(); ++i) {
+            index.updateDocument(QString("note_%1.md").arg(i), 0, SearchIndex::analyze(notes[i]));
+        }
+        index.save();
+        QCOMPARE(index.getDocumentCount(), notes.size());
+    }
+}
+
+void TestNotebook::benchmarkSearchIndexQuery()
+{
+    SearchIndex index(prepareSearchIndexFile());
+    QVERIFY(index.load());
+    QCOMPARE(index.getDocumentCount(), 50000);
+
+    // Frequent words, rare words and CJK bigrams.
+    const QStringList queries = {"w1 w2", "w19000", "搜索", "笔记 w5", "性能数据"};
+    QBENCHMARK {
+        for (const auto &query : queries) {
+            const auto results = index.search(query, 20);
+            QVERIFY(!results.isEmpty());
+        }
+    }
+
+    // Changes in memory are visible before saving.
+    index.removeDocuments("folder_0");
+    index.updateDocument("new.md", 0, SearchIndex::analyze("unique 全文检索"));
+    QCOMPARE(index.getDocumentCount(), 50000 - 100 + 1);
+    QCOMPARE(index.search("检索", 20).size(), 1);
+    QCOMPARE(index.search("UNIQUE", 20).value(0).m_path, QString("new.md"));
+}
+
 QString TestNotebook::getTestFolderPath() const
 {
     return m_testDir->path();
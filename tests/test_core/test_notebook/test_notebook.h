@@ -7,6 +7,7 @@
 #include <namebasedserver.h>
 
 class QTemporaryDir;
+class QRandomGenerator;
 
 namespace vnotex
 {
@@ -14,6 +15,8 @@ namespace vnotex
     class INotebookConfigMgrFactory;
     class INotebookBackendFactory;
     class INotebookFactory;
+    class Notebook;
+    class Node;
 }
 
 namespace tests
@@ -36,15 +39,36 @@ namespace tests
 
         void testBundleNotebookFactoryNewNotebook();
 
+        void benchmarkNodeModelExpand();
+
+        void benchmarkNodeModelLocate();
+
+        void benchmarkSearchIndexBuild();
+
+        void benchmarkSearchIndexQuery();
+
     private:
         QString getTestFolderPath() const;
 
+        // Build a notebook with 100k file nodes in memory.
+        void prepareSyntheticNotebook();
+
+        // Mixed English and Chinese text of one note.
+        static QString generateSyntheticNote(QRandomGenerator &p_rand);
+
+        // Build a search index file of 50k notes and return its path.
+        QString prepareSearchIndexFile();
+
         QSharedPointer<QTemporaryDir> m_testDir;
 
         QSharedPointer<vnotex::NameBasedServer<vnotex::IVersionControllerFactory>> m_vcServer;
         QSharedPointer<vnotex::NameBasedServer<vnotex::INotebookConfigMgrFactory>> m_ncmServer;
         QSharedPointer<vnotex::NameBasedServer<vnotex::INotebookBackendFactory>> m_backendServer;
         QSharedPointer<vnotex::NameBasedServer<vnotex::INotebookFactory>> m_nbServer;
+
+        QSharedPointer<vnotex::Notebook> m_syntheticNotebook;
+
+        QVector<vnotex::Node *> m_syntheticFiles;
     };
 } // ns tests
 
@@ -0,0 +1,141 @@
+#include "test_sectionnumber.h"
+
+#include <QTextDocument>
+#include <QTextBlock>
+
+#include <widgets/editors/sectionnumberupdater.h>
+#include <utils/textutils.h>
+
+using namespace tests;
+
+using namespace vnotex;
+
+static SectionNumberUpdater::Heading createHeading(int p_level, const QString &p_sectionNumber, int p_blockNumber)
+{
+    SectionNumberUpdater::Heading heading;
+    heading.m_level = p_level;
+    heading.m_sectionNumber = p_sectionNumber;
+    heading.m_blockNumber = p_blockNumber;
+    return heading;
+}
+
+static QStringList blockTexts(const QTextDocument &p_doc)
+{
+    QStringList texts;
+    for (auto block = p_doc.begin(); block != p_doc.end(); block = block.next()) {
+        texts << block.text();
+    }
+    return texts;
+}
+
+TestSectionNumber::TestSectionNumber(QObject *p_parent)
+    : QObject(p_parent)
+{
+}
+
+void TestSectionNumber::testUpdate()
+{
+    QTextDocument doc("# a\n## b\n## c\n# d");
+    QVector<SectionNumberUpdater::Heading> headings;
+    headings << createHeading(1, "", 0)
+             << createHeading(2, "", 1)
+             << createHeading(2, "", 2)
+             << createHeading(1, "", 3);
+
+    SectionNumberUpdater updater;
+    QVERIFY(updater.update(&doc, headings, true, 1, false));
+    QCOMPARE(blockTexts(doc), QStringList({"# 1 a", "## 1.1 b", "## 1.2 c", "# 2 d"}));
+
+    // Nothing changed since last update.
+    headings[0].m_sectionNumber = "1";
+    headings[1].m_sectionNumber = "1.1";
+    headings[2].m_sectionNumber = "1.2";
+    headings[3].m_sectionNumber = "2";
+    QVERIFY(!updater.update(&doc, headings, true, 1, false));
+
+    // Remove the second heading.
+    doc.setPlainText("# 1 a\n## 1.2 c\n# 2 d");
+    headings.remove(1);
+    headings[1].m_blockNumber = 1;
+    headings[2].m_blockNumber = 2;
+    QVERIFY(updater.update(&doc, headings, true, 1, false));
+    QCOMPARE(blockTexts(doc), QStringList({"# 1 a", "## 1.1 c", "# 2 d"}));
+
+    // Remove all the section numbers.
+    headings[1].m_sectionNumber = "1.1";
+    QVERIFY(updater.update(&doc, headings, false, 1, false));
+    QCOMPARE(blockTexts(doc), QStringList({"# a", "## c", "# d"}));
+}
+
+void TestSectionNumber::testRetryFailedHeading()
+{
+    QTextDocument doc("# a\n## b\n## c\n# d");
+    QVector<SectionNumberUpdater::Heading> headings;
+    headings << createHeading(1, "", 0)
+             << createHeading(2, "", 1)
+             << createHeading(2, "", 100)
+             << createHeading(1, "", 3);
+
+    SectionNumberUpdater updater;
+    QVERIFY(updater.update(&doc, headings, true, 1, false));
+    QCOMPARE(blockTexts(doc), QStringList({"# 1 a", "## 1.1 b", "## c", "# 2 d"}));
+
+    // The heading failed to update should be retried even if it is not changed.
+    headings[0].m_sectionNumber = "1";
+    headings[1].m_sectionNumber = "1.1";
+    headings[2].m_blockNumber = 2;
+    headings[3].m_sectionNumber = "2";
+    QVERIFY(updater.update(&doc, headings, true, 1, false));
+    QCOMPARE(blockTexts(doc), QStringList({"# 1 a", "## 1.1 b", "## 1.2 c", "# 2 d"}));
+}
+
+void TestSectionNumber::benchmarkUpdate_data()
+{
+    QTest::addColumn<int>("changedIndex");
+
+    // A heading changed at the end of a long spec only needs numbers after it.
+    QTest::newRow("first") << 0;
+    QTest::newRow("last_10") << 1990;
+}
+
+void TestSectionNumber::benchmarkUpdate()
+{
+    QFETCH(int, changedIndex);
+
+    // 2000 headings of 20 chapters, each with 10 sections of 9 subsections.
+    QVector<int> levels;
+    for (int chapter = 0; chapter < 20; ++chapter) {
+        for (int section = 0; section < 10; ++section) {
+            levels << (section == 0 ? 1 : 2);
+            for (int sub = 0; sub < 9; ++sub) {
+                levels << 3;
+            }
+        }
+    }
+    QCOMPARE(levels.size(), 2000);
+
+    QStringList lines;
+    QVector<SectionNumberUpdater::Heading> headings;
+    for (int i = 0; i < levels.size(); ++i) {
+        lines << QString(levels[i], QLatin1Char('#')) + QStringLiteral(" heading");
+        lines << QStringLiteral("Content of the heading.");
+        headings << createHeading(levels[i], QString(), i * 2);
+    }
+    QTextDocument doc(lines.join(QLatin1Char('\n')));
+
+    SectionNumberUpdater updater;
+    QVERIFY(updater.update(&doc, headings, true, 1, false));
+
+    const auto numbers = TextUtils::generateSectionNumbers(levels, 1, false);
+    for (int i = 0; i < headings.size(); ++i) {
+        headings[i].m_sectionNumber = numbers[i];
+    }
+
+    // Each run sees the section number of the changed heading removed and writes it back.
+    headings[changedIndex].m_sectionNumber.clear();
+    QBENCHMARK {
+        QVERIFY(updater.update(&doc, headings, true, 1, false));
+    }
+}
+
+QTEST_MAIN(tests::TestSectionNumber)
@@ -0,0 +1,25 @@
+#ifndef TEST_SECTIONNUMBER_H
+#define TEST_SECTIONNUMBER_H
+
+#include <QtTest>
+
+namespace tests
+{
+    class TestSectionNumber : public QObject
+    {
+        Q_OBJECT
+    public:
+        explicit TestSectionNumber(QObject *p_parent = nullptr);
+
+    private slots:
+        // Define test cases here per slot.
+        void testUpdate();
+
+        void testRetryFailedHeading();
+
+        void benchmarkUpdate_data();
+        void benchmarkUpdate();
+    };
+} // ns tests
+
+#endif // TEST_SECTIONNUMBER_H
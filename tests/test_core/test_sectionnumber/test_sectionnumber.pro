@@ -0,0 +1,26 @@
+include($$PWD/../../common.pri)
+
+TARGET = test_sectionnumber
+TEMPLATE = app
+
+SRC_FOLDER = $$PWD/../../../src
+EDITORS_FOLDER = $$SRC_FOLDER/widgets/editors
+UTILS_FOLDER = $$SRC_FOLDER/utils
+
+INCLUDEPATH *= $$SRC_FOLDER
+
+LIBS_FOLDER = $$PWD/../../../libs
+
+include($$LIBS_FOLDER/vtextedit/src/editor/editor_export.pri)
+
+include($$LIBS_FOLDER/vtextedit/src/libs/syntax-highlighting/syntax-highlighting_export.pri)
+
+include($$UTILS_FOLDER/utils.pri)
+
+SOURCES += \
+    test_sectionnumber.cpp \
+    $$EDITORS_FOLDER/sectionnumberupdater.cpp
+
+HEADERS += \
+    test_sectionnumber.h \
+    $$EDITORS_FOLDER/sectionnumberupdater.h
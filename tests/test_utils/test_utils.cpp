@@ -5,6 +5,7 @@
 
 #include <utils/pathutils.h>
 #include <utils/fileutils.h>
+#include <utils/textutils.h>
 
 using namespace tests;
 
@@ -227,4 +228,159 @@ void TestUtils::testIsText()
     }
 }
 
+void TestUtils::testWriteFileAtomically()
+{
+    QTemporaryDir dir;
+    const QString testFolderPath(dir.path());
+    const auto filePath = testFolderPath + "/atomic.md";
+
+    FileUtils::writeFileAtomically(filePath, QByteArray("vnotex"));
+    QCOMPARE(FileUtils::readFile(filePath), QByteArray("vnotex"));
+
+    // Overwrite with shorter content.
+    FileUtils::writeFileAtomically(filePath, QString("vx"), true);
+    QCOMPARE(FileUtils::readTextFile(filePath), QString("vx"));
+
+    // No temporary file is left.
+    QCOMPARE(QDir(testFolderPath).entryList(QDir::Files | QDir::Hidden).size(), 1);
+}
+
+void TestUtils::testReadTextFile_data()
+{
+    QTest::addColumn<int>("lineCount");
+    QTest::addColumn<QByteArray>("lineEnding");
+    QTest::addColumn<QString>("expectedLineEnding");
+
+    QTest::newRow("small") << 10 << QByteArray("\n") << "\n";
+    QTest::newRow("small_crlf") << 10 << QByteArray("\r\n") << "\n";
+    QTest::newRow("small_cr") << 10 << QByteArray("\r") << "";
+    // Large enough to be read from memory map.
+    QTest::newRow("large") << 1024 * 1024 << QByteArray("\n") << "\n";
+    QTest::newRow("large_crlf") << 1024 * 1024 << QByteArray("\r\n") << "\n";
+    QTest::newRow("large_cr") << 1024 * 1024 << QByteArray("\r") << "";
+}
+
+void TestUtils::testReadTextFile()
+{
+    QFETCH(int, lineCount);
+    QFETCH(QByteArray, lineEnding);
+    QFETCH(QString, expectedLineEnding);
+
+    QTemporaryDir dir;
+    const auto filePath = dir.path() + "/note.md";
+
+    const QByteArray line("vnotex \xe7\xac\x94\xe8\xae\xb0");
+    QByteArray data;
+    QString expected;
+    for (int i = 0; i < lineCount; ++i) {
+        data += line + lineEnding;
+        expected += QString::fromUtf8(line) + expectedLineEnding;
+    }
+    FileUtils::writeFile(filePath, data);
+
+    QCOMPARE(FileUtils::readTextFile(filePath), expected);
+}
+
+void TestUtils::benchmarkWriteFile_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("atomic");
+
+    QTest::newRow("1KB") << 1024 << false;
+    QTest::newRow("1KB_atomic") << 1024 << true;
+    QTest::newRow("1MB") << 1024 * 1024 << false;
+    QTest::newRow("1MB_atomic") << 1024 * 1024 << true;
+    QTest::newRow("50MB") << 50 * 1024 * 1024 << false;
+    QTest::newRow("50MB_atomic") << 50 * 1024 * 1024 << true;
+}
+
+void TestUtils::benchmarkWriteFile()
+{
+    QFETCH(int, size);
+    QFETCH(bool, atomic);
+
+    QTemporaryDir dir;
+    const auto filePath = dir.path() + "/note.md";
+    const QByteArray data(size, 'v');
+
+    QBENCHMARK {
+        if (atomic) {
+            FileUtils::writeFileAtomically(filePath, data);
+        } else {
+            FileUtils::writeFile(filePath, data);
+        }
+    }
+}
+
+void TestUtils::testDiffLines_data()
+{
+    QTest::addColumn<QString>("oldText");
+    QTest::addColumn<QString>("newText");
+    QTest::addColumn<bool>("changed");
+    QTest::addColumn<int>("firstLine");
+    QTest::addColumn<int>("removedLineCount");
+    QTest::addColumn<QStringList>("insertedLines");
+
+    QTest::newRow("same") << "a\nb" << "a\nb" << false << 0 << 0 << QStringList();
+    QTest::newRow("modify") << "a\nb\nc" << "a\nbb\nc" << true << 1 << 1 << QStringList{"bb"};
+    QTest::newRow("insert") << "a\nc" << "a\nb\nc" << true << 1 << 0 << QStringList{"b"};
+    QTest::newRow("remove") << "a\nb\nc" << "a\nc" << true << 1 << 1 << QStringList();
+    QTest::newRow("append") << "a" << "a\n" << true << 1 << 0 << QStringList{""};
+    QTest::newRow("repeated") << "a\na\na" << "a\na" << true << 2 << 1 << QStringList();
+    QTest::newRow("empty") << "" << "a\nb" << true << 0 << 1 << QStringList{"a", "b"};
+}
+
+void TestUtils::testDiffLines()
+{
+    QFETCH(QString, oldText);
+    QFETCH(QString, newText);
+    QFETCH(bool, changed);
+    QFETCH(int, firstLine);
+    QFETCH(int, removedLineCount);
+    QFETCH(QStringList, insertedLines);
+
+    int first = 0;
+    int removed = 0;
+    QStringList inserted;
+    QCOMPARE(TextUtils::diffLines(oldText, newText, first, removed, inserted), changed);
+    if (changed) {
+        QCOMPARE(first, firstLine);
+        QCOMPARE(removed, removedLineCount);
+        QCOMPARE(inserted, insertedLines);
+    }
+}
+
+void TestUtils::testGenerateSectionNumbers_data()
+{
+    QTest::addColumn<QVector<int>>("levels");
+    QTest::addColumn<int>("baseLevel");
+    QTest::addColumn<bool>("endingDot");
+    QTest::addColumn<int>("first");
+    QTest::addColumn<QStringList>("numbers");
+
+    QTest::newRow("empty") << QVector<int>() << 1 << false << 0 << QStringList();
+    QTest::newRow("flat") << QVector<int>{1, 1, 1} << 1 << false << 0 << QStringList{"1", "2", "3"};
+    QTest::newRow("nested") << QVector<int>{1, 2, 2, 1, 2} << 1 << false << 0
+                            << QStringList{"1", "1.1", "1.2", "2", "2.1"};
+    QTest::newRow("ending_dot") << QVector<int>{1, 2} << 1 << true << 0 << QStringList{"1.", "1.1."};
+    QTest::newRow("base_level") << QVector<int>{1, 2, 3, 2} << 2 << false << 0
+                                << QStringList{"", "1", "1.1", "2"};
+    QTest::newRow("reset_above_base") << QVector<int>{2, 1, 2} << 2 << false << 0
+                                      << QStringList{"1", "", "1"};
+    QTest::newRow("from_middle") << QVector<int>{1, 2, 2, 1, 2} << 1 << false << 2
+                                 << QStringList{"1.2", "2", "2.1"};
+    QTest::newRow("from_end") << QVector<int>{1, 2} << 1 << false << 2 << QStringList();
+}
+
+void TestUtils::testGenerateSectionNumbers()
+{
+    QFETCH(QVector<int>, levels);
+    QFETCH(int, baseLevel);
+    QFETCH(bool, endingDot);
+    QFETCH(int, first);
+    QFETCH(QStringList, numbers);
+
+    QCOMPARE(TextUtils::generateSectionNumbers(levels, baseLevel, endingDot, first), numbers);
+}
+
 QTEST_MAIN(tests::TestUtils)
@@ -32,6 +32,21 @@ namespace tests
         void testRenameFile();
 
         void testIsText();
+
+        void testWriteFileAtomically();
+
+        void testReadTextFile_data();
+        void testReadTextFile();
+
+        void benchmarkWriteFile_data();
+        void benchmarkWriteFile();
+
+        // TextUtils Tests.
+        void testDiffLines_data();
+        void testDiffLines();
+
+        void testGenerateSectionNumbers_data();
+        void testGenerateSectionNumbers();
     };
 } // ns tests
 
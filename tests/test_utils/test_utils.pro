@@ -11,9 +11,11 @@ INCLUDEPATH *= $$SRC_FOLDER
 SOURCES += \
     test_utils.cpp \
     $$UTILS_FOLDER/pathutils.cpp \
-    $$UTILS_FOLDER/fileutils.cpp
+    $$UTILS_FOLDER/fileutils.cpp \
+    $$UTILS_FOLDER/textutils.cpp
 
 HEADERS += \
     test_utils.h \
     $$UTILS_FOLDER/pathutils.h \
-    $$UTILS_FOLDER/fileutils.h
+    $$UTILS_FOLDER/fileutils.h \
+    $$UTILS_FOLDER/textutils.h